@@ -40,10 +40,20 @@ struct BtreeVisualizeVariables {
     uint64_t index;
 };
 
+// Private copy of a node with variable size layout, which optimistic reads search on, so that a concurrent writer can
+// never expose a half modified node to the search code.
+struct BtreeNodeSnapshot {
+    std::unique_ptr< uint8_t[] > buf;
+    BtreeNodePtr node{nullptr};
+    btree_node_type node_type{btree_node_type::FIXED};
+    uint32_t node_size{0};
+};
+
 struct BtreeThreadVariables {
     std::vector< btree_locked_node_info > wr_locked_nodes;
     std::vector< btree_locked_node_info > rd_locked_nodes;
     BtreeNodePtr force_split_node{nullptr};
+    std::array< BtreeNodeSnapshot, 2 > node_snapshots; // One for interior node and one for leaf node
 };
 
 struct BTREE_FLIPS {
@@ -76,13 +86,18 @@ class Btree {
 protected:
     mutable iomgr::FiberManagerLib::shared_mutex m_btree_lock;
     BtreeLinkInfo m_root_node_info;
+    std::atomic< uint64_t > m_root_version{0}; // Bumped everytime m_root_node_info changes, for optimistic readers
+    std::atomic< bnodeid_t > m_root_node_id{empty_bnodeid}; // Copy of root id in m_root_node_info for them
+    mutable btree_read_epoch m_read_epoch;
 
-    BtreeMetrics m_metrics;
+    mutable BtreeMetrics m_metrics; // mutable, since reading its result in json is not const
     std::atomic< bool > m_destroyed{false};
     std::atomic< uint64_t > m_total_leaf_nodes{0};
     std::atomic< uint64_t > m_total_interior_nodes{0};
     std::atomic< uint8_t > m_btree_depth{0};
     uint32_t m_node_size{4096};
+    btree_level_fill_sampler m_fill_sampler;
+    mutable btree_contention_tracker m_contention;
 #ifndef NDEBUG
     std::atomic< uint64_t > m_req_id{0};
 #endif
@@ -104,7 +119,9 @@ protected:
 
 public:
     /////////////////////////////////////// All External APIs /////////////////////////////
-    Btree(const BtreeConfig& cfg);
+    // supports_optimistic_read: whether the store implements peek_node_impl, without which cfg.m_optimistic_read is
+    // rejected
+    Btree(const BtreeConfig& cfg, bool supports_optimistic_read = false);
     virtual ~Btree();
 
     template < typename ReqT >
@@ -120,7 +137,7 @@ public:
 
     // bool verify_tree(bool update_debug_bm) const;
     virtual std::pair< btree_status_t, uint64_t > destroy_btree(void* context);
-    nlohmann::json get_status(int log_level) const;
+    virtual nlohmann::json get_status(int log_level) const;
 
     void dump_tree_to_file(const std::string& file = "") const;
     std::string to_custom_string(to_string_cb_t< K, V > const& cb) const;
@@ -132,6 +149,10 @@ public:
     uint16_t get_btree_depth() const;
 
     nlohmann::json get_metrics_in_json(bool updated = true);
+
+    // Fill factor of all the nodes of the tree. It reads every node under the tree lock, so it is meant for on demand
+    // diagnostics only; get_metrics_in_json reports the sampled per level fill instead.
+    nlohmann::json get_fill_stats_json() const;
     bnodeid_t root_node_id() const;
 
     uint64_t root_link_version() const;
@@ -154,6 +175,11 @@ protected:
     virtual BtreeNodePtr alloc_node(bool is_leaf) = 0;
     virtual BtreeNode* init_node(uint8_t* node_buf, bnodeid_t id, bool init_buf, bool is_leaf) const;
     virtual btree_status_t read_node_impl(bnodeid_t id, BtreeNodePtr& node) const = 0;
+
+    // Node of the id for an optimistic read, without taking a reference on it. Only stores which keep nodes freed
+    // during a lookup alive till m_read_epoch says its readers are gone can support it, and they pass
+    // supports_optimistic_read to the constructor.
+    virtual BtreeNode* peek_node_impl(bnodeid_t) const { return nullptr; }
     virtual btree_status_t write_node_impl(const BtreeNodePtr& node, void* context) = 0;
     virtual btree_status_t refresh_node(const BtreeNodePtr& node, bool for_read_modify_write, void* context) const = 0;
     virtual void free_node_impl(const BtreeNodePtr& node, void* context) = 0;
@@ -189,6 +215,7 @@ protected:
 
     std::pair< btree_status_t, uint64_t > do_destroy();
     void observe_lock_time(const BtreeNodePtr& node, locktype_t type, uint64_t time_spent) const;
+    void observe_lock_wait(const BtreeNodePtr& node, uint64_t wait_ns) const;
 
     static void _start_of_lock(const BtreeNodePtr& node, locktype_t ltype, const char* fname, int line);
     static bool remove_locked_node(const BtreeNodePtr& node, locktype_t ltype, btree_locked_node_info* out_info);
@@ -205,6 +232,7 @@ protected:
     void get_all_kvs(std::vector< std::pair< K, V > >& kvs) const;
     btree_status_t do_destroy(uint64_t& n_freed_nodes, void* context);
     void get_child_node_count(bnodeid_t bnodeid, uint64_t& interior_cnt, uint64_t& leaf_cnt) const;
+    void get_fill_stats(bnodeid_t bnodeid, btree_fill_stats& stats) const;
     void to_string(bnodeid_t bnodeid, std::string& buf) const;
     void to_custom_string_internal(bnodeid_t bnodeid, std::string& buf, to_string_cb_t< K, V > const& cb,
                                    int nindent = -1) const;
@@ -218,6 +246,9 @@ protected:
     void validate_sanity_next_child(const BtreeNodePtr& parent_node, uint32_t ind) const;
     void print_node(const bnodeid_t& bnodeid) const;
 
+    void set_root_link(BtreeLinkInfo const& info);
+    BtreeNode* optimistic_read_view(BtreeNode* node) const;
+
     void append_route_trace(BtreeRequest& req, const BtreeNodePtr& node, btree_event_t event, uint32_t start_idx = 0,
                             uint32_t end_idx = 0) const;
 
@@ -267,5 +298,8 @@ protected:
     ///////// Get Impl Methods
     template < typename ReqT >
     btree_status_t do_get(const BtreeNodePtr& my_node, ReqT& greq) const;
+
+    template < typename ReqT >
+    btree_status_t do_optimistic_get(ReqT& greq) const;
 };
 } // namespace homestore
@@ -36,8 +36,10 @@
 
 namespace homestore {
 template < typename K, typename V >
-Btree< K, V >::Btree(const BtreeConfig& cfg) :
+Btree< K, V >::Btree(const BtreeConfig& cfg, bool supports_optimistic_read) :
         m_metrics{cfg.name().c_str()}, m_node_size{cfg.node_size()}, m_bt_cfg{cfg} {
+    RELEASE_ASSERT(!cfg.m_optimistic_read || supports_optimistic_read,
+                   "Btree={} store doesn't support optimistic reads, but they are enabled in its config", cfg.name());
     m_bt_cfg.set_node_data_size(cfg.node_size() - sizeof(persistent_hdr_t));
 }
 
@@ -46,7 +48,7 @@ Btree< K, V >::~Btree() = default;
 
 template < typename K, typename V >
 void Btree< K, V >::set_root_node_info(const BtreeLinkInfo& info) {
-    m_root_node_info = info;
+    set_root_link(info);
 }
 
 template < typename K, typename V >
@@ -157,6 +159,22 @@ btree_status_t Btree< K, V >::get(ReqT& greq) const {
     COUNTER_INCREMENT(m_metrics, btree_query_ops_count, 1);
     btree_status_t ret = btree_status_t::success;
 
+    if (m_bt_cfg.m_optimistic_read) {
+        for (uint8_t attempt{0}; attempt < m_bt_cfg.m_max_optimistic_read_attempts; ++attempt) {
+            {
+                btree_read_epoch::reader_guard rg{m_read_epoch};
+                ret = do_optimistic_get(greq);
+            }
+            if (ret != btree_status_t::retry) {
+                COUNTER_INCREMENT(m_metrics, btree_optimistic_read_hits, 1);
+                return ret;
+            }
+            COUNTER_INCREMENT(m_metrics, btree_optimistic_read_retries, 1);
+        }
+        // Too much contention on the path, take the locks so that we are guaranteed to make progress
+        COUNTER_INCREMENT(m_metrics, btree_optimistic_read_fallbacks, 1);
+    }
+
     m_btree_lock.lock_shared();
     BtreeNodePtr root;
 
@@ -306,13 +324,48 @@ bool Btree< K, V >::verify_tree(bool update_debug_bm) const {
 /**
  * @brief : get the status of this btree;
  *
- * @param log_level : verbosity level;
+ * @param log_level : verbosity level, 1 and above lists the top contended nodes;
  *
  * @return : status in json form;
  */
 template < typename K, typename V >
 nlohmann::json Btree< K, V >::get_status(int log_level) const {
     nlohmann::json j;
+    j["name"] = m_bt_cfg.name();
+    j["depth"] = m_btree_depth.load();
+    j["leaf_nodes"] = m_total_leaf_nodes.load();
+    j["interior_nodes"] = m_total_interior_nodes.load();
+    j["sampled_fill_by_level"] = m_fill_sampler.to_json();
+
+    // Rates are derived from the counters exported to sisl metrics, so that they add nothing to the io path
+    auto const metrics = m_metrics.get_result_in_json(true);
+    auto const counter = [&metrics](const char* description) -> uint64_t {
+        auto const it = metrics.find("Counters");
+        return (it == metrics.end()) ? 0 : it->value(description, uint64_t{0});
+    };
+    using desc = BtreeMetrics::desc;
+    auto const pct = [](uint64_t n, uint64_t total) { return (total == 0) ? 0.0 : (n * 100.0) / total; };
+
+    auto const writes = counter(desc::write_ops_count) + counter(desc::remove_ops_count);
+    auto const retries = counter(desc::retry_count);
+    j["cp_mismatch_retries"] = retries;
+    j["cp_mismatch_retry_pct"] = pct(retries, writes);
+
+    auto const hits = counter(desc::cache_hits);
+    auto const misses = counter(desc::cache_misses);
+    if ((hits + misses) != 0) {
+        j["cache_hits"] = hits;
+        j["cache_misses"] = misses;
+        j["cache_hit_pct"] = pct(hits, hits + misses);
+    }
+
+    if (m_bt_cfg.m_optimistic_read) {
+        j["optimistic_read_hits"] = counter(desc::optimistic_read_hits);
+        j["optimistic_read_retries"] = counter(desc::optimistic_read_retries);
+        j["optimistic_read_fallbacks"] = counter(desc::optimistic_read_fallbacks);
+    }
+
+    if (log_level >= 1) { j["contended_nodes"] = m_contention.to_json(); }
     return j;
 }
 
@@ -383,7 +436,18 @@ std::string Btree< K, V >::visualize_tree_keys(const std::string& file) const {
 
 template < typename K, typename V >
 nlohmann::json Btree< K, V >::get_metrics_in_json(bool updated) {
-    return m_metrics.get_result_in_json(updated);
+    auto j = m_metrics.get_result_in_json(updated);
+    j["Sampled fill by level"] = m_fill_sampler.to_json();
+    return j;
+}
+
+template < typename K, typename V >
+nlohmann::json Btree< K, V >::get_fill_stats_json() const {
+    btree_fill_stats stats;
+    m_btree_lock.lock_shared();
+    get_fill_stats(m_root_node_info.bnode_id(), stats);
+    m_btree_lock.unlock_shared();
+    return stats.to_json();
 }
 
 template < typename K, typename V >
@@ -148,6 +148,28 @@ void Btree< K, V >::get_child_node_count(bnodeid_t bnodeid, uint64_t& interior_c
     return ;
 }
 
+template < typename K, typename V >
+void Btree< K, V >::get_fill_stats(bnodeid_t bnodeid, btree_fill_stats& stats) const {
+    BtreeNodePtr node;
+    locktype_t acq_lock = locktype_t::READ;
+
+    if (read_and_lock_node(bnodeid, node, acq_lock, acq_lock, nullptr) != btree_status_t::success) { return; }
+    stats.add_node(node->is_leaf(), ((m_node_size - node->available_size()) * 100) / m_node_size,
+                   node->reclaimable_size());
+
+    if (!node->is_leaf()) {
+        uint32_t i = 0;
+        while (i < node->total_entries()) {
+            BtreeLinkInfo p;
+            node->get_nth_value(i, &p, false);
+            get_fill_stats(p.bnode_id(), stats);
+            ++i;
+        }
+        if (node->has_valid_edge()) { get_fill_stats(node->edge_id(), stats); }
+    }
+    unlock_node(node, acq_lock);
+}
+
 template < typename K, typename V >
 void Btree< K, V >::to_string(bnodeid_t bnodeid, std::string& buf) const {
     BtreeNodePtr node;
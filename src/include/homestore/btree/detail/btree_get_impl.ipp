@@ -61,4 +61,74 @@ out:
     unlock_node(my_node, locktype_t::READ);
     return ret;
 }
+
+/*
+ * Lock free version of do_get. Nodes are walked through raw pointers, without taking locks or references, so a lookup
+ * writes nothing shared with other lookups. Caller keeps a m_read_epoch reader guard over the call, which keeps the
+ * nodes alive. Whatever is read from a node is used only after validating that the node was not write locked since
+ * its version was sampled. Child is validated by rechecking the parent version after sampling the child version, so
+ * there is no point where the child was not a child of parent.
+ *
+ * Node memory (and the output key/value copied from it) can be read while a writer modifies the node in place. Such
+ * reads are data races, which are benign only because their result is discarded on a version mismatch, so they are
+ * annotated as such for tsan by btree_racy_read_scope.
+ *
+ * Returns btree_status_t::retry if any validation fails, in which case caller could retry or fallback to do_get.
+ */
+template < typename K, typename V >
+template < typename ReqT >
+btree_status_t Btree< K, V >::do_optimistic_get(ReqT& greq) const {
+    bool found{false};
+    uint32_t idx;
+    btree_racy_read_scope racy_reads;
+
+    auto const root_version = m_root_version.load(std::memory_order_acquire);
+    BtreeNode* node = peek_node_impl(m_root_node_id.load(std::memory_order_acquire));
+
+    // Root change bumps root version while the old root is still write locked, so if root version is unchanged after
+    // sampling the node version, the node was the root at that version.
+    uint64_t node_version = node->optimistic_read_begin();
+    if (m_root_version.load(std::memory_order_acquire) != root_version) { return btree_status_t::retry; }
+
+    while (true) {
+        BtreeNode* snode = optimistic_read_view(node);
+
+        // A copy has to be consistent before searching on it, while an in place search is validated after it
+        if ((snode != node) && !node->optimistic_read_validate(node_version)) { return btree_status_t::retry; }
+
+        if (snode->is_leaf()) {
+            if constexpr (std::is_same_v< BtreeGetAnyRequest< K >, ReqT >) {
+                std::tie(found, idx) = static_cast< VariantNode< K, V >* >(snode)->get_any(
+                    greq.m_range, greq.m_outkey, greq.m_outval, true, true);
+            } else if constexpr (std::is_same_v< BtreeSingleGetRequest, ReqT >) {
+                std::tie(found, idx) = snode->find(greq.key(), greq.m_outval, true);
+            }
+            if (!node->optimistic_read_validate(node_version) || snode->is_node_deleted()) {
+                return btree_status_t::retry;
+            }
+            if (!found) { return btree_status_t::not_found; }
+            if (greq.route_tracing) { append_route_trace(greq, BtreeNodePtr{snode}, btree_event_t::READ, idx, idx); }
+            return btree_status_t::success;
+        }
+
+        BtreeLinkInfo child_info;
+        if constexpr (std::is_same_v< BtreeGetAnyRequest< K >, ReqT >) {
+            std::tie(found, idx) = snode->find(greq.m_range.start_key(), &child_info, true);
+        } else if constexpr (std::is_same_v< BtreeSingleGetRequest, ReqT >) {
+            std::tie(found, idx) = snode->find(greq.key(), &child_info, true);
+        }
+        if (!node->optimistic_read_validate(node_version) || snode->is_node_deleted()) {
+            return btree_status_t::retry;
+        }
+        ASSERT_IS_VALID_INTERIOR_CHILD_INDX(found, idx, snode);
+        if (greq.route_tracing) { append_route_trace(greq, BtreeNodePtr{snode}, btree_event_t::READ, idx, idx); }
+
+        BtreeNode* child_node = peek_node_impl(child_info.bnode_id());
+        uint64_t const child_version = child_node->optimistic_read_begin();
+        if (!node->optimistic_read_validate(node_version)) { return btree_status_t::retry; }
+
+        node = child_node;
+        node_version = child_version;
+    }
+}
 } // namespace homestore
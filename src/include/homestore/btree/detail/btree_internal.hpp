@@ -15,6 +15,12 @@
  *********************************************************************************/
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
 #include <boost/preprocessor/control/if.hpp>
 #include <boost/preprocessor/facilities/empty.hpp>
 #include <boost/preprocessor/facilities/identity.hpp>
@@ -22,6 +28,20 @@
 #include <sisl/fds/utils.hpp>
 #include <sisl/metrics/metrics.hpp>
 
+#if defined(__SANITIZE_THREAD__)
+#define _BT_TSAN_ENABLED 1
+#elif defined(__has_feature)
+#if __has_feature(thread_sanitizer)
+#define _BT_TSAN_ENABLED 1
+#endif
+#endif
+
+#ifdef _BT_TSAN_ENABLED
+// Dynamic annotations exported by the tsan runtime
+extern "C" void AnnotateIgnoreReadsBegin(const char* file, int line);
+extern "C" void AnnotateIgnoreReadsEnd(const char* file, int line);
+#endif
+
 namespace homestore {
 
 #define _BT_LOG_METHOD_IMPL(req, btcfg, node)                                                                          \
@@ -256,6 +276,24 @@ struct BtreeConfig {
     bool m_merge_turned_on{true};
     uint8_t m_max_merge_level{1};
 
+    // Point lookups traverse without taking node locks and validate node versions instead, falling back to the
+    // regular lock coupling after m_max_optimistic_read_attempts failed validations. Only stores which implement
+    // Btree::peek_node_impl support it (MemBtree), others reject the config at construction.
+    bool m_optimistic_read{false};
+    uint8_t m_max_optimistic_read_attempts{3};
+
+    // A node written with at least this percent of the node size reclaimable (prefix holes, fragmented object area)
+    // is compacted before it is written, so that the node persisted by the cp and kept in cache is compact and it
+    // doesn't split while it has unusable space. 0 leaves the compaction to the node's put path alone.
+    uint8_t m_compact_reclaimable_pct{10};
+
+    // MemBtree only: memory of freed nodes retained for reuse by new nodes, beyond which node slabs which are wholly
+    // free are returned to the heap.
+    uint64_t m_mem_max_free_node_bytes{16 * 1024 * 1024};
+
+    // One in these many node writes is sampled into the per level fill histograms reported by get_status
+    uint32_t m_fill_sample_every{64};
+
 private:
     uint32_t m_suggested_min_size; // Precomputed values
     uint32_t m_ideal_fill_size;
@@ -295,8 +333,224 @@ public:
     btree_node_type interior_node_type() const { return m_int_node_type; }
 };
 
+// Snapshot of how full the nodes of a btree are, as the count of nodes in each 10% bucket of node size filled
+struct btree_fill_stats {
+    static constexpr uint32_t num_buckets{10};
+
+    std::array< uint64_t, num_buckets > leaf_nodes{};
+    std::array< uint64_t, num_buckets > interior_nodes{};
+    uint64_t reclaimable_bytes{0};
+
+    void add_node(bool is_leaf, uint32_t fill_pct, uint32_t reclaimable) {
+        auto& hist = is_leaf ? leaf_nodes : interior_nodes;
+        ++hist[std::min(fill_pct / (100 / num_buckets), num_buckets - 1)];
+        reclaimable_bytes += reclaimable;
+    }
+
+    nlohmann::json to_json() const {
+        nlohmann::json j;
+        for (uint32_t b{0}; b < num_buckets; ++b) {
+            auto const bucket = fmt::format("{}-{}%", b * (100 / num_buckets), (b + 1) * (100 / num_buckets));
+            j["leaf"][bucket] = leaf_nodes[b];
+            j["interior"][bucket] = interior_nodes[b];
+        }
+        j["reclaimable_bytes"] = reclaimable_bytes;
+        return j;
+    }
+};
+
+// Fill histograms of the nodes written, per level of the tree (leaves are level 0). Only one in sample_every node
+// writes of a thread is recorded, so that it is cheap enough to be always on, unlike btree_fill_stats which walks the
+// whole tree.
+class btree_level_fill_sampler {
+public:
+    static constexpr uint32_t num_buckets{btree_fill_stats::num_buckets};
+    static constexpr uint32_t max_levels{8}; // Levels above are accounted in the topmost one
+
+    void sample(uint32_t level, uint32_t fill_pct, uint32_t sample_every) {
+        static thread_local uint32_t t_nwrites{0};
+        if ((sample_every == 0) || (++t_nwrites % sample_every != 0)) { return; }
+        auto const bucket = std::min(fill_pct / (100 / num_buckets), num_buckets - 1);
+        m_hist[std::min(level, max_levels - 1)][bucket].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    nlohmann::json to_json() const {
+        nlohmann::json j = nlohmann::json::object();
+        for (uint32_t l{0}; l < max_levels; ++l) {
+            uint64_t nsamples{0};
+            nlohmann::json lj;
+            for (uint32_t b{0}; b < num_buckets; ++b) {
+                auto const cnt = m_hist[l][b].load(std::memory_order_relaxed);
+                lj[fmt::format("{}-{}%", b * (100 / num_buckets), (b + 1) * (100 / num_buckets))] = cnt;
+                nsamples += cnt;
+            }
+            if (nsamples != 0) { j[fmt::format("level_{}", l)] = std::move(lj); }
+        }
+        return j;
+    }
+
+private:
+    std::array< std::array< std::atomic< uint64_t >, num_buckets >, max_levels > m_hist{};
+};
+
+// Nodes whose lock had to be waited on the most. It is updated only on the slow path of a lock which was not acquired
+// right away, so the mutex here is taken only by threads which waited anyway. Tracks upto max_tracked nodes and once
+// full, a newly contended node replaces the one with the least total wait time (which could make the counts of the
+// nodes that churn in and out the table undercounted, but the consistently hot ones stay).
+class btree_contention_tracker {
+public:
+    static constexpr uint32_t max_tracked{16};
+
+    void record(bnodeid_t node_id, bool is_leaf, uint64_t wait_ns) {
+        std::unique_lock lg{m_mtx};
+        node_contention* victim{&m_nodes[0]};
+        for (auto& n : m_nodes) {
+            if (n.node_id == node_id) {
+                n.add_wait(wait_ns);
+                return;
+            }
+            if (n.total_wait_ns < victim->total_wait_ns) { victim = &n; }
+        }
+        *victim = node_contention{node_id, is_leaf};
+        victim->add_wait(wait_ns);
+    }
+
+    nlohmann::json to_json(uint32_t max_nodes = max_tracked) const {
+        std::array< node_contention, max_tracked > nodes;
+        {
+            std::unique_lock lg{m_mtx};
+            nodes = m_nodes;
+        }
+        std::sort(nodes.begin(), nodes.end(),
+                  [](auto const& a, auto const& b) { return a.total_wait_ns > b.total_wait_ns; });
+
+        nlohmann::json j = nlohmann::json::array();
+        for (auto const& n : nodes) {
+            if ((n.node_id == empty_bnodeid) || (j.size() == max_nodes)) { break; }
+            j.push_back({{"node_id", n.node_id},
+                         {"is_leaf", n.is_leaf},
+                         {"waits", n.nwaits},
+                         {"total_wait_us", n.total_wait_ns / 1000},
+                         {"max_wait_us", n.max_wait_ns / 1000}});
+        }
+        return j;
+    }
+
+private:
+    struct node_contention {
+        bnodeid_t node_id{empty_bnodeid};
+        bool is_leaf{false};
+        uint64_t nwaits{0};
+        uint64_t total_wait_ns{0};
+        uint64_t max_wait_ns{0};
+
+        void add_wait(uint64_t wait_ns) {
+            ++nwaits;
+            total_wait_ns += wait_ns;
+            max_wait_ns = std::max(max_wait_ns, wait_ns);
+        }
+    };
+
+    mutable std::mutex m_mtx;
+    std::array< node_contention, max_tracked > m_nodes;
+};
+
+// Grace periods for optimistic readers, which walk raw node pointers without taking a reference on the nodes.
+//
+// A reader is counted, for its whole lookup, in the slot of its thread under the parity of the epoch it started in, so
+// readers of different threads mostly update different cache lines. The epoch is moved ahead only when no reader of
+// the epoch before the current one is left. A node unlinked from the tree in epoch e can be reached only by readers
+// which started in epoch e or earlier, so it can be freed once the epoch is e + 2 or more.
+class btree_read_epoch {
+public:
+    static constexpr uint32_t max_slots{16};
+
+    class reader_guard {
+    public:
+        explicit reader_guard(btree_read_epoch& re) : m_readers{re.enter()} {}
+        reader_guard(const reader_guard&) = delete;
+        reader_guard& operator=(const reader_guard&) = delete;
+        ~reader_guard() { m_readers->fetch_sub(1, std::memory_order_release); }
+
+    private:
+        std::atomic< uint64_t >* m_readers;
+    };
+
+    btree_read_epoch() :
+            m_nslots{std::clamp(std::thread::hardware_concurrency(), 1u, max_slots)},
+            m_slots{std::make_unique< slot[] >(m_nslots)} {}
+
+    uint64_t current() const { return m_epoch.load(); }
+
+    // Moves the epoch ahead if no reader of the previous epoch is left and returns the current epoch. Callers are
+    // expected to serialize calls to this.
+    uint64_t try_advance() {
+        auto const e = m_epoch.load();
+        for (uint32_t i{0}; i < m_nslots; ++i) {
+            if (m_slots[i].readers[(e + 1) & 1].load() != 0) { return e; }
+        }
+        m_epoch.store(e + 1);
+        return e + 1;
+    }
+
+    static bool is_reclaimable(uint64_t retired_epoch, uint64_t cur_epoch) { return cur_epoch >= retired_epoch + 2; }
+
+private:
+    // 64 bytes is the cache line size of all the cpus we run on
+    struct alignas(64) slot {
+        std::array< std::atomic< uint64_t >, 2 > readers{};
+    };
+
+    std::atomic< uint64_t >* enter() {
+        static std::atomic< uint32_t > s_nthreads{0};
+        static thread_local uint32_t const t_thread_num = s_nthreads.fetch_add(1, std::memory_order_relaxed);
+        auto& readers = m_slots[t_thread_num % m_nslots].readers[m_epoch.load() & 1];
+        readers.fetch_add(1);
+        return &readers;
+    }
+
+private:
+    uint32_t const m_nslots;
+    std::unique_ptr< slot[] > m_slots;
+    std::atomic< uint64_t > m_epoch{0};
+};
+
+// Optimistic readers search node memory which writers modify in place, and discard whatever they read if the node
+// version changed meanwhile, like a seqlock reader. Those reads race with the writers by design, so reads within the
+// scope are hidden from tsan. Only the reads of the current thread are ignored, writers are still checked.
+class btree_racy_read_scope {
+public:
+    btree_racy_read_scope() {
+#ifdef _BT_TSAN_ENABLED
+        AnnotateIgnoreReadsBegin(__FILE__, __LINE__);
+#endif
+    }
+    btree_racy_read_scope(const btree_racy_read_scope&) = delete;
+    btree_racy_read_scope& operator=(const btree_racy_read_scope&) = delete;
+    ~btree_racy_read_scope() {
+#ifdef _BT_TSAN_ENABLED
+        AnnotateIgnoreReadsEnd(__FILE__, __LINE__);
+#endif
+    }
+};
+
 class BtreeMetrics : public sisl::MetricsGroup {
 public:
+    // sisl reports the counters keyed by their description, so the counters read back (by Btree::get_status and the
+    // tests) register their description from here and are looked up by the same constants.
+    struct desc {
+        static constexpr const char* retry_count{"number of retries"};
+        static constexpr const char* cache_hits{"Number of node reads served from the index write back cache"};
+        static constexpr const char* cache_misses{"Number of node reads which missed the index write back cache"};
+        static constexpr const char* optimistic_read_hits{"Number of lookups served by an optimistic read"};
+        static constexpr const char* optimistic_read_retries{"Number of optimistic reads failed version validation"};
+        static constexpr const char* optimistic_read_fallbacks{
+            "Number of optimistic reads fell back to locked traversal"};
+        static constexpr const char* write_ops_count{"number of btree put operations"};
+        static constexpr const char* remove_ops_count{"number of btree remove operations"};
+        static constexpr const char* node_compactions{"Number of nodes compacted before being written"};
+    };
+
     explicit BtreeMetrics(const char* inst_name) : sisl::MetricsGroup("Btree", inst_name) {
         REGISTER_COUNTER(btree_obj_count, "Btree object count", _publish_as::publish_as_gauge);
         REGISTER_COUNTER(btree_leaf_node_count, "Btree Leaf node count", "btree_node_count", {"node_type", "leaf"},
@@ -317,12 +571,19 @@ public:
                            {"node_type", "interior"}, HistogramBucketsType(PercentileBuckets));
         REGISTER_HISTOGRAM(btree_leaf_node_occupancy, "Leaf node occupancy", "btree_node_occupancy",
                            {"node_type", "leaf"}, HistogramBucketsType(PercentileBuckets));
-        REGISTER_COUNTER(btree_retry_count, "number of retries");
+        REGISTER_COUNTER(btree_node_compactions, desc::node_compactions);
+        REGISTER_COUNTER(btree_node_compacted_bytes, "Bytes reclaimed by compacting nodes before being written");
+        REGISTER_COUNTER(btree_retry_count, desc::retry_count);
+        REGISTER_COUNTER(btree_cache_hits, desc::cache_hits);
+        REGISTER_COUNTER(btree_cache_misses, desc::cache_misses);
+        REGISTER_COUNTER(btree_optimistic_read_hits, desc::optimistic_read_hits);
+        REGISTER_COUNTER(btree_optimistic_read_retries, desc::optimistic_read_retries);
+        REGISTER_COUNTER(btree_optimistic_read_fallbacks, desc::optimistic_read_fallbacks);
         REGISTER_COUNTER(write_err_cnt, "number of errors in write");
         REGISTER_COUNTER(query_err_cnt, "number of errors in query");
-        REGISTER_COUNTER(btree_write_ops_count, "number of btree operations");
-        REGISTER_COUNTER(btree_query_ops_count, "number of btree operations");
-        REGISTER_COUNTER(btree_remove_ops_count, "number of btree operations");
+        REGISTER_COUNTER(btree_write_ops_count, desc::write_ops_count);
+        REGISTER_COUNTER(btree_query_ops_count, "number of btree query operations");
+        REGISTER_COUNTER(btree_remove_ops_count, desc::remove_ops_count);
         REGISTER_HISTOGRAM(btree_exclusive_time_in_int_node,
                            "Exclusive time spent (Write locked) on interior node (ns)", "btree_exclusive_time_in_node",
                            {"node_type", "interior"}, HistogramBucketsType(OpLatecyBuckets));
@@ -335,6 +596,10 @@ public:
         REGISTER_HISTOGRAM(btree_inclusive_time_in_leaf_node, "Inclusive time spent (Read locked) on leaf node (ns)",
                            "btree_inclusive_time_in_node", {"node_type", "leaf"},
                            HistogramBucketsType(OpLatecyBuckets));
+        REGISTER_HISTOGRAM(btree_lock_wait_in_int_node, "Time spent waiting for a contended interior node lock (ns)",
+                           "btree_lock_wait_in_node", {"node_type", "interior"}, HistogramBucketsType(OpLatecyBuckets));
+        REGISTER_HISTOGRAM(btree_lock_wait_in_leaf_node, "Time spent waiting for a contended leaf node lock (ns)",
+                           "btree_lock_wait_in_node", {"node_type", "leaf"}, HistogramBucketsType(OpLatecyBuckets));
 
         register_me_to_farm();
     }
@@ -15,6 +15,7 @@
  *********************************************************************************/
 
 #pragma once
+#include <atomic>
 #include <iostream>
 #include <queue>
 #include <iomgr/fiber_lib.hpp>
@@ -101,6 +102,10 @@ public:
     transient_hdr_t m_trans_hdr;
     uint8_t* m_phys_node_buf;
 
+    // Version of the node, bumped on every write lock and unlock. Odd value means a writer is modifying the node.
+    // Used by optimistic readers to validate a lock free read of the node.
+    mutable std::atomic< uint64_t > m_version{0};
+
 public:
     BtreeNode(uint8_t* node_buf, bnodeid_t id, bool init_buf, bool is_leaf, BtreeConfig const& cfg) :
             m_phys_node_buf{node_buf} {
@@ -345,17 +350,42 @@ public:
             m_trans_hdr.lock.lock_shared();
         } else if (l == locktype_t::WRITE) {
             m_trans_hdr.lock.lock();
+            m_version.fetch_add(1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+        }
+    }
+
+    // Acquires the lock only if it is free, so that the caller can tell a contended lock apart
+    bool try_lock(locktype_t l) const {
+        if (l == locktype_t::READ) {
+            return m_trans_hdr.lock.try_lock_shared();
+        } else if (l == locktype_t::WRITE) {
+            if (!m_trans_hdr.lock.try_lock()) { return false; }
+            m_version.fetch_add(1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
         }
+        return true;
     }
 
     void unlock(locktype_t l) const {
         if (l == locktype_t::READ) {
             m_trans_hdr.lock.unlock_shared();
         } else if (l == locktype_t::WRITE) {
+            m_version.fetch_add(1, std::memory_order_release);
             m_trans_hdr.lock.unlock();
         }
     }
 
+    // Returns the version to be validated after an optimistic read of the node. Odd version means a writer is active
+    // and the read is bound to fail validation.
+    uint64_t optimistic_read_begin() const { return m_version.load(std::memory_order_acquire); }
+
+    // Returns true if the node has not been write locked since optimistic_read_begin() returned the version
+    bool optimistic_read_validate(uint64_t version) const {
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return ((version & 1) == 0) && (m_version.load(std::memory_order_relaxed) == version);
+    }
+
     void lock_upgrade() {
         m_trans_hdr.upgraders.increment(1);
         this->unlock(locktype_t::READ);
@@ -425,6 +455,12 @@ public:
     virtual uint32_t move_in_from_right_by_size(const BtreeConfig& cfg, BtreeNode& other_node, uint32_t size) = 0;*/
 
     virtual uint32_t available_size() const = 0;
+
+    // Space left unusable by removes (prefix holes, fragmented object area), which reclaim_space() gets back by
+    // rewriting the node in place. Node types which reuse the removed space right away have none.
+    virtual uint32_t reclaimable_size() const { return 0; }
+    virtual void reclaim_space() {}
+
     virtual bool has_room_for_put(btree_put_type put_type, uint32_t key_size, uint32_t value_size) const = 0;
     virtual uint32_t num_entries_by_size(uint32_t start_idx, uint32_t size) const = 0;
 
@@ -445,7 +481,7 @@ public:
     virtual std::string to_dot_keys() const = 0;
 
 protected:
-    node_find_result_t bsearch_node(const BtreeKey& key) const {
+    virtual node_find_result_t bsearch_node(const BtreeKey& key) const {
         DEBUG_ASSERT_EQ(magic(), BTREE_NODE_MAGIC);
         auto [found, idx] = bsearch(-1, total_entries(), key);
         if (found) { DEBUG_ASSERT_LT(idx, total_entries()); }
@@ -19,6 +19,7 @@
 #include <homestore/btree/detail/simple_node.hpp>
 #include <homestore/btree/detail/varlen_node.hpp>
 #include <homestore/btree/detail/prefix_node.hpp>
+#include <homestore/btree/detail/compact_node.hpp>
 #include <sisl/fds/utils.hpp>
 // #include <iomgr/iomgr_flip.hpp>
 
@@ -41,15 +42,48 @@ btree_status_t Btree< K, V >::create_root_node(void* op_context) {
         return btree_status_t::space_not_avail;
     }
 
-    m_root_node_info = BtreeLinkInfo{root->node_id(), root->link_version()};
+    set_root_link(BtreeLinkInfo{root->node_id(), root->link_version()});
     ret = on_root_changed(root, op_context);
     if (ret != btree_status_t::success) {
         free_node(root, locktype_t::NONE, op_context);
-        m_root_node_info = BtreeLinkInfo{};
+        set_root_link(BtreeLinkInfo{});
     }
     return ret;
 }
 
+template < typename K, typename V >
+void Btree< K, V >::set_root_link(BtreeLinkInfo const& info) {
+    m_root_node_info = info;
+    m_root_node_id.store(info.bnode_id(), std::memory_order_release);
+    m_root_version.fetch_add(1, std::memory_order_release);
+}
+
+/*
+ * Returns the node an optimistic reader can search on. Fixed size layouts compute every offset from an entry index
+ * which is bounded by the node capacity, so a search racing with a writer stays within the node buffer and is searched
+ * in place. Other layouts follow offsets stored in the node, which could be half updated, so they are copied into a
+ * per fiber buffer. Caller is expected to validate the node version before trusting anything it read.
+ */
+template < typename K, typename V >
+BtreeNode* Btree< K, V >::optimistic_read_view(BtreeNode* node) const {
+    bool const is_leaf = node->is_leaf();
+    btree_node_type const node_type = is_leaf ? m_bt_cfg.leaf_node_type() : m_bt_cfg.interior_node_type();
+    if (node_type == btree_node_type::FIXED) { return node; }
+
+    auto& snap = bt_thread_vars()->node_snapshots[is_leaf ? 1 : 0];
+
+    // Thread variables are shared across all btrees of same K, V type, so recreate the node if the layout differs
+    if ((snap.node == nullptr) || (snap.node_type != node_type) || (snap.node_size != m_node_size)) {
+        snap.node = nullptr;
+        snap.buf = std::unique_ptr< uint8_t[] >(new uint8_t[m_node_size]);
+        snap.node = BtreeNodePtr{init_node(snap.buf.get(), empty_bnodeid, true /* init_buf */, is_leaf)};
+        snap.node_type = node_type;
+        snap.node_size = m_node_size;
+    }
+    std::memcpy(snap.buf.get(), node->m_phys_node_buf, m_node_size);
+    return snap.node.get();
+}
+
 /*
  * It reads the node and take a lock of the node.
  */
@@ -90,9 +124,20 @@ btree_status_t Btree< K, V >::get_child_and_lock_node(const BtreeNodePtr& node,
 
 template < typename K, typename V >
 btree_status_t Btree< K, V >::write_node(const BtreeNodePtr& node, void* context) {
+    if (m_bt_cfg.m_compact_reclaimable_pct != 0) {
+        auto const reclaimable = node->reclaimable_size();
+        if ((reclaimable != 0) && (reclaimable * 100 >= m_bt_cfg.m_compact_reclaimable_pct * m_node_size)) {
+            node->reclaim_space();
+            COUNTER_INCREMENT(m_metrics, btree_node_compactions, 1);
+            COUNTER_INCREMENT(m_metrics, btree_node_compacted_bytes, reclaimable);
+        }
+    }
+
     COUNTER_INCREMENT_IF_ELSE(m_metrics, node->is_leaf(), btree_leaf_node_writes, btree_int_node_writes, 1);
+    auto const fill_pct = ((m_node_size - node->available_size()) * 100) / m_node_size;
     HISTOGRAM_OBSERVE_IF_ELSE(m_metrics, node->is_leaf(), btree_leaf_node_occupancy, btree_int_node_occupancy,
-                              ((m_node_size - node->available_size()) * 100) / m_node_size);
+                              fill_pct);
+    m_fill_sampler.sample(node->level(), fill_pct, m_bt_cfg.m_fill_sample_every);
 
     return (write_node_impl(node, context));
 }
@@ -213,7 +258,12 @@ template < typename K, typename V >
 btree_status_t Btree< K, V >::_lock_node(const BtreeNodePtr& node, locktype_t type, void* context, const char* fname,
                                          int line) const {
     _start_of_lock(node, type, fname, line);
-    node->lock(type);
+    if (!node->try_lock(type)) {
+        // Only a contended lock pays for timing the wait
+        auto const wait_start = Clock::now();
+        node->lock(type);
+        observe_lock_wait(node, get_elapsed_time_ns(wait_start));
+    }
 
     auto ret = refresh_node(node, (type == locktype_t::WRITE), context);
     if (ret != btree_status_t::success) {
@@ -289,6 +339,11 @@ BtreeNode* Btree< K, V >::init_node(uint8_t* node_buf, bnodeid_t id, bool init_b
                     : create_node< FixedPrefixNode< K, BtreeLinkInfo > >(node_buf, id, init_buf, false, this->m_bt_cfg);
         break;
 
+    case btree_node_type::COMPACT:
+        n = is_leaf ? create_node< CompactNode< K, V > >(node_buf, id, init_buf, true, this->m_bt_cfg)
+                    : create_node< CompactNode< K, BtreeLinkInfo > >(node_buf, id, init_buf, false, this->m_bt_cfg);
+        break;
+
     default:
         BT_REL_ASSERT(false, "Unsupported node type {}", node_type);
         break;
@@ -326,6 +381,13 @@ void Btree< K, V >::observe_lock_time(const BtreeNodePtr& node, locktype_t type,
     }
 }
 
+template < typename K, typename V >
+void Btree< K, V >::observe_lock_wait(const BtreeNodePtr& node, uint64_t wait_ns) const {
+    HISTOGRAM_OBSERVE_IF_ELSE(m_metrics, node->is_leaf(), btree_lock_wait_in_leaf_node, btree_lock_wait_in_int_node,
+                              wait_ns);
+    m_contention.record(node->node_id(), node->is_leaf(), wait_ns);
+}
+
 template < typename K, typename V >
 void Btree< K, V >::_start_of_lock(const BtreeNodePtr& node, locktype_t ltype, const char* fname, int line) {
     btree_locked_node_info info;
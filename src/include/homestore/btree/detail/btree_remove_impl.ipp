@@ -210,7 +210,7 @@ btree_status_t Btree< K, V >::check_collapse_root(ReqT& req) {
     if (req.route_tracing) { append_route_trace(req, root, btree_event_t::MERGE); }
 
     free_node(root, locktype_t::WRITE, req.m_op_context);
-    m_root_node_info = child->link_info();
+    set_root_link(child->link_info());
     this->m_btree_depth = child->level();
     unlock_node(child, locktype_t::WRITE);
     COUNTER_DECREMENT(m_metrics, btree_depth, 1);
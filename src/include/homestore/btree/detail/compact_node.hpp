@@ -0,0 +1,440 @@
+/*********************************************************************************
+ * Modifications Copyright 2017-2019 eBay Inc.
+ *
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *    https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed
+ * under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ *
+ *********************************************************************************/
+#pragma once
+
+#include <homestore/btree/btree_kv.hpp>
+#include <homestore/btree/detail/variant_node.hpp>
+#include <homestore/btree/detail/btree_internal.hpp>
+#include "homestore/index/index_internal.hpp"
+
+SISL_LOGGING_DECL(btree)
+
+namespace homestore {
+
+// Read optimized node layout for fixed size keys and values. Keys are kept in a dense sorted array separate from the
+// values, so a search only touches key bytes. On top of the keys, every fence_stride'th key is copied into a small
+// fence index laid out in eytzinger (BFS) order, which lets a lookup narrow down to one block of keys by walking a
+// handful of contiguous cache lines, before doing a binary search within that block.
+//
+// Internal format of compact node:
+// [Persistent Header][compact_node_header][fence ranks][fence keys (eytzinger order)][Key1][Key2]...[Val1][Val2]...
+//
+// The fence index is rebuilt on every mutation, so updates cost more than SimpleNode in exchange for faster searches.
+// It is best suited for read mostly trees or for trees which are built by bulk load/merge where the index is
+// rebuilt once per batch of entries moved/copied.
+template < typename K, typename V >
+class CompactNode : public VariantNode< K, V > {
+public:
+    static constexpr uint32_t fence_stride = 16;
+
+    CompactNode(uint8_t* node_buf, bnodeid_t id, bool init, bool is_leaf, const BtreeConfig& cfg) :
+            VariantNode< K, V >(node_buf, id, init, is_leaf, cfg) {
+        this->set_node_type(btree_node_type::COMPACT);
+        compute_layout();
+        if (init) { get_compact_header()->nfences = 0; }
+    }
+    virtual ~CompactNode() = default;
+
+    using BtreeNode::get_nth_key;
+    using BtreeNode::get_nth_key_internal;
+    using BtreeNode::get_nth_key_size;
+    using BtreeNode::get_nth_obj_size;
+    using BtreeNode::get_nth_value;
+    using BtreeNode::get_nth_value_size;
+    using BtreeNode::to_string;
+    using VariantNode< K, V >::get_nth_value;
+    using VariantNode< K, V >::max_keys_in_node;
+
+    // Insert the key and value in provided index
+    // Assumption: Node lock is already taken
+    btree_status_t insert(uint32_t ind, const BtreeKey& key, const BtreeValue& val) override {
+        uint32_t const nshift = this->total_entries() - ind;
+        if (nshift != 0) {
+            std::memmove(nth_key_ptr(ind + 1), nth_key_ptr(ind), nshift * m_key_size);
+            std::memmove(nth_value_ptr(ind + 1), nth_value_ptr(ind), nshift * m_value_size);
+        }
+        set_nth_key(ind, key);
+        set_nth_value(ind, val);
+        this->inc_entries();
+        this->inc_gen();
+        rebuild_fence_index();
+
+#ifndef NDEBUG
+        validate_sanity();
+#endif
+        return btree_status_t::success;
+    }
+
+    void update(uint32_t ind, const BtreeValue& val) override {
+        set_nth_value(ind, val);
+        this->inc_gen();
+    }
+
+    void update(uint32_t ind, const BtreeKey& key, const BtreeValue& val) override {
+        if (ind == this->total_entries()) {
+            DEBUG_ASSERT_EQ(this->is_leaf(), false);
+            this->set_edge_value(val);
+        } else {
+            set_nth_key(ind, key);
+            set_nth_value(ind, val);
+            if ((ind % fence_stride) == 0) { rebuild_fence_index(); }
+        }
+        this->inc_gen();
+    }
+
+    // ind_s and ind_e are inclusive
+    void remove(uint32_t ind_s, uint32_t ind_e) override {
+        uint32_t total_entries = this->total_entries();
+        DEBUG_ASSERT_GE(total_entries, ind_s, "node={}", to_string());
+        DEBUG_ASSERT_GE(total_entries, ind_e, "node={}", to_string());
+
+        if (ind_e == total_entries) { // edge entry
+            DEBUG_ASSERT((!this->is_leaf() && this->has_valid_edge()), "node={}", to_string());
+            // Set the last key/value as edge entry and by decrementing entry count automatically removed the last
+            // entry.
+            BtreeLinkInfo new_edge;
+            this->get_nth_value(ind_s - 1, &new_edge, false);
+            this->set_nth_value(total_entries, new_edge);
+            this->sub_entries(total_entries - ind_s + 1);
+        } else {
+            uint32_t const nshift = total_entries - ind_e - 1;
+            if (nshift != 0) {
+                std::memmove(nth_key_ptr(ind_s), nth_key_ptr(ind_e + 1), nshift * m_key_size);
+                std::memmove(nth_value_ptr(ind_s), nth_value_ptr(ind_e + 1), nshift * m_value_size);
+            }
+            this->sub_entries(ind_e - ind_s + 1);
+        }
+        this->inc_gen();
+        rebuild_fence_index();
+#ifndef NDEBUG
+        validate_sanity();
+#endif
+    }
+
+    void remove_all(const BtreeConfig&) override {
+        this->sub_entries(this->total_entries());
+        this->invalidate_edge();
+        this->inc_gen();
+        get_compact_header()->nfences = 0;
+    }
+
+    uint32_t move_out_to_right_by_entries(const BtreeConfig& cfg, BtreeNode& o, uint32_t nentries) override {
+        auto& other_node = s_cast< CompactNode< K, V >& >(o);
+
+        // Minimum of whats to be moved out and how many slots available in other node
+        nentries = std::min({nentries, this->total_entries(), other_node.get_available_entries()});
+        if (nentries != 0) {
+            uint32_t const other_n = other_node.total_entries();
+            std::memmove(other_node.nth_key_ptr(nentries), other_node.nth_key_ptr(0), other_n * m_key_size);
+            std::memmove(other_node.nth_value_ptr(nentries), other_node.nth_value_ptr(0), other_n * m_value_size);
+
+            uint32_t const from = this->total_entries() - nentries;
+            std::memcpy(other_node.nth_key_ptr(0), nth_key_ptr(from), nentries * m_key_size);
+            std::memcpy(other_node.nth_value_ptr(0), nth_value_ptr(from), nentries * m_value_size);
+        }
+
+        other_node.add_entries(nentries);
+        this->sub_entries(nentries);
+
+        // If there is an edgeEntry in this node, it needs to move to move out as well.
+        if (!this->is_leaf() && this->has_valid_edge()) {
+            other_node.set_edge_info(this->edge_info());
+            this->invalidate_edge();
+        }
+
+        other_node.inc_gen();
+        this->inc_gen();
+        other_node.rebuild_fence_index();
+        rebuild_fence_index();
+
+#ifndef NDEBUG
+        validate_sanity();
+#endif
+        return nentries;
+    }
+
+    uint32_t move_out_to_right_by_size(const BtreeConfig& cfg, BtreeNode& o, uint32_t size) override {
+        return (obj_size() * move_out_to_right_by_entries(cfg, o, size / obj_size()));
+    }
+
+    uint32_t num_entries_by_size(uint32_t start_idx, uint32_t size) const override {
+        return std::min(size / obj_size(), this->total_entries() - start_idx);
+    }
+
+    uint32_t copy_by_size(const BtreeConfig& cfg, const BtreeNode& o, uint32_t start_idx, uint32_t size) override {
+        auto& other = s_cast< const CompactNode< K, V >& >(o);
+        return copy_by_entries(cfg, o, start_idx, other.num_entries_by_size(start_idx, size));
+    }
+
+    uint32_t copy_by_entries(const BtreeConfig& cfg, const BtreeNode& o, uint32_t start_idx,
+                             uint32_t nentries) override {
+        auto& other = s_cast< const CompactNode< K, V >& >(o);
+
+        nentries = std::min(nentries, other.total_entries() - start_idx);
+        nentries = std::min(nentries, this->get_available_entries());
+#ifdef _PRERELEASE
+        const uint64_t max_keys = this->max_keys_in_node();
+        if (max_keys) {
+            if (this->total_entries() + nentries > max_keys) { nentries = max_keys - this->total_entries(); }
+        }
+#endif
+        if (nentries != 0) {
+            std::memcpy(nth_key_ptr(this->total_entries()), other.nth_key_ptr_const(start_idx), nentries * m_key_size);
+            std::memcpy(nth_value_ptr(this->total_entries()), other.nth_value_ptr_const(start_idx),
+                        nentries * m_value_size);
+        }
+        this->add_entries(nentries);
+        this->inc_gen();
+        rebuild_fence_index();
+
+        // If we copied everything from start_idx till end and if its an edge node, need to copy the edge id as well.
+        if (other.has_valid_edge() && ((start_idx + nentries) == other.total_entries())) {
+            this->set_edge_info(other.edge_info());
+        }
+        return nentries;
+    }
+
+    uint32_t available_size() const override { return get_available_entries() * obj_size(); }
+
+    bool has_room_for_put(btree_put_type put_type, uint32_t key_size, uint32_t value_size) const override {
+#ifdef _PRERELEASE
+        auto max_keys = max_keys_in_node();
+        if (max_keys) { return (this->total_entries() < max_keys); }
+#endif
+        return ((put_type == btree_put_type::UPSERT) || (put_type == btree_put_type::INSERT))
+            ? (get_available_entries() > 0)
+            : true;
+    }
+
+    void get_nth_key_internal(uint32_t ind, BtreeKey& out_key, bool copy) const override {
+        DEBUG_ASSERT_LT(ind, this->total_entries(), "node={}", to_string());
+        out_key.deserialize(sisl::blob{nth_key_ptr_const(ind), m_key_size}, copy);
+    }
+
+    void get_nth_value(uint32_t ind, BtreeValue* out_val, bool copy) const override {
+        if (ind == this->total_entries()) {
+            DEBUG_ASSERT_EQ(this->is_leaf(), false, "setting value outside bounds on leaf node");
+            DEBUG_ASSERT_EQ(this->has_valid_edge(), true, "node={}", to_string());
+            *(BtreeLinkInfo*)out_val = this->get_edge_value();
+        } else {
+            out_val->deserialize(sisl::blob{nth_value_ptr_const(ind), m_value_size}, copy);
+        }
+    }
+
+    uint32_t get_nth_key_size(uint32_t) const override { return m_key_size; }
+    uint32_t get_nth_value_size(uint32_t) const override { return m_value_size; }
+    uint32_t get_nth_obj_size(uint32_t) const override { return obj_size(); }
+
+    std::string to_string(bool print_friendly = false) const override {
+        auto snext = this->next_bnode() == empty_bnodeid ? "" : fmt::format("next_node={}", this->next_bnode());
+        auto str = fmt::format("{}id={} level={} nEntries={} {} {} nfences={} capacity={} {}",
+                               (print_friendly ? "------------------------------------------------------------\n" : ""),
+                               this->node_id(), this->level(), this->total_entries(),
+                               (this->is_leaf() ? "LEAF" : "INTERIOR"), snext, get_compact_header_const()->nfences,
+                               m_capacity, this->is_node_deleted() ? "  Deleted" : " LIVE");
+        if (this->has_valid_edge()) {
+            fmt::format_to(std::back_inserter(str), " edge={}.{}", this->edge_info().m_bnodeid,
+                           this->edge_info().m_link_version);
+        }
+
+        for (uint32_t i{0}; i < this->total_entries(); ++i) {
+            fmt::format_to(std::back_inserter(str), "{}Entry{} [Key={} Val={}]", (print_friendly ? "\n\t" : " "), i + 1,
+                           BtreeNode::get_nth_key< K >(i, false).to_string(),
+                           this->get_nth_value(i, false).to_string());
+        }
+        return str;
+    }
+
+    std::string to_dot_keys() const override { return "NOT Supported"; }
+
+#ifndef NDEBUG
+    void validate_sanity() {
+        if (this->total_entries() == 0) { return; }
+
+        // validate if keys are in ascending order and fence index points to the right keys
+        K prevKey = BtreeNode::get_nth_key< K >(0, false);
+        for (uint32_t i{1}; i < this->total_entries(); ++i) {
+            K key = BtreeNode::get_nth_key< K >(i, false);
+            if (prevKey.compare(key) > 0) {
+                LOGINFO("non sorted entry : {} -> {} ", prevKey.to_string(), key.to_string());
+                DEBUG_ASSERT(false, "node={}", to_string());
+            }
+            prevKey = key;
+        }
+
+        auto const nfences = get_compact_header_const()->nfences;
+        DEBUG_ASSERT_EQ(nfences, num_fences_for(this->total_entries()), "node={}", to_string());
+        if (nfences < 2) { return; }
+        for (uint32_t slot{0}; slot < nfences; ++slot) {
+            DEBUG_ASSERT_EQ(compare_fence(slot, BtreeNode::get_nth_key< K >(fence_rank(slot) * fence_stride, false)),
+                            0, "Fence index is out of sync with keys node={}", to_string());
+        }
+    }
+#endif
+
+protected:
+    using node_find_result_t = std::pair< bool, uint32_t >;
+
+    /// @brief Search the node for the key, using the fence index to narrow down the block of keys to binary search.
+    ///
+    /// Walking the eytzinger ordered fence array gives the first fence whose key is greater than the search key,
+    /// which means the search key, if present, is within the block of keys prior to that fence. Binary search within
+    /// that block returns the index of the first key which is >= search key, same as BtreeNode::bsearch_node.
+    node_find_result_t bsearch_node(const BtreeKey& key) const override {
+        DEBUG_ASSERT_EQ(this->magic(), BTREE_NODE_MAGIC);
+        uint32_t const nfences = get_compact_header_const()->nfences;
+        if (nfences < 2) { return BtreeNode::bsearch_node(key); }
+
+        uint32_t k{1};
+        while (k <= nfences) {
+            __builtin_prefetch(fence_key_ptr_const(std::min(k * fence_block_keys(), nfences - 1)));
+            k = 2 * k + ((compare_fence(k - 1, key) <= 0) ? 1 : 0);
+        }
+        k >>= __builtin_ffs(~k);
+
+        uint32_t block;
+        if (k == 0) {
+            // All fences are <= key, so it has to be in the last block.
+            block = nfences - 1;
+        } else {
+            auto const rank = fence_rank(k - 1);
+            if (rank == 0) { return std::make_pair(false, 0u); } // Key is less than first key in the node
+            block = rank - 1;
+        }
+
+        uint32_t const start = block * fence_stride;
+        uint32_t const end = std::min(start + fence_stride, this->total_entries());
+        auto [found, idx] = this->bsearch(int_cast(start) - 1, int_cast(end), key);
+        if (found) { DEBUG_ASSERT_LT(idx, this->total_entries()); }
+        return std::make_pair(found, idx);
+    }
+
+private:
+#pragma pack(1)
+    struct compact_node_header {
+        uint16_t nfences{0}; // Number of fence keys in the eytzinger index
+    };
+#pragma pack()
+
+    void compute_layout() {
+        m_key_size = dummy_key< K >.serialized_size();
+        m_value_size = dummy_value< V >.serialized_size();
+
+        // Each fence_stride entries need one fence slot (rank + key copy). Find the max entries which along with its
+        // fences fit in the data area.
+        uint32_t const data_size = this->node_data_size() - sizeof(compact_node_header);
+        uint32_t const fence_slot_size = m_key_size + sizeof(uint16_t);
+        m_capacity = (data_size * fence_stride) / ((obj_size() * fence_stride) + fence_slot_size);
+        while ((m_capacity * obj_size()) + (num_fences_for(m_capacity) * fence_slot_size) > data_size) {
+            --m_capacity;
+        }
+        m_max_fences = num_fences_for(m_capacity);
+    }
+
+    static constexpr uint32_t num_fences_for(uint32_t nentries) { return (nentries + fence_stride - 1) / fence_stride; }
+
+    // Number of fence keys which fit in a cache line. Descendants of position k a few levels down start at
+    // k * fence_block_keys(), so prefetching it hides the memory latency of the deeper levels of the index.
+    uint32_t fence_block_keys() const { return std::max(64u / m_key_size, 1u); }
+
+    uint32_t obj_size() const { return m_key_size + m_value_size; }
+    uint32_t get_available_entries() const { return m_capacity - this->total_entries(); }
+
+    compact_node_header* get_compact_header() { return r_cast< compact_node_header* >(this->node_data_area()); }
+    const compact_node_header* get_compact_header_const() const {
+        return r_cast< const compact_node_header* >(this->node_data_area_const());
+    }
+
+    uint16_t* fence_ranks() { return r_cast< uint16_t* >(this->node_data_area() + sizeof(compact_node_header)); }
+    uint16_t fence_rank(uint32_t slot) const {
+        return r_cast< const uint16_t* >(this->node_data_area_const() + sizeof(compact_node_header))[slot];
+    }
+
+    uint32_t fence_area_offset() const { return sizeof(compact_node_header) + (m_max_fences * sizeof(uint16_t)); }
+    uint32_t keys_area_offset() const { return fence_area_offset() + (m_max_fences * m_key_size); }
+    uint32_t values_area_offset() const { return keys_area_offset() + (m_capacity * m_key_size); }
+
+    uint8_t* fence_key_ptr(uint32_t slot) { return this->node_data_area() + fence_area_offset() + (slot * m_key_size); }
+    const uint8_t* fence_key_ptr_const(uint32_t slot) const {
+        return this->node_data_area_const() + fence_area_offset() + (slot * m_key_size);
+    }
+
+    uint8_t* nth_key_ptr(uint32_t ind) { return this->node_data_area() + keys_area_offset() + (ind * m_key_size); }
+    const uint8_t* nth_key_ptr_const(uint32_t ind) const {
+        return this->node_data_area_const() + keys_area_offset() + (ind * m_key_size);
+    }
+
+    uint8_t* nth_value_ptr(uint32_t ind) {
+        return this->node_data_area() + values_area_offset() + (ind * m_value_size);
+    }
+    const uint8_t* nth_value_ptr_const(uint32_t ind) const {
+        return this->node_data_area_const() + values_area_offset() + (ind * m_value_size);
+    }
+
+    int compare_fence(uint32_t slot, const BtreeKey& cmp_key) const {
+        K fkey;
+        fkey.deserialize(sisl::blob{fence_key_ptr_const(slot), m_key_size}, false);
+        return fkey.compare(cmp_key);
+    }
+
+    void set_nth_key(uint32_t ind, const BtreeKey& key) {
+        sisl::blob const b = key.serialize();
+        DEBUG_ASSERT_EQ(b.size(), m_key_size, "Compact node supports only fixed size keys");
+        std::memcpy(nth_key_ptr(ind), b.cbytes(), b.size());
+    }
+
+    void set_nth_value(uint32_t ind, const BtreeValue& v) {
+        sisl::blob const b = v.serialize();
+        if (ind >= this->total_entries()) {
+            RELEASE_ASSERT_EQ(this->is_leaf(), false, "setting value outside bounds on leaf node");
+            DEBUG_ASSERT_EQ(b.size(), sizeof(BtreeLinkInfo::bnode_link_info),
+                            "Invalid value size being set for non-leaf node");
+            this->set_edge_info(*r_cast< BtreeLinkInfo::bnode_link_info const* >(b.cbytes()));
+        } else {
+            DEBUG_ASSERT_EQ(b.size(), m_value_size, "Compact node supports only fixed size values");
+            std::memcpy(nth_value_ptr(ind), b.cbytes(), b.size());
+        }
+    }
+
+    // Lay out every fence_stride'th key in eytzinger order, i.e. an in-order walk of the implicit binary tree
+    // rooted at position 1 (children of position k are 2k and 2k+1) assigns fences in sorted order.
+    void rebuild_fence_index() {
+        uint32_t const nfences = num_fences_for(this->total_entries());
+        DEBUG_ASSERT_LE(nfences, m_max_fences, "node={}", to_string());
+        get_compact_header()->nfences = s_cast< uint16_t >(nfences);
+        if (nfences < 2) { return; } // Too small to be worth the indirection, bsearch_node falls back to plain bsearch
+
+        uint32_t rank{0};
+        fill_eytzinger(1u, nfences, rank);
+        DEBUG_ASSERT_EQ(rank, nfences);
+    }
+
+    void fill_eytzinger(uint32_t k, uint32_t nfences, uint32_t& rank) {
+        if (k > nfences) { return; }
+        fill_eytzinger(2 * k, nfences, rank);
+        fence_ranks()[k - 1] = s_cast< uint16_t >(rank);
+        std::memcpy(fence_key_ptr(k - 1), nth_key_ptr_const(rank * fence_stride), m_key_size);
+        ++rank;
+        fill_eytzinger(2 * k + 1, nfences, rank);
+    }
+
+private:
+    uint32_t m_key_size;
+    uint32_t m_value_size;
+    uint32_t m_capacity;   // Max number of entries this node can hold
+    uint32_t m_max_fences; // Max number of fence slots reserved for m_capacity entries
+};
+} // namespace homestore
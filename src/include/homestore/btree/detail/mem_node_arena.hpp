@@ -0,0 +1,191 @@
+/*********************************************************************************
+ * Modifications Copyright 2017-2019 eBay Inc.
+ *
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *    https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed
+ * under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ *
+ *********************************************************************************/
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace homestore {
+/// @brief Slab arena for the fixed size node buffers of MemBtree.
+///
+/// Node buffers are carved out of slabs of about slab_size bytes and a freed buffer goes back to a free list of its
+/// slab, so that splits reuse the buffers of merged/removed nodes instead of going to the heap. The arena is split into
+/// shards and each thread allocates from the shard it is assigned on first use, so that threads of different reactors
+/// don't contend on a single lock and mostly reuse the buffers they have touched. A buffer freed by another thread goes
+/// back to the shard which owns its slab.
+///
+/// A slab whose buffers are all free is returned to the heap once its shard holds more than its share of
+/// max_free_bytes in free buffers, so that the memory held by the arena after a churn is bounded by what is in use.
+class MemNodeArena {
+public:
+    static constexpr uint32_t slab_size{256 * 1024};
+    static constexpr uint32_t min_nodes_per_slab{4};
+    static constexpr uint32_t max_shards{16};
+
+    MemNodeArena(uint32_t node_size, uint64_t max_free_bytes) :
+            m_node_size{node_size},
+            m_slot_size{((node_size + (2 * slot_hdr_size) - 1) / slot_hdr_size) * slot_hdr_size},
+            m_nodes_per_slab{std::max(slab_size / m_slot_size, min_nodes_per_slab)},
+            m_nshards{std::clamp(std::thread::hardware_concurrency(), 1u, max_shards)},
+            m_shards{std::make_unique< shard[] >(m_nshards)},
+            m_max_free_slots_per_shard{max_free_bytes / m_nshards / m_slot_size} {}
+
+    MemNodeArena(const MemNodeArena&) = delete;
+    MemNodeArena& operator=(const MemNodeArena&) = delete;
+
+    ~MemNodeArena() {
+        for (uint32_t i{0}; i < m_nshards; ++i) {
+            for (auto head : {m_shards[i].avail, m_shards[i].full, m_shards[i].empty}) {
+                while (head) {
+                    auto next = head->next;
+                    delete head;
+                    head = next;
+                }
+            }
+        }
+    }
+
+    uint8_t* alloc() {
+        auto& sh = thread_shard();
+        std::unique_lock lg{sh.mtx};
+        // Partially used slabs are filled up first, so that the wholly free ones stay free and can be released
+        slab* s = sh.avail;
+        if (s == nullptr) {
+            if (sh.empty) {
+                s = sh.empty;
+                unlink(sh.empty, s);
+            } else {
+                auto const bytes = uint64_t(m_slot_size) * m_nodes_per_slab;
+                s = new slab{&sh, std::make_unique< uint8_t[] >(bytes), m_nodes_per_slab};
+                sh.nfree_slots += m_nodes_per_slab;
+                m_slab_bytes.fetch_add(bytes, std::memory_order_relaxed);
+            }
+            link(sh.avail, s);
+        }
+
+        uint8_t* slot;
+        if (s->free_list) {
+            slot = s->free_list;
+            s->free_list = *reinterpret_cast< uint8_t** >(slot + slot_hdr_size);
+        } else {
+            // Carve the next untouched slot, so that a new slab's pages are touched only as it fills
+            slot = s->mem.get() + uint64_t(m_slot_size) * s->ncarved++;
+            *reinterpret_cast< slab** >(slot) = s;
+        }
+        if (--s->nfree == 0) {
+            unlink(sh.avail, s);
+            link(sh.full, s);
+        }
+        --sh.nfree_slots;
+        m_inuse_bytes.fetch_add(m_node_size, std::memory_order_relaxed);
+        return slot + slot_hdr_size;
+    }
+
+    void free(uint8_t* buf) {
+        uint8_t* slot = buf - slot_hdr_size;
+        slab* s = *reinterpret_cast< slab** >(slot);
+        auto& sh = *s->owner;
+        m_inuse_bytes.fetch_sub(m_node_size, std::memory_order_relaxed);
+
+        std::unique_lock lg{sh.mtx};
+        *reinterpret_cast< uint8_t** >(buf) = s->free_list;
+        s->free_list = slot;
+        if (s->nfree++ == 0) {
+            unlink(sh.full, s);
+            link(sh.avail, s);
+        }
+        ++sh.nfree_slots;
+
+        if (s->nfree == m_nodes_per_slab) {
+            unlink(sh.avail, s);
+            if (sh.nfree_slots > m_max_free_slots_per_shard) {
+                sh.nfree_slots -= m_nodes_per_slab;
+                m_slab_bytes.fetch_sub(uint64_t(m_slot_size) * m_nodes_per_slab, std::memory_order_relaxed);
+                delete s;
+            } else {
+                link(sh.empty, s);
+            }
+        }
+    }
+
+    uint32_t node_size() const { return m_node_size; }
+
+    // Bytes held from the heap, including the free buffers and slot headers
+    uint64_t slab_bytes() const { return m_slab_bytes.load(std::memory_order_relaxed); }
+
+    // Bytes of node buffers handed out and not yet freed
+    uint64_t inuse_bytes() const { return m_inuse_bytes.load(std::memory_order_relaxed); }
+
+private:
+    // Each slot is the slab pointer followed by the node buffer, padded so that node buffers are 16 byte aligned
+    static constexpr uint32_t slot_hdr_size{16};
+
+    struct shard;
+    struct slab {
+        shard* owner;
+        std::unique_ptr< uint8_t[] > mem;
+        uint32_t nfree;              // Slots not in use, freed or never carved
+        uint32_t ncarved{0};         // Slots handed out at least once, the rest of the slab is untouched
+        uint8_t* free_list{nullptr}; // Freed slots, linked through the first bytes of their node buffer
+        slab* prev{nullptr};
+        slab* next{nullptr};
+    };
+
+    struct shard {
+        std::mutex mtx;
+        slab* avail{nullptr}; // Slabs partially in use
+        slab* full{nullptr};
+        slab* empty{nullptr}; // Slabs with all slots free, retained within max_free_bytes
+        uint64_t nfree_slots{0};
+    };
+
+    static void link(slab*& head, slab* s) {
+        s->prev = nullptr;
+        s->next = head;
+        if (head) { head->prev = s; }
+        head = s;
+    }
+
+    static void unlink(slab*& head, slab* s) {
+        if (s->prev) {
+            s->prev->next = s->next;
+        } else {
+            head = s->next;
+        }
+        if (s->next) { s->next->prev = s->prev; }
+        s->prev = s->next = nullptr;
+    }
+
+    shard& thread_shard() {
+        static std::atomic< uint32_t > s_nthreads{0};
+        static thread_local uint32_t const t_thread_num = s_nthreads.fetch_add(1, std::memory_order_relaxed);
+        return m_shards[t_thread_num % m_nshards];
+    }
+
+private:
+    uint32_t const m_node_size;
+    uint32_t const m_slot_size;
+    uint32_t const m_nodes_per_slab;
+    uint32_t const m_nshards;
+    std::unique_ptr< shard[] > m_shards;
+    uint64_t const m_max_free_slots_per_shard;
+    std::atomic< uint64_t > m_slab_bytes{0};
+    std::atomic< uint64_t > m_inuse_bytes{0};
+};
+} // namespace homestore
@@ -212,7 +212,10 @@ public:
             K cur_key = keys.start_key();
 
             if (!keys.is_start_inclusive()) { cur_key.shift(1, app_ctx); }
-            if (!has_room(1u)) { return btree_status_t::space_not_avail; }
+            if (!has_room(1u)) {
+                if (!has_room_after_compaction(1u)) { return btree_status_t::space_not_avail; }
+                compact();
+            }
             bool upserted_all{false};
 
             auto [found, idx] = this->find(cur_key, nullptr, false);
@@ -265,7 +268,11 @@ public:
                 }
 
                 cur_key.shift(1, app_ctx);
-                if (!has_room(1u)) { break; }
+                if (!has_room(1u)) {
+                    if (!has_room_after_compaction(1u)) { break; }
+                    compact();
+                    prefix_slot = std::numeric_limits< uint16_t >::max(); // Compaction could have moved the prefix
+                }
 
                 if (decision != put_filter_decision::remove) { ++idx; }
                 found =
@@ -368,6 +375,11 @@ public:
 
     uint32_t compact_saving() const { return num_prefix_holes() * prefix_entry::size(); }
 
+    uint32_t reclaimable_size() const override { return compact_saving(); }
+    void reclaim_space() override {
+        if (num_prefix_holes() != 0) { compact(); }
+    }
+
     uint32_t available_size() const override {
         auto num_holes = num_prefix_holes();
         if (num_holes > prefix_node_header::min_holes_to_compact) {
@@ -387,7 +399,8 @@ public:
         auto max_keys = this->max_keys_in_node();
         if (max_keys && this->total_entries() > max_keys) { return false; }
 #endif
-        return has_room(1u);
+        // Insert compacts the prefix holes if needed, so that they don't cause a split
+        return has_room_after_compaction(1u);
     }
 
     uint32_t get_nth_key_size(uint32_t) const override { return dummy_key< K >.serialized_size(); }
@@ -485,7 +498,10 @@ public:
     }
 
     btree_status_t insert(uint32_t idx, BtreeKey const& key, BtreeValue const& val) override {
-        if (!has_room(1u)) { return btree_status_t::space_not_avail; }
+        if (!has_room(1u)) {
+            if (!has_room_after_compaction(1u)) { return btree_status_t::space_not_avail; }
+            compact();
+        }
 
         std::memmove(get_suffix_entry(idx + 1), get_suffix_entry(idx),
                      (this->total_entries() - idx) * suffix_entry::size());
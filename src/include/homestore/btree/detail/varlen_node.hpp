@@ -452,6 +452,11 @@ public:
 
     uint32_t available_size() const override { return get_var_node_header_const()->m_available_space; }
 
+    uint32_t reclaimable_size() const override { return available_size() - get_arena_free_space(); }
+    void reclaim_space() override {
+        if (reclaimable_size() != 0) { compact(); }
+    }
+
     void set_nth_key(uint32_t ind, const BtreeKey& key) {
         const auto kb = key.serialize();
         assert(ind < this->total_entries());
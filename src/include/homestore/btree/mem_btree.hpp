@@ -14,6 +14,9 @@
  *
  *********************************************************************************/
 #pragma once
+#include <mutex>
+#include <vector>
+
 #ifdef StoreSpecificBtreeNode
 #undef StoreSpecificBtreeNode
 #endif
@@ -21,15 +24,33 @@
 #define StoreSpecificBtreeNode BtreeNode
 
 #include "btree.ipp"
+#include "detail/mem_node_arena.hpp"
 
 namespace homestore {
 template < typename K, typename V >
 class MemBtree : public Btree< K, V > {
 private:
-    std::vector< std::shared_ptr< uint8_t[] > > node_buf_ptr_vec;
+    MemNodeArena m_node_arena;
+
+    // Node id is the node pointer itself, so with optimistic reads, freed nodes are retained till the optimistic
+    // readers which could have reached them are gone, so that a reader holding a stale id reads a deleted node instead
+    // of freed memory.
+    struct retired_node {
+        uint64_t epoch;
+        BtreeNodePtr node;
+    };
+    std::mutex m_retired_mtx;
+    std::vector< retired_node > m_retired_nodes;
+
+    // Otherwise freed nodes wait here till the operation which freed them drops its references, after which their
+    // buffers go back to the arena.
+    std::mutex m_freed_mtx;
+    std::vector< BtreeNodePtr > m_freed_nodes;
 
 public:
-    MemBtree(const BtreeConfig& cfg) : Btree< K, V >(cfg) {
+    MemBtree(const BtreeConfig& cfg) :
+            Btree< K, V >(cfg, true /* supports_optimistic_read */),
+            m_node_arena{cfg.node_size(), cfg.m_mem_max_free_node_bytes} {
         BT_LOG(INFO, "New {} being created: Node size {}", btree_store_type(), cfg.node_size());
         auto const status = this->create_root_node(nullptr);
         if (status != btree_status_t::success) { throw std::runtime_error(fmt::format("Unable to create root node")); }
@@ -42,12 +63,16 @@ public:
 
     std::string btree_store_type() const override { return "MEM_BTREE"; }
 
+    // Bytes held by the node arena, including freed node buffers retained for reuse
+    uint64_t node_mem_bytes() const { return m_node_arena.slab_bytes(); }
+    uint64_t node_inuse_bytes() const { return m_node_arena.inuse_bytes(); }
+
 private:
     BtreeNodePtr alloc_node(bool is_leaf) override {
-        std::shared_ptr< uint8_t[] > ptr(new uint8_t[this->m_bt_cfg.node_size()]);
-        node_buf_ptr_vec.emplace_back(ptr);
+        if (this->m_bt_cfg.m_optimistic_read) { reclaim_retired_nodes(); }
+        reclaim_freed_nodes();
 
-        auto new_node = this->init_node(ptr.get(), bnodeid_t{0}, true, is_leaf);
+        auto new_node = this->init_node(m_node_arena.alloc(), bnodeid_t{0}, true, is_leaf);
         new_node->set_node_id(bnodeid_t{r_cast< std::uintptr_t >(new_node)});
         new_node->m_refcount.increment();
         return BtreeNodePtr{new_node};
@@ -60,11 +85,59 @@ private:
         return btree_status_t::success;
     }
 
+    BtreeNode* peek_node_impl(bnodeid_t id) const override { return r_cast< BtreeNode* >(id); }
+
     btree_status_t refresh_node(const BtreeNodePtr& node, bool for_read_modify_write, void* context) const override {
         return btree_status_t::success;
     }
 
-    void free_node_impl(const BtreeNodePtr& node, void* context) override { intrusive_ptr_release(node.get()); }
+    void free_node_impl(const BtreeNodePtr& node, void* context) override {
+        if (this->m_bt_cfg.m_optimistic_read) {
+            {
+                // Take over the reference alloc_node had taken, instead of releasing it. Node is already unlinked from
+                // the tree, so only readers of the current epoch or earlier could be on it.
+                std::unique_lock lg{m_retired_mtx};
+                m_retired_nodes.push_back(
+                    retired_node{this->m_read_epoch.current(), BtreeNodePtr{node.get(), false /* add_ref */}});
+            }
+            reclaim_retired_nodes();
+            reclaim_freed_nodes();
+        } else {
+            reclaim_freed_nodes();
+            std::unique_lock lg{m_freed_mtx};
+            m_freed_nodes.emplace_back(node.get(), false /* add_ref */);
+        }
+    }
+
+    // Retired nodes which no optimistic reader can be on any more are handed over to the freed nodes, where they wait
+    // for the references of locked readers to be dropped.
+    void reclaim_retired_nodes() {
+        std::unique_lock lg{m_retired_mtx, std::try_to_lock};
+        if (!lg.owns_lock() || m_retired_nodes.empty()) { return; }
+
+        auto const cur_epoch = this->m_read_epoch.try_advance();
+        std::unique_lock freed_lg{m_freed_mtx};
+        std::erase_if(m_retired_nodes, [this, cur_epoch](retired_node& rn) {
+            if (!btree_read_epoch::is_reclaimable(rn.epoch, cur_epoch)) { return false; }
+            m_freed_nodes.push_back(std::move(rn.node));
+            return true;
+        });
+    }
+
+    void reclaim_freed_nodes() {
+        std::unique_lock lg{m_freed_mtx, std::try_to_lock};
+        if (!lg.owns_lock() || m_freed_nodes.empty()) { return; }
+
+        // A freed node is already unlinked from the tree, so no new references can be taken on it. Once the only
+        // reference left is ours, the node can be deleted and its buffer reused.
+        std::erase_if(m_freed_nodes, [this](BtreeNodePtr& node) {
+            if (node->m_refcount.get() != 1) { return false; }
+            auto buf = node->m_phys_node_buf;
+            node.reset();
+            m_node_arena.free(buf);
+            return true;
+        });
+    }
 
     btree_status_t transact_nodes(const BtreeNodeList& new_nodes, const BtreeNodeList& freed_nodes,
                                   const BtreeNodePtr& left_child_node, const BtreeNodePtr& parent_node,
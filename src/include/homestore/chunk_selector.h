@@ -28,6 +28,10 @@ public:
     virtual void on_alloc_blk(chunk_num_t chunk_num, blk_count_t nblks) {}
     virtual void on_free_blk(chunk_num_t chunk_num, blk_count_t nblks) {}
 
+    // Whether on_free_blk should also be called at cp flush for the blks whose free was deferred to the cp. Selectors
+    // keeping their own count of free blks per chunk need it, the rest are only told about blks freed right away.
+    virtual bool track_deferred_free() const { return false; }
+
     virtual ~ChunkSelector() = default;
 };
 } // namespace homestore
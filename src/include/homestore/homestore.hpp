@@ -132,6 +132,7 @@ private:
     HS_SERVICE m_services; // Services homestore is starting with
     hs_before_services_starting_cb_t m_before_services_starting_cb{nullptr};
     std::atomic< bool > m_init_done{false};
+    std::vector< std::pair< std::string, uint64_t > > m_start_phase_ms; // Time taken by each phase of startup
 
 public:
     HomeStore() = default;
@@ -164,6 +165,9 @@ public:
     bool is_first_time_boot() const;
     bool is_initializing() const { return !m_init_done; }
 
+    // Time taken in ms by each phase of the last start/format_and_start, in the order they were run
+    const std::vector< std::pair< std::string, uint64_t > >& start_phase_times_ms() const { return m_start_phase_ms; }
+
     // Getters
     bool has_index_service() const;
     bool has_data_service() const;
@@ -187,6 +191,7 @@ public:
     DeviceManager* device_mgr() { return m_dev_mgr.get(); }
     ResourceMgr& resource_mgr() { return *m_resource_mgr.get(); }
     CPManager& cp_mgr() { return *m_cp_mgr.get(); }
+    HomeStoreStatusMgr* status_mgr() { return m_status_mgr.get(); }
     shared< sisl::Evictor > evictor() { return m_evictor; }
 
 #ifdef _PRERELEASE
@@ -200,6 +205,7 @@ private:
     shared< VirtualDev > create_vdev_cb(const vdev_info& vinfo, bool load_existing);
     uint64_t pct_to_size(float pct, HSDevType dev_type) const;
     void do_start();
+    void run_start_phase(const std::string& name, const std::function< void() >& fn);
 };
 
 static HomeStore* hs() { return HomeStore::instance(); }
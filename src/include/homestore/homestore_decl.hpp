@@ -105,7 +105,8 @@ ENUM(chunk_selector_type_t, uint8_t, // What are the options to select chunk to
      CUSTOM,                         // Controlled by the upper layer
      RANDOM,                         // Pick any chunk in uniformly random fashion
      MOST_AVAILABLE_SPACE,           // Pick the most available space
-     ALWAYS_CALLER_CONTROLLED        // Expect the caller to always provide the specific chunkid
+     ALWAYS_CALLER_CONTROLLED,       // Expect the caller to always provide the specific chunkid
+     LOAD_AWARE                      // Pick the least loaded device and a chunk with most free space in it
 );
 
 ENUM(vdev_size_type_t, uint8_t, VDEV_SIZE_STATIC, VDEV_SIZE_DYNAMIC);
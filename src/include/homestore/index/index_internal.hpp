@@ -96,8 +96,9 @@ public:
     virtual void repair_root_node(IndexBufferPtr const& buf) = 0;
     virtual void delete_stale_children(IndexBufferPtr const& buf) = 0;
     virtual void audit_tree() const = 0;
-    virtual void update_sb() = 0;
+    virtual folly::Future< bool > update_sb() = 0;
     virtual void load_metrics(uint64_t interior, uint64_t leaf, uint8_t depth) = 0;
+    virtual nlohmann::json get_status(int log_level) const = 0;
     virtual bool sanity_check(const IndexBufferPtrList& bufs) const = 0;
 };
 
@@ -169,6 +170,7 @@ struct MetaIndexBuffer : public IndexBuffer {
 
     bool m_valid{true};
     superblk< index_table_sb >& m_sb;
+    uint32_t m_buf_size{0}; // Size of the copy of sb in m_bytes
 };
 
 struct IndexBtreeNode : public BtreeNode {
@@ -149,6 +149,12 @@ public:
     uuid_t uuid() const override { return m_sb->uuid; }
     uint32_t ordinal() const override { return m_sb->ordinal; }
     uint64_t used_size() const override { return m_sb->index_size; }
+
+    nlohmann::json get_status(int log_level) const override {
+        auto j = Btree< K, V >::get_status(log_level);
+        j["ordinal"] = ordinal();
+        return j;
+    }
     superblk< index_table_sb >& mutable_super_blk() { return m_sb; }
     const superblk< index_table_sb >& mutable_super_blk() const { return m_sb; }
     std::string btree_store_type() const override { return "INDEX_BTREE"; }
@@ -347,13 +353,16 @@ protected:
 
     btree_status_t read_node_impl(bnodeid_t id, BtreeNodePtr& node) const override {
         try {
-            wb_cache().read_buf(id, node, [this](const IndexBufferPtr& idx_buf) mutable -> BtreeNodePtr {
+            bool cache_miss{false};
+            wb_cache().read_buf(id, node, [this, &cache_miss](const IndexBufferPtr& idx_buf) mutable -> BtreeNodePtr {
+                cache_miss = true; // Node is initialized only when the buffer is read from the device
                 bool is_leaf = BtreeNode::identify_leaf_node(idx_buf->raw_buffer());
                 BtreeNode* n = this->init_node(idx_buf->raw_buffer(), idx_buf->blkid().to_integer(),
                                                false /* init_buf */, is_leaf);
                 static_cast< IndexBtreeNode* >(n)->attach_buf(idx_buf);
                 return BtreeNodePtr{n};
             });
+            COUNTER_INCREMENT_IF_ELSE(this->m_metrics, cache_miss, btree_cache_misses, btree_cache_hits, 1);
             return btree_status_t::success;
         } catch (std::exception& e) { return btree_status_t::node_read_failed; }
     }
@@ -391,15 +400,15 @@ protected:
         return btree_status_t::success;
     }
 
-    void update_sb() override {
+    folly::Future< bool > update_sb() override {
         if (!this->m_sb_buffer || !this->m_sb_buffer->m_valid) {
             LOGERROR("Attempting to update superblk when it is already invalid");
-            return;
+            return folly::makeFuture< bool >(false);
         }
         m_sb->total_interior_nodes = this->m_total_interior_nodes;
         m_sb->total_leaf_nodes = this->m_total_leaf_nodes;
         m_sb->btree_depth = this->m_btree_depth;
-        m_sb.write();
+        return m_sb.async_write();
     }
 
     void load_metrics(uint64_t interior, uint64_t leaf, uint8_t depth) override {
@@ -82,7 +82,7 @@ public:
     bool remove_index_table(const std::shared_ptr< IndexTableBase >& tbl);
     std::shared_ptr< IndexTableBase > get_index_table(uuid_t uuid) const;
     std::shared_ptr< IndexTableBase > get_index_table(uint32_t ordinal) const;
-    void write_sb(uint32_t ordinal);
+    folly::Future< bool > write_sb(uint32_t ordinal);
     bool sanity_check(const uint32_t index_ordinal, const IndexBufferPtrList& bufs) const;
 
     // Reserve/unreserve an ordinal for the index table
@@ -93,6 +93,9 @@ public:
     uint64_t used_size() const;
     uint32_t node_size() const;
 
+    // Status of all the index tables, keyed by their ordinal
+    nlohmann::json get_status(int log_level) const;
+
     // the following methods are used wb_cache , which will not used by upper layer. so graceful shutdown just skips
     // them for now.
     void repair_index_node(uint32_t ordinal, IndexBufferPtr const& node_buf);
@@ -0,0 +1,103 @@
+/*********************************************************************************
+ * Modifications Copyright 2017-2019 eBay Inc.
+ *
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *    https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed
+ * under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ *
+ *********************************************************************************/
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <sisl/utility/enum.hpp>
+#include <nlohmann/json.hpp>
+
+namespace homestore {
+using trace_id_t = uint64_t;
+
+// Stage boundaries of a replicated write, in the order a write goes through them. A follower doesn't see
+// repl_write_start, so its breakdown starts at the data write.
+VENUM(io_trace_stage_t, uint8_t,
+      repl_write_start = 0,   // async_alloc_write accepted the write
+      data_write_submit = 1,  // Data write handed to BlkDataService
+      vdev_write_submit = 2,  // VirtualDev resolved a blkid piece to its device offset
+      drive_write_submit = 3, // PhysicalDev submitted the io to the drive
+      drive_write_done = 4,   // Drive completed the io
+      data_write_done = 5,    // Data of the write is on the drive
+      journal_append = 6,     // Raft log entry appended to the log store
+      journal_flushed = 7,    // LogDev flushed the batch with the log entry
+      commit = 8              // State machine committed the write
+);
+
+struct io_trace_event {
+    trace_id_t trace_id;
+    uint64_t time_ns; // steady clock
+    io_trace_stage_t stage;
+    uint32_t thread_num; // Ring the event was recorded in, in the order the threads first recorded an event
+};
+
+/// @brief Sampled tracing of the stages of a write across the services and devices it goes through.
+///
+/// Whether a write is traced is decided by a hash of its trace id, one in generic.io_trace_sample_every, so that every
+/// layer (and every replica) makes the same decision without passing a flag around. Layers which don't know the trace
+/// id (BlkDataService, VirtualDev, PhysicalDev) record against the trace id set by an io_trace_scope on the submitting
+/// thread, and carry it to their completion.
+///
+/// Each thread (so each reactor) records into its own fixed size ring, overwriting its oldest events. Only the owning
+/// thread writes to a ring, and a reader (dump) validates each event against its sequence number, so neither of them
+/// takes a lock or waits on the other.
+class IOTrace {
+public:
+    static constexpr uint32_t ring_size{4096};
+
+    static bool sampled(trace_id_t tid);
+    static void record(trace_id_t tid, io_trace_stage_t stage) {
+        if (sampled(tid)) { record_sampled(tid, stage); }
+    }
+
+    // Trace id set by the io_trace_scope on this thread, 0 if the io being submitted is not traced
+    static trace_id_t current() { return t_current; }
+    static void record_current(io_trace_stage_t stage) {
+        if (t_current != 0) { record_sampled(t_current, stage); }
+    }
+    static void record_sampled(trace_id_t tid, io_trace_stage_t stage);
+
+    // Snapshot of the events of all the rings, ordered by time
+    static std::vector< io_trace_event > dump();
+    static bool dump_to_file(const std::string& path);
+    static std::vector< io_trace_event > load_from_file(const std::string& path);
+
+    // Latency percentiles of each stage, measured from the previous stage the trace has an event for, and of the
+    // whole trace. log_level 1 and above also lists the stages of the slowest traces.
+    static nlohmann::json breakdown(std::vector< io_trace_event > const& events, int log_level = 0);
+    static nlohmann::json get_status(int log_level) { return breakdown(dump(), log_level); }
+
+private:
+    friend class io_trace_scope;
+    static thread_local trace_id_t t_current;
+};
+
+/// @brief Sets the trace id the lower layers record against, for the ios submitted by this thread in the scope.
+class io_trace_scope {
+public:
+    explicit io_trace_scope(trace_id_t tid) : m_prev{IOTrace::t_current} {
+        IOTrace::t_current = IOTrace::sampled(tid) ? tid : 0;
+    }
+    io_trace_scope(const io_trace_scope&) = delete;
+    io_trace_scope& operator=(const io_trace_scope&) = delete;
+    ~io_trace_scope() { IOTrace::t_current = m_prev; }
+
+private:
+    trace_id_t m_prev;
+};
+} // namespace homestore
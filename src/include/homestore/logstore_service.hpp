@@ -177,6 +177,13 @@ public:
 
     void delete_unopened_logdevs();
 
+    /**
+     * @brief Time taken by start() to load and replay all logdevs and the given logdev respectively. Logdevs are
+     * replayed in parallel, so the total could be much smaller than the sum of per logdev times.
+     */
+    uint64_t start_time_ms() const { return m_start_ms; }
+    uint64_t logdev_start_time_ms(logdev_id_t logdev_id) const;
+
 private:
     std::shared_ptr< LogDev > create_new_logdev_internal(logdev_id_t logdev_id, flush_mode_t flush_mode,
                                                          uuid_t pid = boost::uuids::nil_uuid());
@@ -196,6 +203,8 @@ private:
     LogStoreServiceMetrics m_metrics;
     std::unordered_set< logdev_id_t > m_unopened_logdev;
     superblk< logstore_service_super_block > m_sb;
+    std::unordered_map< logdev_id_t, uint64_t > m_logdev_start_ms;
+    uint64_t m_start_ms{0};
 
 private:
     // graceful shutdown related
@@ -15,6 +15,7 @@
  *********************************************************************************/
 #pragma once
 
+#include <condition_variable>
 #include <cstdint>
 #include <functional>
 #include <map>
@@ -23,11 +24,14 @@
 #include <mutex>
 #include <string>
 #include <system_error>
+#include <thread>
 #include <vector>
 #include <optional>
 
+#include <folly/futures/Future.h>
 #include <sisl/fds/buffer.hpp>
 #include <sisl/metrics/metrics.hpp>
+#include <iomgr/fiber_lib.hpp>
 #include <nlohmann/json.hpp>
 #include <homestore/homestore_decl.hpp>
 
@@ -42,6 +46,7 @@ struct MetaSubRegInfo;
 struct BlkId;
 class VirtualDev;
 struct vdev_info;
+struct meta_write_batch;
 
 // each subsystem could receive callbacks multiple times
 // NOTE: look at this prototype some other time for const correctness and efficiency
@@ -54,6 +59,14 @@ typedef std::map< uint64_t, meta_blk* > meta_blk_map_t;                 // blkid
 typedef std::map< uint64_t, meta_blk_ovf_hdr* > ovf_hdr_map_t;          // ovf_blkid to ovf_blk_hdr map;
 typedef std::map< meta_sub_type, MetaSubRegInfo > client_info_map_t;    // client information map;
 typedef std::unordered_map< meta_sub_type, std::vector< meta_sub_type > > subtype_graph_t;
+typedef std::unordered_map< uint64_t, uint8_t* > prefetch_buf_map_t; // blkid to prefetched blk buffer;
+
+// one entry of async_update_sub_sbs
+struct sub_sb_update_t {
+    const uint8_t* context_data;
+    uint64_t sz;
+    void* cookie;
+};
 
 class MetablkMetrics : public sisl::MetricsGroupWrapper {
 public:
@@ -64,6 +77,17 @@ public:
 
         REGISTER_HISTOGRAM(compress_ratio_percent, "compression ration percentage",
                            HistogramBucketsType(PercentileBuckets));
+
+        REGISTER_COUNTER(scan_prefetched_blks, "meta blks read in parallel with meta blk directory during scan");
+        REGISTER_COUNTER(scan_sync_read_blks, "meta blks read synchronously while walking the chain during scan");
+        REGISTER_GAUGE(scan_time_ms, "time taken to scan and load meta blks on last startup");
+
+        REGISTER_COUNTER(async_update_cnt, "sub sb updates requested through async update api");
+        REGISTER_COUNTER(async_update_coalesced_cnt, "async sub sb updates superseded by a later update of same sb");
+        REGISTER_HISTOGRAM(async_update_batch_size, "number of sub sbs written in one async update pass",
+                           HistogramBucketsType(SteppedUpto32Buckets));
+        REGISTER_HISTOGRAM(async_update_latency_us, "latency of one async update pass",
+                           HistogramBucketsType(OpLatecyBuckets));
         register_me_to_farm();
     }
 
@@ -93,6 +117,24 @@ private:
     bool m_inited{false};
     std::unique_ptr< meta_vdev_context > m_meta_vdev_context;
     subtype_graph_t m_dep_topo_graph;
+    std::vector< BlkId > m_dir_blks;           // blks of on-disk meta blk directory chain;
+    std::vector< uint64_t > m_dir_listed_bids; // sorted blkids listed in on-disk meta blk directory;
+    bool m_dir_valid{false};                   // whether on-disk meta blk directory was found to be valid;
+
+    // Updates of sub sbs are serialized per type and they share the lock below, while add/remove which modify the
+    // linkage of neighbouring meta blks take it exclusively.
+    iomgr::FiberManagerLib::shared_mutex m_sb_update_rwlock;
+    std::map< meta_sub_type, std::unique_ptr< iomgr::FiberManagerLib::mutex > > m_sub_update_mtx;
+
+    struct pending_sb_update {
+        sisl::io_blob_safe buf; // copy of latest context data of the sb
+        std::vector< folly::Promise< bool > > promises;
+    };
+    std::mutex m_async_update_mtx;
+    std::condition_variable m_async_update_cv;
+    std::map< void*, pending_sb_update > m_pending_sb_updates; // cookie to pending update, written in next pass
+    std::thread m_async_update_thread;
+    bool m_async_update_stop{false};
 
 public:
     MetaBlkService(const char* name = "MetaBlkStore");
@@ -125,9 +167,12 @@ public:
      * @brief : Register subsystem callbacks
      * @param type : subsystem type
      * @param cb : subsystem cb
+     * @param concurrent_recovery : cb doesn't share any state with other subsystems, so on recovery it can be called
+     * from a different thread and in parallel to the callbacks of other such subsystems. Ignored if deps are provided
      */
     void register_handler(meta_sub_type type, const meta_blk_found_cb_t& cb, const meta_blk_recover_comp_cb_t& comp_cb,
-                          bool do_crc = true, std::optional< meta_subtype_vec_t > deps = std::nullopt);
+                          bool do_crc = true, std::optional< meta_subtype_vec_t > deps = std::nullopt,
+                          bool concurrent_recovery = false);
 
     /**
      * @brief
@@ -167,6 +212,20 @@ public:
      */
     void update_sub_sb(const uint8_t* context_data, uint64_t sz, void* cookie);
 
+    /**
+     * @brief : update a batch of metablks in-place asynchronously. context_data is copied, so caller is free to reuse
+     * it once the call returns. Updates requested while a previous pass is being written are coalesced (latest content
+     * of a sb wins) and written in one pass, where ovf blks of all the sbs are written in parallel followed by all
+     * the meta blks.
+     *
+     * @param updates : list of context_data, sz and cookie of the sbs to be updated;
+     *
+     * @return : future which is set to true once all the sbs are persisted, false if any of the update is dropped
+     *           because either the sb is removed or the service is stopped, or if writing it to disk failed;
+     */
+    folly::Future< bool > async_update_sub_sbs(const std::vector< sub_sb_update_t >& updates);
+    folly::Future< bool > async_update_sub_sb(const uint8_t* context_data, uint64_t sz, void* cookie);
+
     // size_t read_sub_sb(const meta_sub_type type, sisl::byte_view& buf);
     void read_sub_sb(meta_sub_type type);
 
@@ -242,10 +301,10 @@ private:
      *
      * @return
      */
-    void write_meta_blk_to_disk(meta_blk* mblk);
+    void write_meta_blk_to_disk(meta_blk* mblk, meta_write_batch* batch = nullptr);
 
     void write_ovf_blk_to_disk(meta_blk_ovf_hdr* ovf_hdr, const uint8_t* context_data, uint64_t sz, uint64_t offset,
-                               const std::string& type);
+                               const std::string& type, meta_write_batch* batch = nullptr);
 
     /**
      * @brief : load meta blk super super block into memory
@@ -302,7 +361,8 @@ private:
      * @param sz
      * @param offset
      */
-    void write_meta_blk_ovf(BlkId& bid, const uint8_t* context_data, uint64_t sz, const std::string& type);
+    void write_meta_blk_ovf(BlkId& bid, const uint8_t* context_data, uint64_t sz, const std::string& type,
+                            meta_write_batch* batch = nullptr);
 
     /**
      * @brief : internal implementation of populating and writing a meta block;
@@ -310,8 +370,27 @@ private:
      * @param mblk
      * @param context_data
      * @param sz
+     * @param batch : if not null, blks are not written but staged in the batch, to be written by write_batch;
+     */
+    void write_meta_blk_internal(meta_blk* mblk, const uint8_t* context_data, uint64_t sz,
+                                 meta_write_batch* batch = nullptr);
+
+    /**
+     * @brief : populate the in-memory meta blk with new context data and write (or stage it in batch);
+     * m_meta_mtx should be held while calling this function;
      */
-    void write_meta_blk_internal(meta_blk* mblk, const uint8_t* context_data, uint64_t sz);
+    void update_meta_blk(meta_blk* mblk, const uint8_t* context_data, uint64_t sz, meta_write_batch* batch);
+
+    /**
+     * @brief : write all the staged blks of the batch in parallel, ovf blks first and then meta blks;
+     * @return : false if any of the writes failed, meta blks are not written if any ovf blk write failed;
+     */
+    bool write_batch(meta_write_batch& batch);
+
+    void async_update_thread();
+    bool write_pending_sb_updates(std::map< void*, pending_sb_update >& updates, size_t ntypes);
+    std::vector< folly::Promise< bool > > take_pending_sb_update(void* cookie);
+    iomgr::FiberManagerLib::mutex& sub_update_mtx(const meta_sub_type& type);
 
     /**
      * @brief : sync read;
@@ -360,8 +439,41 @@ private:
 
     bool ssb_sanity_check() const;
 
+    /**
+     * @brief : Walk the on-disk meta blk chain and load all the meta blks and ovf hdr blks into memory;
+     *
+     * @param prefetched : if not null, blks found in this map are consumed from it instead of reading from disk;
+     */
     bool scan_and_load_meta_blks(meta_blk_map_t& meta_blks, ovf_hdr_map_t& ovf_blk_hdrs, BlkId* last_mblk_id,
-                                 client_info_map_t& sub_info);
+                                 client_info_map_t& sub_info, prefetch_buf_map_t* prefetched = nullptr);
+
+    /**
+     * @brief : Read one blk during scan, either taking it over from prefetched map or reading it synchronously.
+     * Returned buffer is owned by the caller;
+     */
+    uint8_t* read_scan_blk(const BlkId& bid, prefetch_buf_map_t* prefetched);
+
+    /**
+     * @brief : Load the meta blk directory chain pointed by ssb and commit its blks;
+     *
+     * @return : blkids of meta blks and ovf hdr blks listed in directory, empty if there is no valid directory;
+     */
+    std::vector< BlkId > load_meta_blk_dir();
+
+    /**
+     * @brief : Read the given blks in parallel, bounded by metablk.scan_parallel_reads outstanding reads. Blks which
+     * failed to read are not part of returned map;
+     */
+    prefetch_buf_map_t prefetch_meta_blks(const std::vector< BlkId >& bids);
+
+    /**
+     * @brief : Persist the blkids of all in-memory meta blks and ovf hdr blks to meta blk directory chain, so that
+     * next startup can prefetch them in parallel. m_meta_mtx should be held while calling this function;
+     */
+    void write_meta_blk_dir();
+    bool is_meta_blk_dir_stale() const;
+    std::vector< uint64_t > meta_blk_dir_bids() const;
+    uint64_t dir_blk_max_num_bids() const;
 
     void recover_meta_block(meta_blk* meta_block);
     void recover_meta_sub_type(bool do_comp_cb, const meta_sub_type&);
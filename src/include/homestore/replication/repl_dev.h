@@ -118,6 +118,18 @@ struct snp_repl_dev_data {
     uint64_t dsn{0};
 };
 
+// Completion of the data writes of a batch of requests, signalled once when the last of them is written. The waiter
+// holds one count of its own till it is done adding the requests, so that the batch isn't signalled midway.
+struct repl_req_batch_waiter {
+    std::atomic< uint32_t > m_pending{1};
+    folly::Promise< folly::Unit > m_done_promise;
+
+    void add_one() { m_pending.fetch_add(1, std::memory_order_relaxed); }
+    void complete_one() {
+        if (m_pending.fetch_sub(1, std::memory_order_acq_rel) == 1) { m_done_promise.setValue(); }
+    }
+};
+
 struct repl_journal_entry;
 struct repl_req_ctx : public boost::intrusive_ref_counter< repl_req_ctx, boost::thread_safe_counter >,
                       sisl::ObjLifeCounter< repl_req_ctx > {
@@ -203,9 +215,11 @@ public:
     /// @param pushed_data Data that was received from the RPC. This is used to keep the data alive
     /// @param data Data pointer
     /// @param data_size Size of the data
+    /// @param respond_on_release Whether to send the rpc response upon release_data. It is false when the rpc carries
+    /// data of multiple requests, in which case the caller responds once all of them are written
     /// @return true if the request didn't receive the data already, false otherwise
     bool save_pushed_data(intrusive< sisl::GenericRpcData > const& pushed_data, uint8_t const* data,
-                          uint32_t data_size);
+                          uint32_t data_size, bool respond_on_release = true);
 
     /// @brief Save the data that was fetched from the remote node for this request. When a fetch data rpc is called
     /// with the data, this method is called to save them to the request and make it shareable. This method makes a copy
@@ -222,6 +236,14 @@ public:
     void set_lsn(int64_t lsn);
     void add_state(repl_req_state_t s);
     bool add_state_if_not_already(repl_req_state_t s);
+
+    /// @brief Mark the data of this request written, fulfilling m_data_written_promise and completing its share of the
+    /// batch waiter, if one is added
+    void set_data_written();
+
+    /// @brief Add this request to the batch whose completion is signalled once all of its requests' data is written
+    /// @return false if the data is already written, in which case the waiter is not added
+    bool add_data_written_waiter(shared< repl_req_batch_waiter > const& waiter);
     void set_lentry(nuraft::ptr< nuraft::log_entry > const& lentry) { m_lentry = lentry; }
     void clear();
     void release_data();
@@ -263,11 +285,13 @@ private:
 
     /////////////// Replication state related section /////////////////
     std::atomic< uint32_t > m_state{uint32_cast(repl_req_state_t::INIT)}; // State of the replication request
+    shared< repl_req_batch_waiter > m_data_written_waiter; // Batch waiting on the data write, under m_state_mtx
 
     /////////////// Communication packet/builder section /////////////////
     flatbuffers::FlatBufferBuilder m_fb_builder;
     sisl::io_blob_safe m_buf_for_unaligned_data;
     intrusive< sisl::GenericRpcData > m_pushed_data;
+    bool m_respond_pushed_data{true};
     sisl::GenericClientResponse m_fetched_data;
     bool m_enable_push_data{true};
 };
@@ -115,6 +115,16 @@ public:
         }
     }
 
+    // Same as write(), except that an existing superblk is updated asynchronously and possibly along with other
+    // superblks in one pass. Buffer is copied, so superblk can be modified again right after this call.
+    folly::Future< bool > async_write() {
+        if (m_meta_blk) {
+            return meta_service().async_update_sub_sb(m_raw_buf->cbytes(), m_raw_buf->size(), m_meta_blk);
+        }
+        meta_service().add_sub_sb(m_meta_sub_name, m_raw_buf->cbytes(), m_raw_buf->size(), m_meta_blk);
+        return folly::makeFuture< bool >(true);
+    }
+
     bool is_empty() const { return (m_sb == nullptr); }
     T* get() { return m_sb; }
     T* operator->() { return m_sb; }
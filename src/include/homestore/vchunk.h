@@ -21,6 +21,17 @@
 namespace homestore {
 class Chunk;
 
+// IO done on a chunk since it was loaded. Latencies are the sums over all the ios, the average is latency / count.
+struct chunk_io_stats {
+    uint64_t reads{0};
+    uint64_t writes{0};
+    uint64_t read_bytes{0};
+    uint64_t write_bytes{0};
+    uint64_t read_latency_us{0};
+    uint64_t write_latency_us{0};
+    uint64_t heat_iops{0}; // Moving average of the recent read+write iops, to tell hot chunks apart
+};
+
 class VChunk {
 public:
     VChunk(cshared< Chunk > const&);
@@ -38,6 +49,7 @@ public:
     uint16_t get_chunk_id() const;
     cshared< Chunk > get_internal_chunk() const;
     uint64_t size() const;
+    chunk_io_stats get_io_stats() const;
     void reset();
 
 private:
@@ -27,7 +27,7 @@ AppendBlkAllocator::AppendBlkAllocator(const BlkAllocConfig& cfg, bool need_form
     meta_service().register_handler(
         get_name(),
         [this](meta_blk* mblk, sisl::byte_view buf, size_t size) { on_meta_blk_found(std::move(buf), (void*)mblk); },
-        nullptr);
+        nullptr, true /* do_crc */, std::nullopt, true /* concurrent_recovery */);
 
     if (need_format) {
         m_freeable_nblks = 0;
@@ -28,7 +28,7 @@ BitmapBlkAllocator::BitmapBlkAllocator(BlkAllocConfig const& cfg, bool is_fresh,
             [this](meta_blk* mblk, sisl::byte_view buf, size_t size) {
                 on_meta_blk_found(voidptr_cast(mblk), std::move(buf), size);
             },
-            nullptr);
+            nullptr, true /* do_crc */, std::nullopt, true /* concurrent_recovery */);
     }
 
     if (is_fresh) {
@@ -46,7 +46,18 @@ BitmapBlkAllocator::BitmapBlkAllocator(BlkAllocConfig const& cfg, bool is_fresh,
 
 void BitmapBlkAllocator::on_meta_blk_found(void* mblk_cookie, sisl::byte_view const& buf, size_t size) {
     m_meta_blk_cookie = mblk_cookie;
+    if (HS_DYNAMIC_CONFIG(blkallocator.lazy_bitmap_load)) {
+        // Hold on to the persisted bitmap and build the in-memory structures from it on first use of this allocator
+        // or by the background loader, whichever is earlier.
+        m_pending_bm_buf = buf;
+        m_pending_bm_size = size;
+        m_load_pending.store(true, std::memory_order_release);
+        return;
+    }
+    load_bitmap(buf, size);
+}
 
+void BitmapBlkAllocator::load_bitmap(sisl::byte_view const& buf, size_t size) {
     m_disk_bm = std::unique_ptr< sisl::Bitset >{new sisl::Bitset{
         hs_utils::extract_byte_array(buf, meta_service().is_aligned_buf_needed(size), meta_service().align_size())}};
 
@@ -54,9 +65,25 @@ void BitmapBlkAllocator::on_meta_blk_found(void* mblk_cookie, sisl::byte_view co
     load();
 }
 
+void BitmapBlkAllocator::ensure_loaded() const {
+    if (!m_load_pending.load(std::memory_order_acquire)) { return; }
+
+    // Any other user of this allocator waits here till the load is completed
+    std::call_once(m_load_once, [this]() {
+        auto self = const_cast< BitmapBlkAllocator* >(this);
+        self->load_bitmap(m_pending_bm_buf, m_pending_bm_size);
+        self->m_pending_bm_buf = sisl::byte_view{};
+        m_load_pending.store(false, std::memory_order_release);
+        BLKALLOC_LOG(DEBUG, "Lazily loaded bitmap of chunk={} used blks={}", m_chunk_id, get_alloced_blk_count());
+    });
+}
+
 void BitmapBlkAllocator::cp_flush(CP*) {
     if (!is_persistent()) { return; }
 
+    // Nothing could have changed in the bitmap of an allocator which is not loaded yet
+    if (m_load_pending.load(std::memory_order_acquire)) { return; }
+
     if (m_is_disk_bm_dirty.load()) {
         sisl::byte_array bitmap_buf = acquire_underlying_buffer();
         if (m_meta_blk_cookie) {
@@ -72,6 +99,7 @@ void BitmapBlkAllocator::cp_flush(CP*) {
 bool BitmapBlkAllocator::is_blk_alloced_on_disk(const BlkId& b, bool use_lock) const {
     // for non-persistent bitmap nothing to compare. So always return true
     if (!is_persistent()) { return true; }
+    ensure_loaded();
 
     if (use_lock) {
         const BlkAllocPortion& portion = blknum_to_portion_const(b.blk_num());
@@ -87,6 +115,7 @@ BlkAllocStatus BitmapBlkAllocator::reserve_on_disk(BlkId const& bid) {
         // for non-persistent bitmap nothing is needed to do. So always return success
         return BlkAllocStatus::SUCCESS;
     }
+    ensure_loaded();
 
     rcu_read_lock();
     auto list = get_alloc_blk_list();
@@ -129,6 +158,7 @@ BlkAllocStatus BitmapBlkAllocator::reserve_on_disk(BlkId const& bid) {
 void BitmapBlkAllocator::free_on_disk(BlkId const& bid) {
     // this api should be called only on persistent blk allocator
     DEBUG_ASSERT_EQ(is_persistent(), true, "free_on_disk called for non-persistent blk allocator");
+    ensure_loaded();
 
     auto unset_on_disk_bm = [this](auto& b) {
         BlkAllocPortion& portion = blknum_to_portion(b.blk_num());
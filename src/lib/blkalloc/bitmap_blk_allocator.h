@@ -72,6 +72,8 @@ public:
     virtual ~BitmapBlkAllocator() = default;
 
     virtual void load() = 0;
+    void ensure_loaded() const override;
+    bool is_loaded() const override { return !m_load_pending.load(std::memory_order_acquire); }
     BlkAllocStatus reserve_on_disk(BlkId const& in_bid) override;
     bool is_blk_alloced_on_disk(BlkId const& b, bool use_lock = false) const override;
     void cp_flush(CP* cp) override;
@@ -108,6 +110,7 @@ private:
     void do_init();
     sisl::ThreadVector< MultiBlkId >* get_alloc_blk_list();
     void on_meta_blk_found(void* mblk_cookie, sisl::byte_view const& buf, size_t size);
+    void load_bitmap(sisl::byte_view const& buf, size_t size);
 
     // Acquire the underlying bitmap buffer and while the caller has acquired, all the new allocations
     // will be captured in a separate list and then pushes into buffer once released.
@@ -126,5 +129,11 @@ private:
     std::atomic< bool > m_is_disk_bm_dirty{true}; // initially disk_bm treated as dirty
     void* m_meta_blk_cookie{nullptr};
     std::atomic< int64_t > m_alloced_blk_count{0};
+
+    // Lazy load of persisted bitmap (blkallocator.lazy_bitmap_load)
+    mutable std::once_flag m_load_once;
+    mutable std::atomic< bool > m_load_pending{false};
+    sisl::byte_view m_pending_bm_buf;
+    size_t m_pending_bm_size{0};
 };
 } // namespace homestore
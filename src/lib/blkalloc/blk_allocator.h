@@ -162,6 +162,11 @@ public:
     virtual bool is_blk_alloced(BlkId const& b, bool use_lock = false) const = 0;
     virtual bool is_blk_alloced_on_disk(BlkId const& b, bool use_lock = false) const = 0;
     virtual void recovery_completed() = 0;
+
+    // Allocators which build their in-memory state lazily (see blkallocator.lazy_bitmap_load) do it on first use. This
+    // can be called to load ahead of it, e.g. from a background thread.
+    virtual void ensure_loaded() const {}
+    virtual bool is_loaded() const { return true; }
     virtual void reset() = 0;
 
     virtual std::string to_string() const = 0;
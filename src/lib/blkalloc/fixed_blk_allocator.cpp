@@ -53,6 +53,7 @@ blk_num_t FixedBlkAllocator::init_portion(BlkAllocPortion& portion, blk_num_t st
 bool FixedBlkAllocator::is_blk_alloced(BlkId const& b, bool use_lock) const { return true; }
 
 BlkAllocStatus FixedBlkAllocator::alloc([[maybe_unused]] blk_count_t nblks, blk_alloc_hints const&, BlkId& out_blkid) {
+    ensure_loaded();
 #ifdef _PRERELEASE
     if (iomgr_flip::instance()->test_flip("fixed_blkalloc_no_blks")) { return BlkAllocStatus::SPACE_FULL; }
 #endif
@@ -83,6 +84,7 @@ BlkAllocStatus FixedBlkAllocator::reserve_on_cache(BlkId const& b) {
 }
 
 void FixedBlkAllocator::recovery_completed() {
+    ensure_loaded();
     std::lock_guard lg(m_reserve_blk_mtx);
     if (!m_reserved_blks.empty()) {
         auto const count = available_blks();
@@ -101,6 +103,7 @@ void FixedBlkAllocator::recovery_completed() {
 }
 
 void FixedBlkAllocator::free(BlkId const& b) {
+    ensure_loaded();
     HS_DBG_ASSERT_EQ(b.blk_count(), 1, "Multiple blk free for FixedBlkAllocator? allocated by different allocator?");
 
     const auto pushed = m_free_blk_q.write(b.blk_num());
@@ -116,7 +119,10 @@ void FixedBlkAllocator::free(BlkId const& b) {
     if (is_persistent()) { free_on_disk(b); }
 }
 
-blk_num_t FixedBlkAllocator::available_blks() const { return m_free_blk_q.sizeGuess(); }
+blk_num_t FixedBlkAllocator::available_blks() const {
+    ensure_loaded();
+    return m_free_blk_q.sizeGuess();
+}
 
 blk_num_t FixedBlkAllocator::get_defrag_nblks() const {
     // TODO: implement this
@@ -396,6 +396,7 @@ BlkAllocStatus VarsizeBlkAllocator::alloc_contiguous(blk_count_t nblks, blk_allo
 }
 
 BlkAllocStatus VarsizeBlkAllocator::alloc(blk_count_t nblks, blk_alloc_hints const& hints, BlkId& out_blkid) {
+    ensure_loaded();
     bool use_slabs = m_cfg.m_use_slabs;
 
 #ifdef _PRERELEASE
@@ -450,6 +451,7 @@ out:
 
 BlkAllocStatus VarsizeBlkAllocator::alloc(blk_count_t nblks, blk_alloc_hints const& hints,
                                           std::vector< BlkId >& out_blkids) {
+    ensure_loaded();
     // Regular alloc blks will allocate in MultiBlkId, but there is an upper limit on how many it can accomodate in a
     // single MultiBlkId, if caller is ok to generate multiple MultiBlkids, this method is called.
     auto h = hints;
@@ -639,6 +641,7 @@ blk_count_t VarsizeBlkAllocator::alloc_blks_direct(blk_count_t nblks, blk_alloc_
 // since this function will only be called during HS recovery, we can safe to update the cache bitmap directly without
 // touching the slab caches.
 BlkAllocStatus VarsizeBlkAllocator::reserve_on_cache(BlkId const& bid) {
+    ensure_loaded();
     BlkAllocPortion& portion = blknum_to_portion(bid.blk_num());
     {
         auto lock{portion.portion_auto_lock()};
@@ -658,6 +661,7 @@ BlkAllocStatus VarsizeBlkAllocator::reserve_on_cache(BlkId const& bid) {
 }
 
 void VarsizeBlkAllocator::free(BlkId const& bid) {
+    ensure_loaded();
     if (is_persistent()) { free_on_disk(bid); }
     blk_count_t n_freed = (m_cfg.m_use_slabs && (bid.blk_count() <= m_cfg.highest_slab_blks_count()))
         ? free_blks_slab(r_cast< MultiBlkId const& >(bid))
@@ -725,6 +729,7 @@ blk_count_t VarsizeBlkAllocator::free_blks_direct(MultiBlkId const& bid) {
 }
 
 bool VarsizeBlkAllocator::is_blk_alloced(BlkId const& bid, bool use_lock) const {
+    ensure_loaded();
     auto check_bits_set = [this](BlkId const& b, bool use_lock) {
         if (use_lock) {
             BlkAllocPortion const& portion = blknum_to_portion_const(b.blk_num());
@@ -757,7 +762,10 @@ blk_num_t VarsizeBlkAllocator::get_defrag_nblks() const {
     return 0;
 }
 
-blk_num_t VarsizeBlkAllocator::get_used_blks() const { return get_alloced_blk_count(); }
+blk_num_t VarsizeBlkAllocator::get_used_blks() const {
+    ensure_loaded();
+    return get_alloced_blk_count();
+}
 
 #ifdef _PRERELEASE
 void VarsizeBlkAllocator::alloc_sanity_check(blk_count_t nblks, blk_alloc_hints const& hints,
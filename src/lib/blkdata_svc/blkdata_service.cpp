@@ -16,6 +16,7 @@
 #include <homestore/blkdata_service.hpp>
 #include <homestore/homestore.hpp>
 #include <homestore/chunk_selector.h>
+#include <iomgr/iomgr.hpp>
 
 #include "device/chunk.h"
 #include "device/virtual_dev.hpp"
@@ -66,6 +67,11 @@ shared< VirtualDev > BlkDataService::open_vdev(const vdev_info& vinfo, bool load
     return m_vdev;
 }
 
+// Pieces of a multi piece io are queued and submitted to the drive in one go only on an io reactor, where the drive
+// interface batches the submissions. Ios issued from any other thread keep submitting each piece on its own, unless
+// the caller is batching them with more ios.
+static bool batch_pieces(bool part_of_batch) { return part_of_batch || iomanager.am_i_io_reactor(); }
+
 static auto collect_all_futures(std::vector< folly::Future< std::error_code > >& futs) {
     return folly::collectAllUnsafe(futs).thenValue([](auto&& vf) {
         for (auto const& err_c : vf) {
@@ -98,12 +104,14 @@ folly::Future< std::error_code > BlkDataService::async_read(MultiBlkId const& bl
         static thread_local std::vector< folly::Future< std::error_code > > s_futs;
         s_futs.clear();
 
+        bool const batch = batch_pieces(part_of_batch);
         auto it = blkid.iterate();
         while (auto const bid = it.next()) {
             uint32_t sz = bid->blk_count() * m_blk_size;
-            s_futs.emplace_back(do_read(*bid, buf, sz, part_of_batch));
+            s_futs.emplace_back(do_read(*bid, buf, sz, batch));
             buf += sz;
         }
+        if (batch && !part_of_batch) { m_vdev->submit_batch(); }
         decr_pending_request_num();
         return collect_all_futures(s_futs);
     }
@@ -134,11 +142,13 @@ folly::Future< std::error_code > BlkDataService::async_read(MultiBlkId const& bl
         s_futs.clear();
 
         sisl::sg_iterator sg_it{sgs.iovs};
+        bool const batch = batch_pieces(part_of_batch);
         auto blkid_it = blkid.iterate();
         while (auto const bid = blkid_it.next()) {
             uint32_t const sz = bid->blk_count() * m_blk_size;
-            s_futs.emplace_back(do_read(*bid, sg_it.next_iovs(sz), sz, part_of_batch));
+            s_futs.emplace_back(do_read(*bid, sg_it.next_iovs(sz), sz, batch));
         }
+        if (batch && !part_of_batch) { m_vdev->submit_batch(); }
         decr_pending_request_num();
         return collect_all_futures(s_futs);
     }
@@ -172,12 +182,14 @@ folly::Future< std::error_code > BlkDataService::async_write(const char* buf, ui
         s_futs.clear();
 
         const char* ptr = buf;
+        bool const batch = batch_pieces(part_of_batch);
         auto blkid_it = blkid.iterate();
         while (auto const bid = blkid_it.next()) {
             uint32_t sz = bid->blk_count() * m_blk_size;
-            s_futs.emplace_back(m_vdev->async_write(ptr, sz, *bid, part_of_batch));
+            s_futs.emplace_back(m_vdev->async_write(ptr, sz, *bid, batch));
             ptr += sz;
         }
+        if (batch && !part_of_batch) { m_vdev->submit_batch(); }
         decr_pending_request_num();
         return collect_all_futures(s_futs);
     }
@@ -199,11 +211,13 @@ folly::Future< std::error_code > BlkDataService::async_write(sisl::sg_list const
         s_futs.clear();
         sisl::sg_iterator sg_it{sgs.iovs};
 
+        bool const batch = batch_pieces(part_of_batch);
         auto blkid_it = blkid.iterate();
         while (auto const bid = blkid_it.next()) {
             const auto iovs = sg_it.next_iovs(bid->blk_count() * m_blk_size);
-            s_futs.emplace_back(m_vdev->async_writev(iovs.data(), iovs.size(), *bid, part_of_batch));
+            s_futs.emplace_back(m_vdev->async_writev(iovs.data(), iovs.size(), *bid, batch));
         }
+        if (batch && !part_of_batch) { m_vdev->submit_batch(); }
         decr_pending_request_num();
         return collect_all_futures(s_futs);
     }
@@ -216,12 +230,14 @@ BlkDataService::async_write(sisl::sg_list const& sgs, std::vector< MultiBlkId >
     static thread_local std::vector< folly::Future< std::error_code > > s_futs;
     s_futs.clear();
     sisl::sg_iterator sg_it{sgs.iovs};
+    bool const batch = batch_pieces(part_of_batch);
     for (const auto& blkid : blkids) {
         auto sgs_size = blkid.blk_count() * data_service().get_blk_size();
         const auto iovs = sg_it.next_iovs(sgs_size);
         sisl::sg_list single_sgs{sgs_size, iovs};
-        s_futs.emplace_back(async_write(single_sgs, blkid, part_of_batch));
+        s_futs.emplace_back(async_write(single_sgs, blkid, batch));
     }
+    if (batch && !part_of_batch) { m_vdev->submit_batch(); }
     decr_pending_request_num();
     return collect_all_futures(s_futs);
 }
@@ -299,10 +315,14 @@ void BlkDataService::start() {
     // Register to CP for flush dirty buffers underlying virtual device layer;
     hs()->cp_mgr().register_consumer(cp_consumer_t::BLK_DATA_SVC,
                                      std::move(std::make_unique< DataSvcCPCallbacks >(m_vdev)));
+
+    // With lazy bitmap load, allocators of chunks which were not touched during recovery are still not loaded.
+    if (HS_DYNAMIC_CONFIG(blkallocator.lazy_bitmap_load)) { m_vdev->start_blk_allocators_load(); }
 }
 
 void BlkDataService::stop() {
     start_stopping();
+    if (m_vdev) { m_vdev->stop_blk_allocators_load(); }
     // we have no way to track the completion of each async io in detail which should be done in iomanager level, so
     // we just wait for 3 seconds, and we expect each io will be completed within this time.
 
@@ -23,6 +23,11 @@ void HomeStoreStatusMgr::register_status_cb(const std::string& module, const get
     m_status_cb_map.emplace(module, get_status_cb);
 }
 
+void HomeStoreStatusMgr::deregister_status_cb(const std::string& module) {
+    std::unique_lock lock(m_mtx);
+    m_status_cb_map.erase(module);
+}
+
 nlohmann::json HomeStoreStatusMgr::get_status(const std::vector< std::string >& modules,
                                               const int verbosity_level) const {
     nlohmann::json status_json;
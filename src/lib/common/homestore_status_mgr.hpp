@@ -32,6 +32,7 @@ public:
     HomeStoreStatusMgr() = default;
 
     void register_status_cb(const std::string& module, const get_status_cb_t get_status_cb);
+    void deregister_status_cb(const std::string& module);
     nlohmann::json get_status(const std::vector< std::string >& modules, const int verbosity_level) const;
     std::vector< std::string > get_modules() const;
 
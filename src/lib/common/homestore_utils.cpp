@@ -13,6 +13,8 @@
  * specific language governing permissions and limitations under the License.
  *
  *********************************************************************************/
+#include <atomic>
+#include <thread>
 #include <boost/uuid/random_generator.hpp>
 #include "homestore_utils.hpp"
 #include "homestore_assert.hpp"
@@ -117,5 +119,24 @@ bool hs_utils::topological_sort(std::unordered_map< std::string, std::vector< st
     return ordered_entries.size() != DAG.size();
 }
 
+void hs_utils::parallel_for(size_t n, uint32_t nthreads, const std::function< void(size_t) >& fn) {
+    std::atomic< size_t > next_idx{0};
+    auto worker = [&]() {
+        for (auto i = next_idx.fetch_add(1); i < n; i = next_idx.fetch_add(1)) {
+            fn(i);
+        }
+    };
+
+    std::vector< std::thread > threads;
+    auto const nworkers = std::min(n, size_t(std::max(nthreads, 1u)));
+    for (size_t t{1}; t < nworkers; ++t) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto& t : threads) {
+        t.join();
+    }
+}
+
 size_t hs_utils::m_btree_mempool_size;
 } // namespace homestore
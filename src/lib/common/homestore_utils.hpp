@@ -52,6 +52,12 @@ public:
      */
     static bool topological_sort(std::unordered_map< std::string, std::vector< std::string > >& DAG,
                                  std::vector< std::string >& ordered_entries);
+
+    /**
+     * @brief Run fn(i) for every i in [0, n) on upto nthreads threads (including the caller) and wait for all of them
+     * to complete. Work is handed out one index at a time, so a slow item does not hold up the rest.
+     */
+    static void parallel_for(size_t n, uint32_t nthreads, const std::function< void(size_t) >& fn);
 };
 
 static bool wait_and_check(const std::function< bool() >& check_func, uint32_t timeout_ms, uint32_t interval_ms = 100);
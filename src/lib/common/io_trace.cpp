@@ -0,0 +1,241 @@
+/*********************************************************************************
+ * Modifications Copyright 2017-2019 eBay Inc.
+ *
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *    https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed
+ * under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ *
+ *********************************************************************************/
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <unordered_map>
+
+#include <homestore/io_trace.hpp>
+#include "homestore_utils.hpp"
+
+namespace homestore {
+thread_local trace_id_t IOTrace::t_current{0};
+
+namespace {
+static constexpr uint32_t num_stages{s_cast< uint32_t >(io_trace_stage_t::commit) + 1};
+
+class trace_ring {
+public:
+    explicit trace_ring(uint32_t thread_num) : m_thread_num{thread_num} {}
+
+    // Called only by the owning thread
+    void record(trace_id_t tid, io_trace_stage_t stage, uint64_t time_ns) {
+        auto const pos = m_head.load(std::memory_order_relaxed);
+        auto& ev = m_events[pos % IOTrace::ring_size];
+        // Odd sequence while the event is being overwritten, so that a reader racing with it discards it
+        ev.seq.store((2 * pos) + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        ev.trace_id.store(tid, std::memory_order_relaxed);
+        ev.time_ns.store(time_ns, std::memory_order_relaxed);
+        ev.stage.store(s_cast< uint8_t >(stage), std::memory_order_relaxed);
+        ev.seq.store((2 * pos) + 2, std::memory_order_release);
+        m_head.store(pos + 1, std::memory_order_release);
+    }
+
+    void snapshot(std::vector< io_trace_event >& out) const {
+        auto const head = m_head.load(std::memory_order_acquire);
+        auto const start = (head > IOTrace::ring_size) ? (head - IOTrace::ring_size) : 0;
+        for (auto pos = start; pos < head; ++pos) {
+            auto const& ev = m_events[pos % IOTrace::ring_size];
+            auto const seq = ev.seq.load(std::memory_order_acquire);
+            if (seq != (2 * pos) + 2) { continue; } // Being overwritten by a newer event
+            io_trace_event e{ev.trace_id.load(std::memory_order_relaxed), ev.time_ns.load(std::memory_order_relaxed),
+                             io_trace_stage_t(ev.stage.load(std::memory_order_relaxed)), m_thread_num};
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (ev.seq.load(std::memory_order_relaxed) == seq) { out.push_back(e); }
+        }
+    }
+
+private:
+    struct event {
+        std::atomic< uint64_t > seq{0};
+        std::atomic< trace_id_t > trace_id{0};
+        std::atomic< uint64_t > time_ns{0};
+        std::atomic< uint8_t > stage{0};
+    };
+
+    uint32_t const m_thread_num;
+    std::atomic< uint64_t > m_head{0};
+    std::array< event, IOTrace::ring_size > m_events;
+};
+
+// Rings are kept past the exit of their thread, so that a dump still has the events recorded by it
+struct ring_registry {
+    std::mutex mtx;
+    std::vector< std::shared_ptr< trace_ring > > rings;
+};
+
+ring_registry& registry() {
+    // Leaked on purpose, reactor threads may still be recording when static objects are torn down
+    static ring_registry* s_registry = new ring_registry();
+    return *s_registry;
+}
+
+trace_ring& thread_ring() {
+    static thread_local trace_ring* t_ring = []() {
+        auto& reg = registry();
+        std::unique_lock lg{reg.mtx};
+        reg.rings.push_back(std::make_shared< trace_ring >(uint32_cast(reg.rings.size())));
+        return reg.rings.back().get();
+    }();
+    return *t_ring;
+}
+
+uint64_t now_ns() {
+    return std::chrono::duration_cast< std::chrono::nanoseconds >(Clock::now().time_since_epoch()).count();
+}
+
+nlohmann::json percentiles_us(std::vector< uint64_t >& ns) {
+    std::sort(ns.begin(), ns.end());
+    auto const at = [&ns](double pct) { return ns[std::min(size_t(ns.size() * pct / 100), ns.size() - 1)] / 1000.0; };
+    return nlohmann::json{{"count", ns.size()},
+                          {"p50_us", at(50)},
+                          {"p99_us", at(99)},
+                          {"p999_us", at(99.9)},
+                          {"max_us", ns.back() / 1000.0}};
+}
+} // namespace
+
+bool IOTrace::sampled(trace_id_t tid) {
+    auto const every = HS_DYNAMIC_CONFIG(generic.io_trace_sample_every);
+    if ((tid == 0) || (every == 0)) { return false; }
+
+    // Trace ids are often sequential, so they are mixed (splitmix64 finalizer) before picking one in every
+    uint64_t h = tid;
+    h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    h = (h ^ (h >> 27)) * 0x94d049bb133111ebULL;
+    h ^= (h >> 31);
+    return (h % every) == 0;
+}
+
+void IOTrace::record_sampled(trace_id_t tid, io_trace_stage_t stage) { thread_ring().record(tid, stage, now_ns()); }
+
+std::vector< io_trace_event > IOTrace::dump() {
+    std::vector< std::shared_ptr< trace_ring > > rings;
+    {
+        auto& reg = registry();
+        std::unique_lock lg{reg.mtx};
+        rings = reg.rings;
+    }
+
+    std::vector< io_trace_event > events;
+    for (auto const& r : rings) {
+        r->snapshot(events);
+    }
+    std::sort(events.begin(), events.end(), [](auto const& a, auto const& b) { return a.time_ns < b.time_ns; });
+    return events;
+}
+
+bool IOTrace::dump_to_file(const std::string& path) {
+    std::ofstream out{path};
+    if (!out) { return false; }
+    for (auto const& e : dump()) {
+        out << e.trace_id << ' ' << enum_name(e.stage) << ' ' << e.time_ns << ' ' << e.thread_num << '\n';
+    }
+    return out.good();
+}
+
+std::vector< io_trace_event > IOTrace::load_from_file(const std::string& path) {
+    std::unordered_map< std::string, io_trace_stage_t > stages;
+    for (uint8_t s{0}; s < num_stages; ++s) {
+        stages.emplace(enum_name(io_trace_stage_t(s)), io_trace_stage_t(s));
+    }
+
+    std::vector< io_trace_event > events;
+    std::ifstream in{path};
+    std::string line;
+    while (std::getline(in, line)) {
+        std::istringstream ss{line};
+        io_trace_event e;
+        std::string stage;
+        if (!(ss >> e.trace_id >> stage >> e.time_ns >> e.thread_num)) { continue; }
+        auto const it = stages.find(stage);
+        if (it == stages.end()) { continue; }
+        e.stage = it->second;
+        events.push_back(e);
+    }
+    return events;
+}
+
+nlohmann::json IOTrace::breakdown(std::vector< io_trace_event > const& events, int log_level) {
+    // Time of each stage of each trace. A stage seen more than once in a trace (one per blkid piece or retry) is
+    // taken at its last event, so that it accounts for the slowest of them.
+    std::map< trace_id_t, std::array< uint64_t, num_stages > > traces;
+    for (auto const& e : events) {
+        auto& t = traces[e.trace_id];
+        auto& ts = t[s_cast< uint32_t >(e.stage)];
+        ts = std::max(ts, e.time_ns);
+    }
+
+    std::array< std::vector< uint64_t >, num_stages > stage_ns;
+    std::vector< std::pair< uint64_t, trace_id_t > > totals;
+    for (auto const& [tid, t] : traces) {
+        uint64_t first{0}, prev{0};
+        for (uint32_t s{0}; s < num_stages; ++s) {
+            if (t[s] == 0) { continue; }
+            if (prev == 0) {
+                first = t[s];
+            } else {
+                // Events of a trace recorded on different threads could be a little out of order
+                stage_ns[s].push_back((t[s] > prev) ? (t[s] - prev) : 0);
+            }
+            prev = std::max(prev, t[s]);
+        }
+        if (prev > first) { totals.emplace_back(prev - first, tid); }
+    }
+
+    nlohmann::json j;
+    j["traces"] = traces.size();
+    for (uint32_t s{0}; s < num_stages; ++s) {
+        if (!stage_ns[s].empty()) { j["stages"][enum_name(io_trace_stage_t(s))] = percentiles_us(stage_ns[s]); }
+    }
+    if (!totals.empty()) {
+        std::vector< uint64_t > total_ns;
+        for (auto const& [ns, _] : totals) {
+            total_ns.push_back(ns);
+        }
+        j["total"] = percentiles_us(total_ns);
+    }
+
+    if (log_level >= 1) {
+        static constexpr size_t max_slowest{10};
+        auto const nslowest = std::min(max_slowest, totals.size());
+        std::partial_sort(totals.begin(), totals.begin() + nslowest, totals.end(), std::greater<>());
+        j["slowest"] = nlohmann::json::array();
+        for (size_t i{0}; i < nslowest; ++i) {
+            auto const& t = traces[totals[i].second];
+            nlohmann::json tj;
+            tj["trace_id"] = totals[i].second;
+            tj["total_us"] = totals[i].first / 1000.0;
+            uint64_t prev{0};
+            for (uint32_t s{0}; s < num_stages; ++s) {
+                if (t[s] == 0) { continue; }
+                auto const ns = ((prev == 0) || (t[s] < prev)) ? 0 : (t[s] - prev);
+                tj["stages_us"][enum_name(io_trace_stage_t(s))] = ns / 1000.0;
+                prev = std::max(prev, t[s]);
+            }
+            j["slowest"].push_back(std::move(tj));
+        }
+    }
+    return j;
+}
+} // namespace homestore
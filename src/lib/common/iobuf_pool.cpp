@@ -0,0 +1,132 @@
+/*********************************************************************************
+ * Modifications Copyright 2017-2019 eBay Inc.
+ *
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *    https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed
+ * under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ *
+ *********************************************************************************/
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <vector>
+
+#include "iobuf_pool.hpp"
+#include "homestore_utils.hpp"
+#include "homestore_assert.hpp"
+
+namespace homestore {
+static constexpr uint32_t num_size_classes{std::countr_zero(IOBufPool::max_class_size) -
+                                           std::countr_zero(IOBufPool::min_class_size) + 1};
+
+static std::atomic< uint64_t > s_cached_bytes{0};
+static std::atomic< uint64_t > s_inuse_bytes{0};
+
+// Returns num_size_classes for sizes which are not pooled
+static uint32_t size_class(size_t size) {
+    if (size > IOBufPool::max_class_size) { return num_size_classes; }
+    auto const class_size = std::bit_ceil(std::max(size, IOBufPool::min_class_size));
+    return std::countr_zero(class_size) - std::countr_zero(IOBufPool::min_class_size);
+}
+
+static size_t class_size(uint32_t cls) { return IOBufPool::min_class_size << cls; }
+
+namespace {
+struct thread_buf_cache {
+    std::array< std::vector< uint8_t* >, num_size_classes > bufs;
+
+    ~thread_buf_cache() {
+        for (uint32_t cls{0}; cls < num_size_classes; ++cls) {
+            for (auto buf : bufs[cls]) {
+                hs_utils::iobuf_free(buf, sisl::buftag::common);
+            }
+            s_cached_bytes.fetch_sub(bufs[cls].size() * class_size(cls), std::memory_order_relaxed);
+        }
+    }
+};
+} // namespace
+
+static thread_buf_cache& thread_cache() {
+    static thread_local thread_buf_cache s_cache;
+    return s_cache;
+}
+
+IOBufPoolMetrics::IOBufPoolMetrics() : sisl::MetricsGroupWrapper{"IOBufPool", "homestore"} {
+    REGISTER_COUNTER(iobuf_pool_allocs, "Number of buffers allocated from io buf pool");
+    REGISTER_COUNTER(iobuf_pool_hits, "Number of buffer allocations served from the per thread cache");
+    REGISTER_COUNTER(iobuf_pool_unpooled_allocs, "Number of buffer allocations too large to be pooled");
+    REGISTER_COUNTER(iobuf_pool_heap_frees, "Number of buffers freed to heap because per thread cache was full");
+    REGISTER_GAUGE(iobuf_pool_cached_bytes, "Bytes of free buffers held in per thread caches");
+    REGISTER_GAUGE(iobuf_pool_inuse_bytes, "Bytes of pooled buffers handed out and not yet freed");
+
+    register_me_to_farm();
+    attach_gather_cb(std::bind(&IOBufPoolMetrics::on_gather, this));
+}
+
+void IOBufPoolMetrics::on_gather() {
+    GAUGE_UPDATE(*this, iobuf_pool_cached_bytes, IOBufPool::cached_bytes());
+    GAUGE_UPDATE(*this, iobuf_pool_inuse_bytes, IOBufPool::inuse_bytes());
+}
+
+IOBufPoolMetrics& IOBufPool::metrics() {
+    // Intentionally not destroyed, since buffers could be freed by threads exiting after static destruction
+    static IOBufPoolMetrics* s_metrics = new IOBufPoolMetrics();
+    return *s_metrics;
+}
+
+uint8_t* IOBufPool::alloc(size_t size, size_t alignment) {
+    auto const cls = size_class(size);
+    if (cls == num_size_classes) {
+        COUNTER_INCREMENT(metrics(), iobuf_pool_unpooled_allocs, 1);
+        return hs_utils::iobuf_alloc(size, sisl::buftag::common, alignment);
+    }
+
+    COUNTER_INCREMENT(metrics(), iobuf_pool_allocs, 1);
+    auto const csize = class_size(cls);
+    s_inuse_bytes.fetch_add(csize, std::memory_order_relaxed);
+
+    // Cached buffers are all aligned to pool_alignment, which covers the dma alignment of all our devices
+    auto& cached = thread_cache().bufs[cls];
+    if (!cached.empty() && (alignment <= pool_alignment)) {
+        auto buf = cached.back();
+        cached.pop_back();
+        s_cached_bytes.fetch_sub(csize, std::memory_order_relaxed);
+        COUNTER_INCREMENT(metrics(), iobuf_pool_hits, 1);
+        return buf;
+    }
+    return hs_utils::iobuf_alloc(csize, sisl::buftag::common, std::max(alignment, pool_alignment));
+}
+
+void IOBufPool::free(uint8_t* buf, size_t size) {
+    auto const cls = size_class(size);
+    if (cls == num_size_classes) {
+        hs_utils::iobuf_free(buf, sisl::buftag::common);
+        return;
+    }
+
+    auto const csize = class_size(cls);
+    s_inuse_bytes.fetch_sub(csize, std::memory_order_relaxed);
+
+    auto& cached = thread_cache().bufs[cls];
+    auto const max_cached_bytes = uint64_cast(HS_DYNAMIC_CONFIG(resource_limits.iobuf_pool_cache_kb_per_class)) * 1024;
+    auto const max_cached = std::max(uint64_t{1}, max_cached_bytes / csize);
+    if (cached.size() >= max_cached) {
+        COUNTER_INCREMENT(metrics(), iobuf_pool_heap_frees, 1);
+        hs_utils::iobuf_free(buf, sisl::buftag::common);
+        return;
+    }
+    cached.push_back(buf);
+    s_cached_bytes.fetch_add(csize, std::memory_order_relaxed);
+}
+
+uint64_t IOBufPool::cached_bytes() { return s_cached_bytes.load(std::memory_order_relaxed); }
+uint64_t IOBufPool::inuse_bytes() { return s_inuse_bytes.load(std::memory_order_relaxed); }
+} // namespace homestore
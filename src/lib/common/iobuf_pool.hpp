@@ -0,0 +1,94 @@
+/*********************************************************************************
+ * Modifications Copyright 2017-2019 eBay Inc.
+ *
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *    https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed
+ * under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ *
+ *********************************************************************************/
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <sisl/metrics/metrics.hpp>
+
+namespace homestore {
+class IOBufPoolMetrics : public sisl::MetricsGroupWrapper {
+public:
+    IOBufPoolMetrics();
+    IOBufPoolMetrics(const IOBufPoolMetrics&) = delete;
+    IOBufPoolMetrics(IOBufPoolMetrics&&) noexcept = delete;
+    IOBufPoolMetrics& operator=(const IOBufPoolMetrics&) = delete;
+    IOBufPoolMetrics& operator=(IOBufPoolMetrics&&) noexcept = delete;
+    ~IOBufPoolMetrics() { deregister_me_from_farm(); }
+
+    void on_gather();
+};
+
+/// @brief Pool of aligned io buffers for the short lived, fixed size buffers of io hot paths (meta blk writes, log
+/// reads etc), so that they don't go to posix_memalign on every io.
+///
+/// Buffers are bucketed into power of 2 size classes from min_class_size to max_class_size and cached per thread (so
+/// per reactor), upto resource_limits.iobuf_pool_cache_kb_per_class of each class. A buffer freed on a thread other
+/// than the one which allocated it is cached in the freeing thread. Sizes above max_class_size are not pooled.
+/// The caller has to pass the same size to free as it passed to alloc.
+class IOBufPool {
+public:
+    static constexpr size_t min_class_size{512};
+    static constexpr size_t max_class_size{64 * 1024};
+    static constexpr size_t pool_alignment{4096};
+
+    static uint8_t* alloc(size_t size, size_t alignment);
+    static void free(uint8_t* buf, size_t size);
+
+    static uint64_t cached_bytes();
+    static uint64_t inuse_bytes();
+    static IOBufPoolMetrics& metrics();
+};
+
+/// @brief Move only owner of a buffer allocated from IOBufPool, which returns the buffer to the pool on destruction.
+class pooled_iobuf {
+public:
+    pooled_iobuf() = default;
+    pooled_iobuf(size_t size, size_t alignment) :
+            m_buf{IOBufPool::alloc(size, alignment)}, m_size{static_cast< uint32_t >(size)} {}
+    pooled_iobuf(const pooled_iobuf&) = delete;
+    pooled_iobuf& operator=(const pooled_iobuf&) = delete;
+    pooled_iobuf(pooled_iobuf&& other) noexcept : m_buf{other.m_buf}, m_size{other.m_size} {
+        other.m_buf = nullptr;
+        other.m_size = 0;
+    }
+    pooled_iobuf& operator=(pooled_iobuf&& other) noexcept {
+        if (this != &other) {
+            reset();
+            m_buf = other.m_buf;
+            m_size = other.m_size;
+            other.m_buf = nullptr;
+            other.m_size = 0;
+        }
+        return *this;
+    }
+    ~pooled_iobuf() { reset(); }
+
+    void reset() {
+        if (m_buf) { IOBufPool::free(m_buf, m_size); }
+        m_buf = nullptr;
+        m_size = 0;
+    }
+
+    uint8_t* bytes() { return m_buf; }
+    const uint8_t* cbytes() const { return m_buf; }
+    uint32_t size() const { return m_size; }
+    explicit operator bool() const { return (m_buf != nullptr); }
+
+private:
+    uint8_t* m_buf{nullptr};
+    uint32_t m_size{0};
+};
+} // namespace homestore
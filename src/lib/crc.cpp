@@ -1,13 +1,37 @@
-// Only x86 and x86_64 supported by Intel Storage Acceleration library
-#ifdef NO_ISAL
-
+/*********************************************************************************
+ * Modifications Copyright 2017-2019 eBay Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *    https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed
+ * under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ *
+ *********************************************************************************/
+#include <array>
 #include <cstdint>
 #include <cstddef>
-extern "C" {
+#include <cstring>
+
+#include "crc_impl.h"
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#elif defined(__aarch64__)
+#include <arm_acle.h>
+#include <asm/hwcap.h>
+#include <sys/auxv.h>
+#endif
+
+namespace homestore::crc {
 #define MAX_ITER 8
 
 // crc16_t10dif reference function, slow crc16 from the definition.
-uint16_t crc16_t10dif(uint16_t seed, const unsigned char* buf, uint64_t len) {
+uint16_t crc16_t10dif_ref(uint16_t seed, const unsigned char* buf, uint64_t len) {
     size_t rem = seed;
     unsigned int i, j;
 
@@ -24,7 +48,7 @@ uint16_t crc16_t10dif(uint16_t seed, const unsigned char* buf, uint64_t len) {
 }
 
 // crc32_ieee reference function, slow crc32 from the definition.
-uint32_t crc32_ieee(uint32_t seed, const unsigned char* buf, uint64_t len) {
+uint32_t crc32_ieee_ref(uint32_t seed, const unsigned char* buf, uint64_t len) {
     uint64_t rem = ~seed;
     unsigned int i, j;
 
@@ -39,5 +63,283 @@ uint32_t crc32_ieee(uint32_t seed, const unsigned char* buf, uint64_t len) {
     }
     return ~rem;
 }
+
+////////////////////////////////////// Slicing by 8 //////////////////////////////////////
+// Both crcs are non reflected, so crc16 is computed as a 32 bit crc with the polynomial and the state shifted up by 16
+// bits, which lets them share all the code below. The state is always in this shifted 32 bit form.
+static constexpr uint32_t crc32_ieee_poly{0x04C11DB7};
+static constexpr uint32_t crc16_t10dif_poly{0x8bb7};
+
+using crc_tables = std::array< std::array< uint32_t, 256 >, 8 >;
+
+static constexpr crc_tables make_tables(uint32_t poly32) {
+    crc_tables t{};
+    for (uint32_t b{0}; b < 256; ++b) {
+        uint32_t c = b << 24;
+        for (uint32_t j{0}; j < 8; ++j) {
+            c = (c & 0x80000000u) ? ((c << 1) ^ poly32) : (c << 1);
+        }
+        t[0][b] = c;
+    }
+    // t[k][b] is crc of byte b followed by k zero bytes
+    for (uint32_t k{1}; k < 8; ++k) {
+        for (uint32_t b{0}; b < 256; ++b) {
+            t[k][b] = (t[k - 1][b] << 8) ^ t[0][t[k - 1][b] >> 24];
+        }
+    }
+    return t;
+}
+
+static constexpr crc_tables s_crc32_tables{make_tables(crc32_ieee_poly)};
+static constexpr crc_tables s_crc16_tables{make_tables(crc16_t10dif_poly << 16)};
+
+static inline uint32_t load_be32(const unsigned char* p) {
+    uint32_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return __builtin_bswap32(v);
+}
+
+static uint32_t slice8_update(uint32_t c, const unsigned char* p, uint64_t len, const crc_tables& t) {
+    while (len >= 8) {
+        uint32_t const w1 = load_be32(p) ^ c;
+        uint32_t const w2 = load_be32(p + 4);
+        c = t[7][w1 >> 24] ^ t[6][(w1 >> 16) & 0xff] ^ t[5][(w1 >> 8) & 0xff] ^ t[4][w1 & 0xff] ^ t[3][w2 >> 24] ^
+            t[2][(w2 >> 16) & 0xff] ^ t[1][(w2 >> 8) & 0xff] ^ t[0][w2 & 0xff];
+        p += 8;
+        len -= 8;
+    }
+    while (len--) {
+        c = (c << 8) ^ t[0][(c >> 24) ^ *p++];
+    }
+    return c;
+}
+
+uint16_t crc16_t10dif_slice8(uint16_t seed, const unsigned char* buf, uint64_t len) {
+    return static_cast< uint16_t >(slice8_update(uint32_t{seed} << 16, buf, len, s_crc16_tables) >> 16);
+}
+
+uint32_t crc32_ieee_slice8(uint32_t seed, const unsigned char* buf, uint64_t len) {
+    return ~slice8_update(~seed, buf, len, s_crc32_tables);
+}
+
+////////////////////////////////////// PCLMULQDQ folding //////////////////////////////////////
+// The message is taken 16 bytes at a time as a 128 bit polynomial, first byte being the most significant. A block X
+// followed by d bits of message can be replaced by (X * x^d) mod P, split as X_hi * (x^(d+64) mod P) +
+// X_lo * (x^d mod P), without changing the crc of the whole message. Four blocks are folded in parallel, 64 bytes
+// apart, then folded into one, and the last 16 bytes of the folded message along with the tail is run through the
+// table. The initial state is xor'ed into the first 4 bytes, which is the same as starting from it.
+static constexpr uint64_t xpow_mod(uint32_t n, uint32_t poly, uint32_t deg) {
+    uint64_t r{1};
+    for (uint32_t i{0}; i < n; ++i) {
+        r <<= 1;
+        if (r & (1ull << deg)) { r ^= (1ull << deg) | poly; }
+    }
+    return r;
+}
+
+struct fold_consts {
+    uint64_t k512_hi;
+    uint64_t k512_lo;
+    uint64_t k128_hi;
+    uint64_t k128_lo;
+};
+
+static constexpr fold_consts make_fold_consts(uint32_t poly, uint32_t deg) {
+    return fold_consts{xpow_mod(512 + 64, poly, deg), xpow_mod(512, poly, deg), xpow_mod(128 + 64, poly, deg),
+                       xpow_mod(128, poly, deg)};
+}
+
+static constexpr fold_consts s_crc32_fold{make_fold_consts(crc32_ieee_poly, 32)};
+static constexpr fold_consts s_crc16_fold{make_fold_consts(crc16_t10dif_poly, 16)};
+
+#if defined(__x86_64__)
+bool has_pclmul() {
+    static bool const supported = __builtin_cpu_supports("pclmul") && __builtin_cpu_supports("ssse3");
+    return supported;
+}
+
+#define PCLMUL_TARGET __attribute__((target("pclmul,ssse3")))
+
+// Loads 16 bytes with the first byte as the most significant
+PCLMUL_TARGET static inline __m128i load_be128(const unsigned char* src) {
+    __m128i const bswap = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    return _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast< const __m128i* >(src)), bswap);
+}
+
+PCLMUL_TARGET static inline void store_be128(unsigned char* dst, __m128i x) {
+    __m128i const bswap = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    _mm_storeu_si128(reinterpret_cast< __m128i* >(dst), _mm_shuffle_epi8(x, bswap));
+}
+
+PCLMUL_TARGET static inline __m128i fold(__m128i x, __m128i k) {
+    return _mm_xor_si128(_mm_clmulepi64_si128(x, k, 0x11), _mm_clmulepi64_si128(x, k, 0x00));
+}
+
+PCLMUL_TARGET static uint32_t pclmul_update(uint32_t c, const unsigned char* p, uint64_t len, const fold_consts& k,
+                                            const crc_tables& t) {
+    if (len < 64) { return slice8_update(c, p, len, t); }
+
+    __m128i a0 = _mm_xor_si128(load_be128(p), _mm_set_epi32(static_cast< int >(c), 0, 0, 0));
+    __m128i a1 = load_be128(p + 16);
+    __m128i a2 = load_be128(p + 32);
+    __m128i a3 = load_be128(p + 48);
+    p += 64;
+    len -= 64;
+
+    __m128i const k512 = _mm_set_epi64x(static_cast< int64_t >(k.k512_hi), static_cast< int64_t >(k.k512_lo));
+    while (len >= 64) {
+        a0 = _mm_xor_si128(fold(a0, k512), load_be128(p));
+        a1 = _mm_xor_si128(fold(a1, k512), load_be128(p + 16));
+        a2 = _mm_xor_si128(fold(a2, k512), load_be128(p + 32));
+        a3 = _mm_xor_si128(fold(a3, k512), load_be128(p + 48));
+        p += 64;
+        len -= 64;
+    }
+
+    __m128i const k128 = _mm_set_epi64x(static_cast< int64_t >(k.k128_hi), static_cast< int64_t >(k.k128_lo));
+    a1 = _mm_xor_si128(a1, fold(a0, k128));
+    a2 = _mm_xor_si128(a2, fold(a1, k128));
+    a3 = _mm_xor_si128(a3, fold(a2, k128));
+    while (len >= 16) {
+        a3 = _mm_xor_si128(fold(a3, k128), load_be128(p));
+        p += 16;
+        len -= 16;
+    }
+
+    unsigned char last[16];
+    store_be128(last, a3);
+    return slice8_update(slice8_update(0, last, sizeof(last), t), p, len, t);
+}
+
+uint16_t crc16_t10dif_pclmul(uint16_t seed, const unsigned char* buf, uint64_t len) {
+    if (!has_pclmul()) { return crc16_t10dif_slice8(seed, buf, len); }
+    return static_cast< uint16_t >(pclmul_update(uint32_t{seed} << 16, buf, len, s_crc16_fold, s_crc16_tables) >> 16);
+}
+
+uint32_t crc32_ieee_pclmul(uint32_t seed, const unsigned char* buf, uint64_t len) {
+    if (!has_pclmul()) { return crc32_ieee_slice8(seed, buf, len); }
+    return ~pclmul_update(~seed, buf, len, s_crc32_fold, s_crc32_tables);
+}
+#else
+bool has_pclmul() { return false; }
+uint16_t crc16_t10dif_pclmul(uint16_t seed, const unsigned char* buf, uint64_t len) {
+    return crc16_t10dif_slice8(seed, buf, len);
+}
+uint32_t crc32_ieee_pclmul(uint32_t seed, const unsigned char* buf, uint64_t len) {
+    return crc32_ieee_slice8(seed, buf, len);
+}
+#endif
+
+////////////////////////////////////// ARMv8 crc32 instructions //////////////////////////////////////
+// The crc32 instructions compute the reflected crc32 of the same polynomial, i.e. the bits of each byte and of the
+// state are taken in the reverse order. So the state is kept bit reversed and each byte is bit reversed before it is
+// fed in. There is no instruction for crc16_t10dif polynomial, so that stays with the tables.
+#if defined(__aarch64__)
+bool has_armv8_crc() {
+    static bool const supported = (getauxval(AT_HWCAP) & HWCAP_CRC32) != 0;
+    return supported;
+}
+
+__attribute__((target("+crc"))) static uint32_t armv8_update(uint32_t c, const unsigned char* p, uint64_t len) {
+    uint32_t r = __rbit(c);
+    while (len >= 8) {
+        uint64_t w;
+        std::memcpy(&w, p, sizeof(w));
+        r = __crc32d(r, __builtin_bswap64(__rbitll(w))); // Reverse the bits within each byte, keeping the byte order
+        p += 8;
+        len -= 8;
+    }
+    while (len--) {
+        r = __crc32b(r, static_cast< uint8_t >(__rbit(*p++) >> 24));
+    }
+    return __rbit(r);
+}
+
+uint32_t crc32_ieee_armv8(uint32_t seed, const unsigned char* buf, uint64_t len) {
+    if (!has_armv8_crc()) { return crc32_ieee_slice8(seed, buf, len); }
+    return ~armv8_update(~seed, buf, len);
+}
+#else
+bool has_armv8_crc() { return false; }
+uint32_t crc32_ieee_armv8(uint32_t seed, const unsigned char* buf, uint64_t len) {
+    return crc32_ieee_slice8(seed, buf, len);
+}
+#endif
+
+////////////////////////////////////// Combine //////////////////////////////////////
+// (a * b) mod P, of polynomials in the non reflected form (bit 31 is the coefficient of x^31)
+static constexpr uint32_t crc32_mulmod(uint32_t a, uint32_t b) {
+    uint32_t r{0};
+    for (int i{31}; i >= 0; --i) {
+        r = (r & 0x80000000u) ? ((r << 1) ^ crc32_ieee_poly) : (r << 1);
+        if (b & (1u << i)) { r ^= a; }
+    }
+    return r;
+}
+
+// x^(8 * 2^k) mod P, i.e. the multiplier to shift the crc state by 2^k bytes
+static constexpr std::array< uint32_t, 64 > make_byte_shift_table() {
+    std::array< uint32_t, 64 > t{};
+    t[0] = 0x100;
+    for (uint32_t k{1}; k < t.size(); ++k) {
+        t[k] = crc32_mulmod(t[k - 1], t[k - 1]);
+    }
+    return t;
+}
+
+static constexpr std::array< uint32_t, 64 > s_crc32_byte_shift{make_byte_shift_table()};
+
+uint32_t crc32_ieee_combine(uint32_t crc1, uint32_t crc2, uint64_t len2, uint32_t seed) {
+    // The crc state after A|B is state(A) * x^(8 * len(B)) + state of B from zero, so crc(A|B) and crc(B) started from
+    // the same seed differ by (crc(A) ^ seed) * x^(8 * len(B)). The inversions of crc32_ieee cancel out in the xor.
+    uint32_t shift{1};
+    for (uint32_t k{0}; len2 != 0; ++k, len2 >>= 1) {
+        if (len2 & 1) { shift = crc32_mulmod(shift, s_crc32_byte_shift[k]); }
+    }
+    return crc2 ^ crc32_mulmod(crc1 ^ seed, shift);
+}
+
+////////////////////////////////////// Dispatch //////////////////////////////////////
+template < typename FnT >
+struct crc_impl {
+    FnT fn;
+    const char* name;
+};
+
+using crc16_fn_t = uint16_t (*)(uint16_t, const unsigned char*, uint64_t);
+using crc32_fn_t = uint32_t (*)(uint32_t, const unsigned char*, uint64_t);
+
+static crc_impl< crc16_fn_t > const& crc16_t10dif_impl() {
+    static crc_impl< crc16_fn_t > const impl = has_pclmul() ? crc_impl< crc16_fn_t >{crc16_t10dif_pclmul, "pclmul"}
+                                                            : crc_impl< crc16_fn_t >{crc16_t10dif_slice8, "slice8"};
+    return impl;
+}
+
+static crc_impl< crc32_fn_t > const& crc32_ieee_impl() {
+    static crc_impl< crc32_fn_t > const impl = has_pclmul() ? crc_impl< crc32_fn_t >{crc32_ieee_pclmul, "pclmul"}
+        : has_armv8_crc()                                   ? crc_impl< crc32_fn_t >{crc32_ieee_armv8, "armv8"}
+                                                            : crc_impl< crc32_fn_t >{crc32_ieee_slice8, "slice8"};
+    return impl;
+}
+
+#ifdef NO_ISAL
+const char* crc16_t10dif_impl_name() { return crc16_t10dif_impl().name; }
+const char* crc32_ieee_impl_name() { return crc32_ieee_impl().name; }
+#else
+const char* crc16_t10dif_impl_name() { return "isa-l"; }
+const char* crc32_ieee_impl_name() { return "isa-l"; }
+#endif
+} // namespace homestore::crc
+
+// Only x86 and x86_64 supported by Intel Storage Acceleration library
+#ifdef NO_ISAL
+extern "C" {
+uint16_t crc16_t10dif(uint16_t seed, const unsigned char* buf, uint64_t len) {
+    return homestore::crc::crc16_t10dif_impl().fn(seed, buf, len);
+}
+
+uint32_t crc32_ieee(uint32_t seed, const unsigned char* buf, uint64_t len) {
+    return homestore::crc::crc32_ieee_impl().fn(seed, buf, len);
+}
 }
 #endif
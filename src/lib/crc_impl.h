@@ -0,0 +1,47 @@
+/*********************************************************************************
+ * Modifications Copyright 2017-2019 eBay Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *    https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed
+ * under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ *
+ *********************************************************************************/
+#pragma once
+
+#include <cstdint>
+
+// Software and cpu specific implementations of the ISA-L compatible crc16_t10dif and crc32_ieee (both non reflected).
+// They are built irrespective of NO_ISAL, so that they can be tested and benchmarked against ISA-L. With NO_ISAL,
+// crc16_t10dif/crc32_ieee of crc.h dispatch to the fastest one supported by the cpu, picked at load time.
+namespace homestore::crc {
+// Bit at a time, straight from the definition
+uint16_t crc16_t10dif_ref(uint16_t seed, const unsigned char* buf, uint64_t len);
+uint32_t crc32_ieee_ref(uint32_t seed, const unsigned char* buf, uint64_t len);
+
+// Table driven, 8 bytes at a time
+uint16_t crc16_t10dif_slice8(uint16_t seed, const unsigned char* buf, uint64_t len);
+uint32_t crc32_ieee_slice8(uint32_t seed, const unsigned char* buf, uint64_t len);
+
+// Carry-less multiply folding on x86 (PCLMULQDQ). Falls back to slice8 if the cpu doesn't support it.
+bool has_pclmul();
+uint16_t crc16_t10dif_pclmul(uint16_t seed, const unsigned char* buf, uint64_t len);
+uint32_t crc32_ieee_pclmul(uint32_t seed, const unsigned char* buf, uint64_t len);
+
+// ARMv8 crc32 instructions. Falls back to slice8 if the cpu doesn't support it.
+bool has_armv8_crc();
+uint32_t crc32_ieee_armv8(uint32_t seed, const unsigned char* buf, uint64_t len);
+
+// crc32_ieee of A followed by B, given crc1 = crc32_ieee(seed, A) and crc2 = crc32_ieee(seed, B), without reading A
+// or B again. Takes O(log(len2)) time.
+uint32_t crc32_ieee_combine(uint32_t crc1, uint32_t crc2, uint64_t len2, uint32_t seed);
+
+// Name of the implementation crc16_t10dif/crc32_ieee of crc.h resolve to
+const char* crc16_t10dif_impl_name();
+const char* crc32_ieee_impl_name();
+} // namespace homestore::crc
@@ -57,6 +57,15 @@ nlohmann::json Chunk::get_status([[maybe_unused]] int log_level) const {
     j["start_offset"] = start_offset();
     j["size"] = size();
     j["slot_alloced?"] = is_busy();
+
+    auto const io = io_stats();
+    j["reads"] = io.reads;
+    j["writes"] = io.writes;
+    j["read_bytes"] = io.read_bytes;
+    j["write_bytes"] = io.write_bytes;
+    j["avg_read_latency_us"] = io.reads ? (io.read_latency_us / io.reads) : 0;
+    j["avg_write_latency_us"] = io.writes ? (io.write_latency_us / io.writes) : 0;
+    j["heat_iops"] = io.heat_iops;
     return j;
 }
 } // namespace homestore
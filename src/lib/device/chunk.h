@@ -14,6 +14,7 @@
  *********************************************************************************/
 #pragma once
 #include "device/physical_dev.hpp"
+#include "device/chunk_io_stats.hpp"
 
 namespace homestore {
 class BlkAllocator;
@@ -28,6 +29,7 @@ private:
     uint32_t m_vdev_ordinal{0};
     shared< BlkAllocator > m_blk_allocator;
     float blk_usage_report_threshold{0.9};
+    ChunkIOCounters m_io_counters;
 
 public:
     static constexpr auto MAX_CHUNK_SIZE = std::numeric_limits< uint32_t >::max();
@@ -69,6 +71,10 @@ public:
     BlkAllocator* blk_allocator_mutable() { return m_blk_allocator.get(); }
     float get_blk_usage_report_threshold() const { return blk_usage_report_threshold; }
     float get_blk_usage() const;
+    chunk_io_stats io_stats() const { return m_io_counters.stats(); }
+    uint64_t io_heat() const { return m_io_counters.heat_iops(); }
+    void refresh_io_heat() { m_io_counters.refresh_heat(); }
+    ChunkIOCounters& io_counters() { return m_io_counters; }
 
     ////////////// Setters /////////////////////
     void set_user_private(const sisl::blob& data);
@@ -0,0 +1,119 @@
+/*********************************************************************************
+ * Modifications Copyright 2017-2019 eBay Inc.
+ *
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *    https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed
+ * under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ *
+ *********************************************************************************/
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include <sisl/fds/utils.hpp>
+#include <homestore/vchunk.h>
+
+namespace homestore {
+/// @brief Read/write counters of a chunk, updated on io completion by PhysicalDev.
+///
+/// Counters are spread over cache line sized slots and each thread updates the slot it is assigned on first use, so
+/// that reactors doing io on the same chunk don't bounce a cache line between them. They are summed up only when read.
+///
+/// Heat is the iops of the chunk, as a moving average of the rate between two calls of refresh_heat(), which the vdev
+/// makes on every cp flush. Chunk selectors read it on every allocation, so reading it is a single atomic load.
+class ChunkIOCounters {
+public:
+    static constexpr uint32_t max_slots{16};
+
+    ChunkIOCounters() :
+            m_nslots{std::clamp(std::thread::hardware_concurrency(), 1u, max_slots)},
+            m_slots{std::make_unique< slot[] >(m_nslots)},
+            m_heat_time{Clock::now()} {}
+
+    ChunkIOCounters(const ChunkIOCounters&) = delete;
+    ChunkIOCounters& operator=(const ChunkIOCounters&) = delete;
+
+    void on_read(uint64_t size, uint64_t latency_us) {
+        auto& s = thread_slot();
+        s.reads.fetch_add(1, std::memory_order_relaxed);
+        s.read_bytes.fetch_add(size, std::memory_order_relaxed);
+        s.read_latency_us.fetch_add(latency_us, std::memory_order_relaxed);
+    }
+
+    void on_write(uint64_t size, uint64_t latency_us) {
+        auto& s = thread_slot();
+        s.writes.fetch_add(1, std::memory_order_relaxed);
+        s.write_bytes.fetch_add(size, std::memory_order_relaxed);
+        s.write_latency_us.fetch_add(latency_us, std::memory_order_relaxed);
+    }
+
+    chunk_io_stats stats() const {
+        chunk_io_stats st;
+        for (uint32_t i{0}; i < m_nslots; ++i) {
+            auto const& s = m_slots[i];
+            st.reads += s.reads.load(std::memory_order_relaxed);
+            st.writes += s.writes.load(std::memory_order_relaxed);
+            st.read_bytes += s.read_bytes.load(std::memory_order_relaxed);
+            st.write_bytes += s.write_bytes.load(std::memory_order_relaxed);
+            st.read_latency_us += s.read_latency_us.load(std::memory_order_relaxed);
+            st.write_latency_us += s.write_latency_us.load(std::memory_order_relaxed);
+        }
+        st.heat_iops = heat_iops();
+        return st;
+    }
+
+    uint64_t heat_iops() const { return m_heat.load(std::memory_order_relaxed); }
+
+    void refresh_heat() {
+        uint64_t ios{0};
+        for (uint32_t i{0}; i < m_nslots; ++i) {
+            ios += m_slots[i].reads.load(std::memory_order_relaxed) + m_slots[i].writes.load(std::memory_order_relaxed);
+        }
+
+        std::unique_lock lg{m_heat_mtx};
+        auto const elapsed_us = get_elapsed_time_us(m_heat_time);
+        if (elapsed_us == 0) { return; }
+        auto const rate = ((ios - m_heat_ios) * 1000000) / elapsed_us;
+        m_heat.store((m_heat.load(std::memory_order_relaxed) + rate) / 2, std::memory_order_relaxed);
+        m_heat_ios = ios;
+        m_heat_time = Clock::now();
+    }
+
+private:
+    // 64 bytes is the cache line size of all the cpus we run on
+    struct alignas(64) slot {
+        std::atomic< uint64_t > reads{0};
+        std::atomic< uint64_t > writes{0};
+        std::atomic< uint64_t > read_bytes{0};
+        std::atomic< uint64_t > write_bytes{0};
+        std::atomic< uint64_t > read_latency_us{0};
+        std::atomic< uint64_t > write_latency_us{0};
+    };
+
+    slot& thread_slot() {
+        static std::atomic< uint32_t > s_nthreads{0};
+        static thread_local uint32_t const t_thread_num = s_nthreads.fetch_add(1, std::memory_order_relaxed);
+        return m_slots[t_thread_num % m_nslots];
+    }
+
+private:
+    uint32_t const m_nslots;
+    std::unique_ptr< slot[] > m_slots;
+
+    std::mutex m_heat_mtx; // Serializes refresh_heat() of concurrent cp flushes
+    Clock::time_point m_heat_time;
+    uint64_t m_heat_ios{0};
+    std::atomic< uint64_t > m_heat{0};
+};
+} // namespace homestore
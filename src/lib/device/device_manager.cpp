@@ -199,11 +199,24 @@ void DeviceManager::load_devices() {
         m_boot_in_degraded_mode = true;
     }
 
-    // 1. Load all physical devices.
+    // 1. Load all physical devices. Reading the first block and opening each device are independent sync ios, so they
+    // are done in parallel across devices and the results are applied in the order of the device list.
+    std::vector< first_block > fblks(m_dev_infos.size());
+    std::vector< std::unique_ptr< PhysicalDev > > loaded_pdevs(m_dev_infos.size());
+    hs_utils::parallel_for(m_dev_infos.size(), HS_DYNAMIC_CONFIG(generic.recovery_threads), [&](size_t i) {
+        auto const& d = m_dev_infos[i];
+        fblks[i] = PhysicalDev::read_first_block(d.dev_name, device_open_flags(d.dev_name));
+        if (fblks[i].is_valid() &&
+            (fblks[i].this_pdev_hdr.get_system_uuid_str() == m_first_blk_hdr.get_system_uuid_str())) {
+            loaded_pdevs[i] = std::make_unique< PhysicalDev >(d, device_open_flags(d.dev_name), fblks[i].this_pdev_hdr);
+        }
+    });
+
     std::vector< dev_info > pdevs_to_format;
     auto stale_first_blk_found = false;
-    for (auto& d : m_dev_infos) {
-        first_block fblk = PhysicalDev::read_first_block(d.dev_name, device_open_flags(d.dev_name));
+    for (size_t i{0}; i < m_dev_infos.size(); ++i) {
+        auto& d = m_dev_infos[i];
+        first_block& fblk = fblks[i];
         pdev_info_header* pinfo = &fblk.this_pdev_hdr;
 
         if (!fblk.is_valid()) {
@@ -215,7 +228,7 @@ void DeviceManager::load_devices() {
                               "homestore is provided?",
                               d.dev_name);
 
-            auto pdev = std::make_unique< PhysicalDev >(d, device_open_flags(d.dev_name), *pinfo);
+            auto pdev = std::move(loaded_pdevs[i]);
             LOGINFO("Loading Homestore from Device={} with first block as: [{}]", d.dev_name, fblk.to_string());
 
             auto it = m_pdevs_by_type.find(d.dev_type);
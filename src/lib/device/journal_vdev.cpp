@@ -177,6 +177,8 @@ uint64_t JournalVirtualDev::get_end_of_chunk(shared< Chunk >& chunk) const {
 }
 
 shared< JournalVirtualDev::Descriptor > JournalVirtualDev::open(logdev_id_t logdev_id) {
+    // Logdevs are opened in parallel during recovery
+    std::lock_guard lock{m_mutex};
     auto it = m_journal_descriptors.find(logdev_id);
     if (it == m_journal_descriptors.end()) {
         auto journal_desc = std::make_shared< JournalVirtualDev::Descriptor >(*this, logdev_id);
@@ -193,6 +195,7 @@ shared< JournalVirtualDev::Descriptor > JournalVirtualDev::open(logdev_id_t logd
 }
 
 void JournalVirtualDev::destroy(logdev_id_t logdev_id) {
+    std::lock_guard lock{m_mutex};
     auto it = m_journal_descriptors.find(logdev_id);
     if (it == m_journal_descriptors.end()) {
         LOGERROR("logdev not found log_dev={}", logdev_id);
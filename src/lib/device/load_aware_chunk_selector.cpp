@@ -0,0 +1,166 @@
+/*********************************************************************************
+ * Modifications Copyright 2017-2019 eBay Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *    https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed
+ * under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ *
+ *********************************************************************************/
+#include <algorithm>
+#include <random>
+
+#include <homestore/homestore.hpp>
+#include "load_aware_chunk_selector.h"
+#include "blkalloc/blk_allocator.h"
+#include "device/physical_dev.hpp"
+
+namespace homestore {
+// Chunks and pdevs are only added while the vdev is being created/loaded, before any allocation, so the containers
+// themselves need no locking. Same restriction as RoundRobinChunkSelector.
+void LoadAwareChunkSelector::add_chunk(cshared< Chunk >& chunk) {
+    auto cs = std::make_unique< chunk_state >();
+    cs->chunk = chunk;
+    cs->free_blks.store(chunk->blk_allocator() ? chunk->blk_allocator()->get_total_blks() : 0);
+
+    cs->ps = pdev_state_for(chunk->physical_dev_mutable());
+    cs->ps->chunks.push_back(cs.get());
+    cs->ps->total_blks += cs->free_blks.load();
+
+    m_chunks.push_back(chunk);
+    m_chunk_states[chunk->chunk_id()] = std::move(cs);
+}
+
+void LoadAwareChunkSelector::remove_chunk(cshared< Chunk >& chunk) {
+    auto it = m_chunk_states.find(chunk->chunk_id());
+    if (it != m_chunk_states.end()) { it->second->removed.store(true); }
+}
+
+void LoadAwareChunkSelector::foreach_chunks(std::function< void(cshared< Chunk >&) >&& cb) {
+    for (auto& chunk : m_chunks) {
+        cb(chunk);
+    }
+}
+
+void LoadAwareChunkSelector::on_alloc_blk(chunk_num_t chunk_num, blk_count_t nblks) {
+    auto it = m_chunk_states.find(chunk_num);
+    if (it == m_chunk_states.end()) { return; }
+    it->second->free_blks.fetch_sub(nblks, std::memory_order_relaxed);
+    it->second->ps->alloced_blks.fetch_add(nblks, std::memory_order_relaxed);
+}
+
+void LoadAwareChunkSelector::on_free_blk(chunk_num_t chunk_num, blk_count_t nblks) {
+    auto it = m_chunk_states.find(chunk_num);
+    if (it == m_chunk_states.end()) { return; }
+    it->second->free_blks.fetch_add(nblks, std::memory_order_relaxed);
+}
+
+cshared< Chunk > LoadAwareChunkSelector::select_chunk(blk_count_t nblks, const blk_alloc_hints& hints) {
+    struct candidate {
+        pdev_state const* ps;
+        uint64_t load;
+        uint64_t wear_permille;
+    };
+
+    std::vector< candidate > candidates;
+    candidates.reserve(m_pdevs.size());
+    for (auto const& ps : m_pdevs) {
+        if (hints.pdev_id_hint && (*hints.pdev_id_hint != ps->pdev->pdev_id())) { continue; }
+        auto const latency_us = std::max(ps->pdev->io_latency_ewma_us(), uint64_t{1});
+        auto const alloced_blks = ps->alloced_blks.load(std::memory_order_relaxed);
+        candidates.push_back(candidate{.ps = ps.get(),
+                                       .load = (uint64_t{ps->pdev->outstanding_ios()} + 1) * latency_us,
+                                       .wear_permille = ps->total_blks ? (alloced_blks * 1000) / ps->total_blks : 0});
+    }
+    std::sort(candidates.begin(), candidates.end(), [](candidate const& a, candidate const& b) {
+        return (a.load != b.load) ? (a.load < b.load) : (a.wear_permille < b.wear_permille);
+    });
+
+    for (auto const& c : candidates) {
+        if (auto cs = pick_chunk(*c.ps, nblks); cs != nullptr) { return cs->chunk; }
+    }
+
+    // No chunk appears to have room for all the blks, let the caller try the one with most free blks, it could still
+    // succeed on a partial alloc
+    chunk_state* best{nullptr};
+    int64_t best_free{0};
+    for (auto const& [_, cs] : m_chunk_states) {
+        if (cs->removed.load()) { continue; }
+        if (auto const nfree = free_blks(cs.get()); (best == nullptr) || (nfree > best_free)) {
+            best = cs.get();
+            best_free = nfree;
+        }
+    }
+    static const shared< Chunk > s_no_chunk{nullptr};
+    return best ? best->chunk : s_no_chunk;
+}
+
+// Out of the chunks in this pdev which have room for nblks, take two at random and pick the one with more free blks,
+// unless the other one is much cooler (see hot_chunk_min_iops). Always picking the chunk with most free blks would send
+// every concurrent allocation (and every retry after a failed allocation due to fragmentation) to the same chunk.
+LoadAwareChunkSelector::chunk_state* LoadAwareChunkSelector::pick_chunk(pdev_state const& ps,
+                                                                       blk_count_t nblks) const {
+    static thread_local std::vector< chunk_state* > s_fits;
+    static thread_local std::mt19937 s_re{std::random_device{}()};
+
+    s_fits.clear();
+    for (auto cs : ps.chunks) {
+        if (!cs->removed.load() && (free_blks(cs) >= int64_t{nblks})) { s_fits.push_back(cs); }
+    }
+    if (s_fits.empty()) { return nullptr; }
+
+    std::uniform_int_distribution< size_t > rand_idx{0, s_fits.size() - 1};
+    auto first = s_fits[rand_idx(s_re)];
+    auto second = s_fits[rand_idx(s_re)];
+    if (first != second) {
+        auto const first_heat = first->chunk->io_heat();
+        auto const second_heat = second->chunk->io_heat();
+        if ((first_heat >= hot_chunk_min_iops) && (first_heat > 2 * second_heat)) { return second; }
+        if ((second_heat >= hot_chunk_min_iops) && (second_heat > 2 * first_heat)) { return first; }
+    }
+    return (free_blks(first) >= free_blks(second)) ? first : second;
+}
+
+int64_t LoadAwareChunkSelector::free_blks(chunk_state* cs) const {
+    if (!cs->synced.load(std::memory_order_acquire)) {
+        auto const* ba = cs->chunk->blk_allocator();
+        if ((ba != nullptr) && !hs()->is_initializing() && ba->is_loaded() && !cs->synced.exchange(true)) {
+            cs->free_blks.store(ba->available_blks());
+        }
+    }
+    return cs->free_blks.load(std::memory_order_relaxed);
+}
+
+LoadAwareChunkSelector::pdev_state* LoadAwareChunkSelector::pdev_state_for(PhysicalDev* pdev) {
+    for (auto& ps : m_pdevs) {
+        if (ps->pdev == pdev) { return ps.get(); }
+    }
+    auto ps = std::make_unique< pdev_state >();
+    ps->pdev = pdev;
+    return m_pdevs.emplace_back(std::move(ps)).get();
+}
+
+nlohmann::json LoadAwareChunkSelector::get_status(int log_level) const {
+    nlohmann::json j;
+    for (auto const& ps : m_pdevs) {
+        nlohmann::json pj;
+        pj["outstanding_ios"] = ps->pdev->outstanding_ios();
+        pj["io_latency_ewma_us"] = ps->pdev->io_latency_ewma_us();
+        pj["alloced_blks"] = ps->alloced_blks.load();
+        pj["total_blks"] = ps->total_blks;
+        if (log_level >= 1) {
+            for (auto const cs : ps->chunks) {
+                pj["chunk_free_blks"][std::to_string(cs->chunk->chunk_id())] = cs->free_blks.load();
+                pj["chunk_heat_iops"][std::to_string(cs->chunk->chunk_id())] = cs->chunk->io_heat();
+            }
+        }
+        j[ps->pdev->get_devname()] = pj;
+    }
+    return j;
+}
+} // namespace homestore
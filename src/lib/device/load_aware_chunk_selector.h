@@ -0,0 +1,95 @@
+/*********************************************************************************
+ * Modifications Copyright 2017-2019 eBay Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *    https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed
+ * under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ *
+ *********************************************************************************/
+#pragma once
+
+#include <homestore/chunk_selector.h>
+
+#include <atomic>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include <sisl/logging/logging.h>
+
+#include <homestore/vchunk.h>
+#include "device/chunk.h"
+
+namespace homestore {
+class PhysicalDev;
+
+/// @brief Chunk selector which steers allocations to the least loaded physical device and, within that device, to a
+/// chunk with most free space.
+///
+/// Load of a device is its number of outstanding async ios times its moving average io latency, so a slower device
+/// is picked only once faster devices have proportionately deeper queues. Among equally loaded devices, the one with
+/// the least blks allocated through this selector relative to its size (a proxy for wear) is preferred.
+///
+/// Free space of each chunk is tracked through on_alloc_blk/on_free_blk, including the frees deferred to cp flush (see
+/// track_deferred_free). Since blks reserved during recovery are not reported through these callbacks, the count is
+/// synced with the blk allocator the first time the chunk is looked at after homestore is started and its allocator is
+/// loaded.
+///
+/// Within a device, a chunk taking at least hot_chunk_min_iops and more than twice the iops of the other candidate is
+/// passed over regardless of its free space, so that new data of a busy workload doesn't keep landing on the chunk its
+/// reads and overwrites already go to. Heat is refreshed on cp flush, so it lags the workload by up to a cp interval.
+class LoadAwareChunkSelector : public ChunkSelector {
+public:
+    static constexpr uint64_t hot_chunk_min_iops{100};
+
+    LoadAwareChunkSelector() = default;
+    LoadAwareChunkSelector(const LoadAwareChunkSelector&) = delete;
+    LoadAwareChunkSelector(LoadAwareChunkSelector&&) noexcept = delete;
+    LoadAwareChunkSelector& operator=(const LoadAwareChunkSelector&) = delete;
+    LoadAwareChunkSelector& operator=(LoadAwareChunkSelector&&) noexcept = delete;
+    ~LoadAwareChunkSelector() = default;
+
+    void add_chunk(cshared< Chunk >&) override;
+    void remove_chunk(cshared< Chunk >&) override;
+    cshared< Chunk > select_chunk(blk_count_t nblks, const blk_alloc_hints& hints) override;
+    void foreach_chunks(std::function< void(cshared< Chunk >&) >&& cb) override;
+    void on_alloc_blk(chunk_num_t chunk_num, blk_count_t nblks) override;
+    void on_free_blk(chunk_num_t chunk_num, blk_count_t nblks) override;
+    bool track_deferred_free() const override { return true; }
+
+    nlohmann::json get_status(int log_level) const;
+
+private:
+    struct chunk_state;
+    struct pdev_state {
+        PhysicalDev* pdev{nullptr};
+        std::vector< chunk_state* > chunks;
+        uint64_t total_blks{0};
+        std::atomic< uint64_t > alloced_blks{0}; // Total blks ever allocated on this device through this selector
+    };
+
+    struct chunk_state {
+        shared< Chunk > chunk;
+        pdev_state* ps{nullptr};
+        std::atomic< int64_t > free_blks{0};
+        std::atomic< bool > synced{false};
+        std::atomic< bool > removed{false};
+    };
+
+    pdev_state* pdev_state_for(PhysicalDev* pdev);
+    int64_t free_blks(chunk_state* cs) const;
+    chunk_state* pick_chunk(pdev_state const& ps, blk_count_t nblks) const;
+
+private:
+    std::vector< shared< Chunk > > m_chunks;
+    std::vector< std::unique_ptr< pdev_state > > m_pdevs;
+    std::unordered_map< chunk_num_t, std::unique_ptr< chunk_state > > m_chunk_states;
+};
+
+} // namespace homestore
@@ -24,6 +24,7 @@
 #include <sisl/fds/utils.hpp>
 
 #include <homestore/homestore_decl.hpp>
+#include <homestore/io_trace.hpp>
 #include "device/chunk.h"
 #include "device/physical_dev.hpp"
 #include "device/device.h"
@@ -137,53 +138,84 @@ std::error_code PhysicalDev::read_super_block(uint8_t* buf, uint32_t sb_size, ui
 void PhysicalDev::close_device() { close_and_uncache_dev(m_devname, m_iodev); }
 
 folly::Future< std::error_code > PhysicalDev::async_write(const char* data, uint32_t size, uint64_t offset,
-                                                          bool part_of_batch) {
+                                                          bool part_of_batch, Chunk* chunk) {
     auto const start_time = get_current_time();
+    auto const tid = IOTrace::current();
+    IOTrace::record_current(io_trace_stage_t::drive_write_submit);
+    on_io_submitted();
     return m_drive_iface->async_write(m_iodev.get(), data, size, offset, part_of_batch)
-        .thenValue([this, start_time, size](std::error_code ec) {
+        .thenValue([this, start_time, size, tid, chunk](std::error_code ec) {
+            if (tid != 0) { IOTrace::record_sampled(tid, io_trace_stage_t::drive_write_done); }
             HISTOGRAM_OBSERVE(m_metrics, write_io_sizes, (((size - 1) / 1024) + 1));
-            HISTOGRAM_OBSERVE(m_metrics, drive_write_latency, get_elapsed_time_us(start_time));
+            auto const latency_us = get_elapsed_time_us(start_time);
+            HISTOGRAM_OBSERVE(m_metrics, drive_write_latency, latency_us);
             COUNTER_INCREMENT(m_metrics, drive_async_write_count, 1);
+            if (chunk) { chunk->io_counters().on_write(size, latency_us); }
+            on_io_completed(latency_us);
             return ec;
         });
 }
 
 folly::Future< std::error_code > PhysicalDev::async_writev(const iovec* iov, int iovcnt, uint32_t size, uint64_t offset,
-                                                           bool part_of_batch) {
+                                                           bool part_of_batch, Chunk* chunk) {
     auto const start_time = get_current_time();
+    auto const tid = IOTrace::current();
+    IOTrace::record_current(io_trace_stage_t::drive_write_submit);
+    on_io_submitted();
     return m_drive_iface->async_writev(m_iodev.get(), iov, iovcnt, size, offset, part_of_batch)
-        .thenValue([this, start_time, size](std::error_code ec) {
+        .thenValue([this, start_time, size, tid, chunk](std::error_code ec) {
+            if (tid != 0) { IOTrace::record_sampled(tid, io_trace_stage_t::drive_write_done); }
             HISTOGRAM_OBSERVE(m_metrics, write_io_sizes, (((size - 1) / 1024) + 1));
-            HISTOGRAM_OBSERVE(m_metrics, drive_write_latency, get_elapsed_time_us(start_time));
+            auto const latency_us = get_elapsed_time_us(start_time);
+            HISTOGRAM_OBSERVE(m_metrics, drive_write_latency, latency_us);
             COUNTER_INCREMENT(m_metrics, drive_async_write_count, 1);
+            if (chunk) { chunk->io_counters().on_write(size, latency_us); }
+            on_io_completed(latency_us);
             return ec;
         });
 }
 
 folly::Future< std::error_code > PhysicalDev::async_read(char* data, uint32_t size, uint64_t offset,
-                                                         bool part_of_batch) {
+                                                         bool part_of_batch, Chunk* chunk) {
     auto const start_time = get_current_time();
+    on_io_submitted();
     return m_drive_iface->async_read(m_iodev.get(), data, size, offset, part_of_batch)
-        .thenValue([this, start_time, size](std::error_code ec) {
+        .thenValue([this, start_time, size, chunk](std::error_code ec) {
             HISTOGRAM_OBSERVE(m_metrics, read_io_sizes, (((size - 1) / 1024) + 1));
-            HISTOGRAM_OBSERVE(m_metrics, drive_read_latency, get_elapsed_time_us(start_time));
+            auto const latency_us = get_elapsed_time_us(start_time);
+            HISTOGRAM_OBSERVE(m_metrics, drive_read_latency, latency_us);
             COUNTER_INCREMENT(m_metrics, drive_async_read_count, 1);
+            if (chunk) { chunk->io_counters().on_read(size, latency_us); }
+            on_io_completed(latency_us);
             return ec;
         });
 }
 
 folly::Future< std::error_code > PhysicalDev::async_readv(iovec* iov, int iovcnt, uint32_t size, uint64_t offset,
-                                                          bool part_of_batch) {
+                                                          bool part_of_batch, Chunk* chunk) {
     auto const start_time = get_current_time();
+    on_io_submitted();
     return m_drive_iface->async_readv(m_iodev.get(), iov, iovcnt, size, offset, part_of_batch)
-        .thenValue([this, start_time, size](std::error_code ec) {
+        .thenValue([this, start_time, size, chunk](std::error_code ec) {
             HISTOGRAM_OBSERVE(m_metrics, read_io_sizes, (((size - 1) / 1024) + 1));
-            HISTOGRAM_OBSERVE(m_metrics, drive_read_latency, get_elapsed_time_us(start_time));
+            auto const latency_us = get_elapsed_time_us(start_time);
+            HISTOGRAM_OBSERVE(m_metrics, drive_read_latency, latency_us);
             COUNTER_INCREMENT(m_metrics, drive_async_read_count, 1);
+            if (chunk) { chunk->io_counters().on_read(size, latency_us); }
+            on_io_completed(latency_us);
             return ec;
         });
 }
 
+void PhysicalDev::on_io_completed(uint64_t latency_us) {
+    m_outstanding_ios.fetch_sub(1, std::memory_order_relaxed);
+
+    // Exponential moving average with weight 1/8 for the new sample. Concurrent completions could lose an update,
+    // which is fine since it is only a load indicator
+    auto const avg = m_io_latency_ewma_us.load(std::memory_order_relaxed);
+    m_io_latency_ewma_us.store((avg * 7 + latency_us) / 8, std::memory_order_relaxed);
+}
+
 folly::Future< std::error_code > PhysicalDev::async_write_zero(uint64_t size, uint64_t offset) {
     return m_drive_iface->async_write_zero(m_iodev.get(), size, offset);
 }
@@ -200,38 +232,46 @@ folly::Future< std::error_code > PhysicalDev::async_write_zero(uint64_t size, ui
 
 folly::Future< std::error_code > PhysicalDev::queue_fsync() { return m_drive_iface->queue_fsync(m_iodev.get()); }
 
-std::error_code PhysicalDev::sync_write(const char* data, uint32_t size, uint64_t offset) {
+std::error_code PhysicalDev::sync_write(const char* data, uint32_t size, uint64_t offset, Chunk* chunk) {
     auto const start_time = get_current_time();
     auto const ret = m_drive_iface->sync_write(m_iodev.get(), data, size, offset);
-    HISTOGRAM_OBSERVE(m_metrics, drive_write_latency, get_elapsed_time_us(start_time));
+    auto const latency_us = get_elapsed_time_us(start_time);
+    HISTOGRAM_OBSERVE(m_metrics, drive_write_latency, latency_us);
+    if (chunk) { chunk->io_counters().on_write(size, latency_us); }
     HISTOGRAM_OBSERVE(m_metrics, write_io_sizes, (((size - 1) / 1024) + 1));
     COUNTER_INCREMENT(m_metrics, drive_sync_write_count, 1);
     return ret;
 }
 
-std::error_code PhysicalDev::sync_writev(const iovec* iov, int iovcnt, uint32_t size, uint64_t offset) {
+std::error_code PhysicalDev::sync_writev(const iovec* iov, int iovcnt, uint32_t size, uint64_t offset, Chunk* chunk) {
     auto const start_time = Clock::now();
     auto const ret = m_drive_iface->sync_writev(m_iodev.get(), iov, iovcnt, size, offset);
-    HISTOGRAM_OBSERVE(m_metrics, drive_write_latency, get_elapsed_time_us(start_time));
+    auto const latency_us = get_elapsed_time_us(start_time);
+    HISTOGRAM_OBSERVE(m_metrics, drive_write_latency, latency_us);
+    if (chunk) { chunk->io_counters().on_write(size, latency_us); }
     HISTOGRAM_OBSERVE(m_metrics, write_io_sizes, (((size - 1) / 1024) + 1));
     COUNTER_INCREMENT(m_metrics, drive_sync_write_count, 1);
 
     return ret;
 }
 
-std::error_code PhysicalDev::sync_read(char* data, uint32_t size, uint64_t offset) {
+std::error_code PhysicalDev::sync_read(char* data, uint32_t size, uint64_t offset, Chunk* chunk) {
     auto const start_time = Clock::now();
     auto const ret = m_drive_iface->sync_read(m_iodev.get(), data, size, offset);
-    HISTOGRAM_OBSERVE(m_metrics, drive_read_latency, get_elapsed_time_us(start_time));
+    auto const latency_us = get_elapsed_time_us(start_time);
+    HISTOGRAM_OBSERVE(m_metrics, drive_read_latency, latency_us);
+    if (chunk) { chunk->io_counters().on_read(size, latency_us); }
     HISTOGRAM_OBSERVE(m_metrics, read_io_sizes, (((size - 1) / 1024) + 1));
     COUNTER_INCREMENT(m_metrics, drive_sync_read_count, 1);
     return ret;
 }
 
-std::error_code PhysicalDev::sync_readv(iovec* iov, int iovcnt, uint32_t size, uint64_t offset) {
+std::error_code PhysicalDev::sync_readv(iovec* iov, int iovcnt, uint32_t size, uint64_t offset, Chunk* chunk) {
     auto const start_time = Clock::now();
     auto const ret = m_drive_iface->sync_readv(m_iodev.get(), iov, iovcnt, size, offset);
-    HISTOGRAM_OBSERVE(m_metrics, drive_read_latency, get_elapsed_time_us(start_time));
+    auto const latency_us = get_elapsed_time_us(start_time);
+    HISTOGRAM_OBSERVE(m_metrics, drive_read_latency, latency_us);
+    if (chunk) { chunk->io_counters().on_read(size, latency_us); }
     HISTOGRAM_OBSERVE(m_metrics, read_io_sizes, (((size - 1) / 1024) + 1));
     COUNTER_INCREMENT(m_metrics, drive_sync_read_count, 1);
     return ret;
@@ -246,7 +286,10 @@ std::error_code PhysicalDev::sync_write_zero(uint64_t size, uint64_t offset) {
     return ret;
 }
 
-void PhysicalDev::submit_batch() { m_drive_iface->submit_batch(); }
+void PhysicalDev::submit_batch() {
+    COUNTER_INCREMENT(m_metrics, drive_batch_submit_count, 1);
+    m_drive_iface->submit_batch();
+}
 
 //////////////////////////// Chunk Creation/Load related methods /////////////////////////////////////////
 void PhysicalDev::format_chunks() {
@@ -13,6 +13,7 @@
  *
  *********************************************************************************/
 #pragma once
+#include <atomic>
 #include <vector>
 #include <string>
 #include "hs_super_blk.h"
@@ -47,6 +48,7 @@ public:
         REGISTER_COUNTER(drive_write_errors, "Total drive write errors");
         REGISTER_COUNTER(drive_spurios_events, "Total number of spurious events per drive");
         REGISTER_COUNTER(drive_skipped_chunk_bm_writes, "Total number of skipped writes for chunk bitmap");
+        REGISTER_COUNTER(drive_batch_submit_count, "Total number of batched io submissions");
 
         REGISTER_HISTOGRAM(drive_write_latency, "BlkStore drive write latency in us",
                            HistogramBucketsType(OpLatecyBuckets));
@@ -139,6 +141,8 @@ private:
     std::unique_ptr< sisl::Bitset > m_chunk_info_slots; // Slots to write the chunk info
     uint32_t m_chunk_sb_size{0};                        // Total size of the chunk sb at present
     std::unordered_set< uint64_t > m_chunk_start;       // Store and verify start offset of all chunks for debugging.
+    std::atomic< uint32_t > m_outstanding_ios{0};       // Number of async ios submitted and not yet completed
+    std::atomic< uint64_t > m_io_latency_ewma_us{0};    // Moving average of async io latency
 
 public:
     PhysicalDev(const dev_info& dinfo, int oflags, const pdev_info_header& pinfo);
@@ -200,21 +204,27 @@ public:
     uint32_t pdev_id() const { return m_pdev_info.pdev_id; }
     const std::string& get_devname() const { return m_devname; }
 
+    ///////////// Load Getters, used by chunk selectors to steer allocations away from busy devices ///////////////
+    uint32_t outstanding_ios() const { return m_outstanding_ios.load(std::memory_order_relaxed); }
+    uint64_t io_latency_ewma_us() const { return m_io_latency_ewma_us.load(std::memory_order_relaxed); }
+
     /////////////////////////////////////// IO Methods //////////////////////////////////////////
+    // The chunk, when given, is the one the io falls in and gets it accounted in its io counters on completion
     folly::Future< std::error_code > async_write(const char* data, uint32_t size, uint64_t offset,
-                                                 bool part_of_batch = false);
+                                                 bool part_of_batch = false, Chunk* chunk = nullptr);
     folly::Future< std::error_code > async_writev(const iovec* iov, int iovcnt, uint32_t size, uint64_t offset,
-                                                  bool part_of_batch = false);
-    folly::Future< std::error_code > async_read(char* data, uint32_t size, uint64_t offset, bool part_of_batch = false);
+                                                  bool part_of_batch = false, Chunk* chunk = nullptr);
+    folly::Future< std::error_code > async_read(char* data, uint32_t size, uint64_t offset, bool part_of_batch = false,
+                                                Chunk* chunk = nullptr);
     folly::Future< std::error_code > async_readv(iovec* iov, int iovcnt, uint32_t size, uint64_t offset,
-                                                 bool part_of_batch = false);
+                                                 bool part_of_batch = false, Chunk* chunk = nullptr);
     folly::Future< std::error_code > async_write_zero(uint64_t size, uint64_t offset);
     folly::Future< std::error_code > queue_fsync();
 
-    std::error_code sync_write(const char* data, uint32_t size, uint64_t offset);
-    std::error_code sync_writev(const iovec* iov, int iovcnt, uint32_t size, uint64_t offset);
-    std::error_code sync_read(char* data, uint32_t size, uint64_t offset);
-    std::error_code sync_readv(iovec* iov, int iovcnt, uint32_t size, uint64_t offset);
+    std::error_code sync_write(const char* data, uint32_t size, uint64_t offset, Chunk* chunk = nullptr);
+    std::error_code sync_writev(const iovec* iov, int iovcnt, uint32_t size, uint64_t offset, Chunk* chunk = nullptr);
+    std::error_code sync_read(char* data, uint32_t size, uint64_t offset, Chunk* chunk = nullptr);
+    std::error_code sync_readv(iovec* iov, int iovcnt, uint32_t size, uint64_t offset, Chunk* chunk = nullptr);
     std::error_code sync_write_zero(uint64_t size, uint64_t offset);
     void submit_batch();
 
@@ -238,5 +248,7 @@ private:
                              const sisl::blob& private_data);
     void free_chunk_info(chunk_info* cinfo);
     ChunkInterval find_next_chunk_area(uint64_t size) const;
+    void on_io_submitted() { m_outstanding_ios.fetch_add(1, std::memory_order_relaxed); }
+    void on_io_completed(uint64_t latency_us);
 };
 } // namespace homestore
@@ -41,5 +41,7 @@ uint16_t VChunk::get_chunk_id() const { return m_internal_chunk->chunk_id(); }
 
 uint64_t VChunk::size() const { return m_internal_chunk->size(); }
 
+chunk_io_stats VChunk::get_io_stats() const { return m_internal_chunk->io_stats(); }
+
 cshared< Chunk > VChunk::get_internal_chunk() const { return m_internal_chunk; }
 } // namespace homestore
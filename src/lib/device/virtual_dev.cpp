@@ -32,8 +32,10 @@
 #include <sisl/metrics/metrics.hpp>
 #include <sisl/logging/logging.h>
 #include <sisl/utility/atomic_counter.hpp>
+#include <sisl/utility/thread_factory.hpp>
 #include <iomgr/iomgr_flip.hpp>
 #include <homestore/homestore_decl.hpp>
+#include <homestore/io_trace.hpp>
 
 #include "device/chunk.h"
 #include "device/physical_dev.hpp"
@@ -45,6 +47,7 @@
 #include "common/crash_simulator.hpp"
 #include "blkalloc/varsize_blk_allocator.h"
 #include "device/round_robin_chunk_selector.h"
+#include "device/load_aware_chunk_selector.h"
 #include "blkalloc/append_blk_allocator.h"
 #include "blkalloc/fixed_blk_allocator.h"
 
@@ -100,6 +103,10 @@ VirtualDev::VirtualDev(DeviceManager& dmgr, vdev_info const& vinfo, vdev_event_c
         m_chunk_selector = std::make_shared< RoundRobinChunkSelector >(false /* dynamically add chunk */);
         break;
     }
+    case chunk_selector_type_t::LOAD_AWARE: {
+        m_chunk_selector = std::make_shared< LoadAwareChunkSelector >();
+        break;
+    }
     case chunk_selector_type_t::CUSTOM: {
         HS_REL_ASSERT(custom_chunk_selector, "Expected custom chunk selector to be passed with selector_type=CUSTOM");
         m_chunk_selector = std::move(custom_chunk_selector);
@@ -387,7 +394,8 @@ folly::Future< std::error_code > VirtualDev::async_write(const char* buf, uint32
     if (sisl_unlikely(!hs_utils::mod_aligned_sz(dev_offset, pdev->align_size()))) {
         COUNTER_INCREMENT(m_metrics, unalign_writes, 1);
     }
-    return pdev->async_write(buf, size, dev_offset, part_of_batch);
+    IOTrace::record_current(io_trace_stage_t::vdev_write_submit);
+    return pdev->async_write(buf, size, dev_offset, part_of_batch, chunk);
 }
 
 folly::Future< std::error_code > VirtualDev::async_write(const char* buf, uint32_t size, cshared< Chunk >& chunk,
@@ -407,7 +415,7 @@ folly::Future< std::error_code > VirtualDev::async_write(const char* buf, uint32
     if (sisl_unlikely(!hs_utils::mod_aligned_sz(dev_offset, pdev->align_size()))) {
         COUNTER_INCREMENT(m_metrics, unalign_writes, 1);
     }
-    return pdev->async_write(buf, size, dev_offset, false /* part_of_batch */);
+    return pdev->async_write(buf, size, dev_offset, false /* part_of_batch */, chunk.get());
 }
 
 folly::Future< std::error_code > VirtualDev::async_writev(const iovec* iov, const int iovcnt, BlkId const& bid,
@@ -430,7 +438,8 @@ folly::Future< std::error_code > VirtualDev::async_writev(const iovec* iov, cons
     if (sisl_unlikely(!hs_utils::mod_aligned_sz(dev_offset, pdev->align_size()))) {
         COUNTER_INCREMENT(m_metrics, unalign_writes, 1);
     }
-    return pdev->async_writev(iov, iovcnt, size, dev_offset, part_of_batch);
+    IOTrace::record_current(io_trace_stage_t::vdev_write_submit);
+    return pdev->async_writev(iov, iovcnt, size, dev_offset, part_of_batch, chunk);
 }
 
 folly::Future< std::error_code > VirtualDev::async_writev(const iovec* iov, const int iovcnt, cshared< Chunk >& chunk,
@@ -451,7 +460,7 @@ folly::Future< std::error_code > VirtualDev::async_writev(const iovec* iov, cons
     if (sisl_unlikely(!hs_utils::mod_aligned_sz(dev_offset, pdev->align_size()))) {
         COUNTER_INCREMENT(m_metrics, unalign_writes, 1);
     }
-    return pdev->async_writev(iov, iovcnt, size, dev_offset, false /* part_of_batch */);
+    return pdev->async_writev(iov, iovcnt, size, dev_offset, false /* part_of_batch */, chunk.get());
 }
 
 ////////////////////////// sync write section //////////////////////////////////
@@ -469,7 +478,7 @@ std::error_code VirtualDev::sync_write(const char* buf, uint32_t size, BlkId con
     if (sisl_unlikely(dev_offset == INVALID_DEV_OFFSET)) {
         return std::make_error_code(std::errc::resource_unavailable_try_again);
     }
-    return chunk->physical_dev_mutable()->sync_write(buf, size, dev_offset);
+    return chunk->physical_dev_mutable()->sync_write(buf, size, dev_offset, chunk);
 }
 
 std::error_code VirtualDev::sync_write(const char* buf, uint32_t size, cshared< Chunk >& chunk,
@@ -484,7 +493,7 @@ std::error_code VirtualDev::sync_write(const char* buf, uint32_t size, cshared<
     if (sisl_unlikely(!is_chunk_available(chunk))) {
         return std::make_error_code(std::errc::resource_unavailable_try_again);
     }
-    return chunk->physical_dev_mutable()->sync_write(buf, size, chunk->start_offset() + offset_in_chunk);
+    return chunk->physical_dev_mutable()->sync_write(buf, size, chunk->start_offset() + offset_in_chunk, chunk.get());
 }
 
 std::error_code VirtualDev::sync_writev(const iovec* iov, int iovcnt, BlkId const& bid) {
@@ -509,7 +518,7 @@ std::error_code VirtualDev::sync_writev(const iovec* iov, int iovcnt, BlkId cons
         COUNTER_INCREMENT(m_metrics, unalign_writes, 1);
     }
 
-    return pdev->sync_writev(iov, iovcnt, size, dev_offset);
+    return pdev->sync_writev(iov, iovcnt, size, dev_offset, chunk);
 }
 
 std::error_code VirtualDev::sync_writev(const iovec* iov, int iovcnt, cshared< Chunk >& chunk,
@@ -533,7 +542,7 @@ std::error_code VirtualDev::sync_writev(const iovec* iov, int iovcnt, cshared< C
         COUNTER_INCREMENT(m_metrics, unalign_writes, 1);
     }
 
-    return pdev->sync_writev(iov, iovcnt, size, dev_offset);
+    return pdev->sync_writev(iov, iovcnt, size, dev_offset, chunk.get());
 }
 
 // for read, chunk might be missing in case of pdev is gone(for example , breakfix), so we need to check if chunk is
@@ -548,7 +557,7 @@ folly::Future< std::error_code > VirtualDev::async_read(char* buf, uint64_t size
     if (sisl_unlikely(dev_offset == INVALID_DEV_OFFSET)) {
         return folly::makeFuture< std::error_code >(std::make_error_code(std::errc::resource_unavailable_try_again));
     }
-    return pchunk->physical_dev_mutable()->async_read(buf, size, dev_offset, part_of_batch);
+    return pchunk->physical_dev_mutable()->async_read(buf, size, dev_offset, part_of_batch, pchunk);
 }
 
 folly::Future< std::error_code > VirtualDev::async_readv(iovec* iovs, int iovcnt, uint64_t size, BlkId const& bid,
@@ -560,7 +569,7 @@ folly::Future< std::error_code > VirtualDev::async_readv(iovec* iovs, int iovcnt
     if (sisl_unlikely(dev_offset == INVALID_DEV_OFFSET)) {
         return folly::makeFuture< std::error_code >(std::make_error_code(std::errc::resource_unavailable_try_again));
     }
-    return pchunk->physical_dev_mutable()->async_readv(iovs, iovcnt, size, dev_offset, part_of_batch);
+    return pchunk->physical_dev_mutable()->async_readv(iovs, iovcnt, size, dev_offset, part_of_batch, pchunk);
 }
 
 ////////////////////////////////////////// sync read section ////////////////////////////////////////////
@@ -572,14 +581,14 @@ std::error_code VirtualDev::sync_read(char* buf, uint32_t size, BlkId const& bid
     if (sisl_unlikely(dev_offset == INVALID_DEV_OFFSET)) {
         return std::make_error_code(std::errc::resource_unavailable_try_again);
     }
-    return chunk->physical_dev_mutable()->sync_read(buf, size, dev_offset);
+    return chunk->physical_dev_mutable()->sync_read(buf, size, dev_offset, chunk);
 }
 
 std::error_code VirtualDev::sync_read(char* buf, uint32_t size, cshared< Chunk >& chunk, uint64_t offset_in_chunk) {
     if (sisl_unlikely(!is_chunk_available(chunk))) {
         return std::make_error_code(std::errc::resource_unavailable_try_again);
     }
-    return chunk->physical_dev_mutable()->sync_read(buf, size, chunk->start_offset() + offset_in_chunk);
+    return chunk->physical_dev_mutable()->sync_read(buf, size, chunk->start_offset() + offset_in_chunk, chunk.get());
 }
 
 std::error_code VirtualDev::sync_readv(iovec* iov, int iovcnt, BlkId const& bid) {
@@ -598,7 +607,7 @@ std::error_code VirtualDev::sync_readv(iovec* iov, int iovcnt, BlkId const& bid)
         COUNTER_INCREMENT(m_metrics, unalign_writes, 1);
     }
 
-    return pdev->sync_readv(iov, iovcnt, size, dev_offset);
+    return pdev->sync_readv(iov, iovcnt, size, dev_offset, chunk);
 }
 
 std::error_code VirtualDev::sync_readv(iovec* iov, int iovcnt, cshared< Chunk >& chunk, uint64_t offset_in_chunk) {
@@ -614,7 +623,7 @@ std::error_code VirtualDev::sync_readv(iovec* iov, int iovcnt, cshared< Chunk >&
         COUNTER_INCREMENT(m_metrics, unalign_writes, 1);
     }
 
-    return pdev->sync_readv(iov, iovcnt, size, dev_offset);
+    return pdev->sync_readv(iov, iovcnt, size, dev_offset, chunk.get());
 }
 
 folly::Future< std::error_code > VirtualDev::queue_fsync_pdevs() {
@@ -675,7 +684,9 @@ nlohmann::json VirtualDev::get_status(int log_level) const {
     nlohmann::json j;
 
     try {
+        uint32_t nnot_loaded{0};
         for (auto& [_, chunk] : m_all_chunks) {
+            if ((chunk->blk_allocator() != nullptr) && !chunk->blk_allocator()->is_loaded()) { ++nnot_loaded; }
             nlohmann::json chunk_j;
             chunk_j["ChunkInfo"] = chunk->get_status(log_level);
             if (chunk->blk_allocator() != nullptr) {
@@ -683,6 +694,10 @@ nlohmann::json VirtualDev::get_status(int log_level) const {
             }
             j[std::to_string(chunk->chunk_id())] = chunk_j;
         }
+        j["blk_allocators_not_loaded"] = nnot_loaded;
+        if (auto sel = std::dynamic_pointer_cast< LoadAwareChunkSelector >(m_chunk_selector)) {
+            j["chunk_selector"] = sel->get_status(log_level);
+        }
     } catch (const std::exception& e) { LOGERROR("exception happened {}", e.what()); }
     return j;
 }
@@ -732,22 +747,52 @@ void VirtualDev::cp_flush(VDevCPContext* v_cp_ctx) {
     m_chunk_selector->foreach_chunks([this, cp](cshared< Chunk >& chunk) {
         HS_LOG(TRACE, device, "Flushing chunk: {}, vdev: {}", chunk->chunk_id(), m_vdev_info.name);
         chunk->blk_allocator_mutable()->cp_flush(cp);
+        chunk->refresh_io_heat();
     });
 
     // All of the blkids which were captured in the current vdev cp context will now be freed and hence available for
     // allocation on the new CP dirty collection session which is ongoing
+    bool const notify_selector = m_chunk_selector->track_deferred_free();
     for (auto const& b : v_cp_ctx->m_free_blkid_list) {
         auto chunk = m_dmgr.get_chunk_mutable(b.chunk_num());
         // try to free a blk in a missing chunk, crash if it happens;
         if (!chunk) HS_DBG_ASSERT(false, "chunk is missing for blkid {}", b.to_string());
         BlkAllocator* allocator = chunk->blk_allocator_mutable();
         allocator->free(b);
+        if (notify_selector) { m_chunk_selector->on_free_blk(chunk->chunk_id(), b.blk_count()); }
     }
 }
 
 // sync-ops during cp_flush, so return 100;
 int VirtualDev::cp_progress_percent() { return 100; }
 
+VirtualDev::~VirtualDev() { stop_blk_allocators_load(); }
+
+void VirtualDev::start_blk_allocators_load() {
+    std::vector< shared< Chunk > > chunks;
+    m_chunk_selector->foreach_chunks([&chunks](cshared< Chunk >& chunk) {
+        if ((chunk->blk_allocator() != nullptr) && !chunk->blk_allocator()->is_loaded()) { chunks.push_back(chunk); }
+    });
+    if (chunks.empty()) { return; }
+
+    m_blk_alloc_load_thread = sisl::named_thread("blkalloc_load", [this, chunks = std::move(chunks)]() {
+        auto const start_time = Clock::now();
+        size_t nloaded{0};
+        for (auto const& chunk : chunks) {
+            if (m_stop_blk_alloc_load.load(std::memory_order_relaxed)) { break; }
+            chunk->blk_allocator()->ensure_loaded();
+            ++nloaded;
+        }
+        LOGINFO("vdev={} loaded blk allocators of {}/{} chunks in background in {} ms", m_name, nloaded,
+                chunks.size(), get_elapsed_time_ms(start_time));
+    });
+}
+
+void VirtualDev::stop_blk_allocators_load() {
+    m_stop_blk_alloc_load.store(true, std::memory_order_relaxed);
+    if (m_blk_alloc_load_thread.joinable()) { m_blk_alloc_load_thread.join(); }
+}
+
 void VirtualDev::recovery_completed() {
     if (m_allocator_type != blk_allocator_type_t::append) {
         m_chunk_selector->foreach_chunks(
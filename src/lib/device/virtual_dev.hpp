@@ -22,6 +22,7 @@
 #include <mutex>
 #include <string>
 #include <system_error>
+#include <thread>
 #include <type_traits>
 #include <vector>
 
@@ -102,6 +103,8 @@ protected:
     chunk_selector_type_t m_chunk_selector_type;
     bool m_auto_recovery;
     bool m_use_slab_in_blk_allocator;
+    std::thread m_blk_alloc_load_thread; // Loads the allocators lazily in background (blkallocator.lazy_bitmap_load)
+    std::atomic< bool > m_stop_blk_alloc_load{false};
 
 public:
     VirtualDev(DeviceManager& dmgr, const vdev_info& vinfo, vdev_event_cb_t event_cb, bool is_auto_recovery,
@@ -111,7 +114,7 @@ public:
     VirtualDev& operator=(VirtualDev const& other) = delete;
     VirtualDev(VirtualDev&&) noexcept = delete;
     VirtualDev& operator=(VirtualDev&&) noexcept = delete;
-    virtual ~VirtualDev() = default;
+    virtual ~VirtualDev();
 
     /// @brief Run any initialization of the vdev after recovery or first time.
     virtual void init() {}
@@ -286,6 +289,12 @@ public:
 
     void recovery_completed();
 
+    /// @brief Load the blk allocators of all chunks which are not loaded yet, in a background thread. Chunks are
+    /// loaded in the order chunk selector iterates them. Any alloc/free on a chunk which is not loaded by then loads it
+    /// inline, so this only helps to get them loaded before they are needed.
+    void start_blk_allocators_load();
+    void stop_blk_allocators_load();
+
     ////////////////////////// Standard Getters ///////////////////////////////
     virtual uint64_t available_blks() const;
     virtual uint64_t size() const { return m_vdev_info.vdev_size; }
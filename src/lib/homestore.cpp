@@ -187,8 +187,9 @@ bool HomeStore::start(const hs_input_params& input, hs_before_services_starting_
     m_cp_mgr = std::make_unique< CPManager >();
     m_dev_mgr = std::make_unique< DeviceManager >(input.devices, bind_this(HomeStore::create_vdev_cb, 2));
 
+    m_start_phase_ms.clear();
     if (!m_dev_mgr->is_first_time_boot()) {
-        m_dev_mgr->load_devices();
+        run_start_phase("load_devices", [this]() { m_dev_mgr->load_devices(); });
         if (input.has_fast_dev()) {
             hs_utils::set_btree_mempool_size(m_dev_mgr->atomic_page_size({HSDevType::Fast}));
         } else {
@@ -231,7 +232,7 @@ void HomeStore::format_and_start(std::map< uint32_t, hs_format_params >&& format
             "Fast device is not configured but services are configured to be placed on fast device");
     }
 #endif
-    m_dev_mgr->format_devices();
+    run_start_phase("format_devices", [this]() { m_dev_mgr->format_devices(); });
     if (HomeStoreStaticConfig::instance().input.has_fast_dev()) {
         hs_utils::set_btree_mempool_size(m_dev_mgr->atomic_page_size({HSDevType::Fast}));
     } else {
@@ -285,19 +286,23 @@ void HomeStore::do_start() {
             m_dev_mgr->is_first_time_boot(), HS_DYNAMIC_CONFIG(version), cache_size,
             HomeStoreStaticConfig::instance().to_json().dump(4));
 
-    m_meta_service->start(m_dev_mgr->is_first_time_boot());
-    m_cp_mgr->start(is_first_time_boot());
+    // Services are started in their dependency order, since recovery of each one could call back into consumers
+    // which expect the services started before it to be usable. Parallelism within a phase is left to the service
+    // itself (e.g. meta blks of independent subsystems, logdev replay).
+    run_start_phase("meta_service", [this]() { m_meta_service->start(m_dev_mgr->is_first_time_boot()); });
+    run_start_phase("cp_mgr", [this]() { m_cp_mgr->start(is_first_time_boot()); });
 
-    if (has_index_service()) { m_index_service->start(); }
+    if (has_index_service()) { run_start_phase("index_service", [this]() { m_index_service->start(); }); }
 
     if (has_repl_data_service()) {
-        s_cast< GenericReplService* >(m_repl_service.get())->start(); // Replservice starts logstore & data service
+        // Replservice starts logstore & data service
+        run_start_phase("repl_service", [this]() { s_cast< GenericReplService* >(m_repl_service.get())->start(); });
     } else {
-        if (has_data_service()) { m_data_service->start(); }
+        if (has_data_service()) { run_start_phase("data_service", [this]() { m_data_service->start(); }); }
         if (has_log_service() && inp_params.auto_recovery) {
             // In case of custom recovery, let consumer starts the recovery and it is consumer module's responsibilities
             // to start log store
-            m_log_service->start(is_first_time_boot() /* format */);
+            run_start_phase("log_service", [this]() { m_log_service->start(is_first_time_boot() /* format */); });
         }
     }
 
@@ -305,8 +310,10 @@ void HomeStore::do_start() {
     // boot going forward on next reboot.
     if (m_dev_mgr->is_first_time_boot()) {
         // Take the first CP after we have initialized all subsystems and wait for it to complete.
-        m_cp_mgr->trigger_cp_flush(true /* force */).get();
-        m_dev_mgr->commit_formatting();
+        run_start_phase("first_cp", [this]() {
+            m_cp_mgr->trigger_cp_flush(true /* force */).get();
+            m_dev_mgr->commit_formatting();
+        });
     }
 
     m_cp_mgr->start_timer();
@@ -315,6 +322,14 @@ void HomeStore::do_start() {
     m_init_done = true;
 }
 
+void HomeStore::run_start_phase(const std::string& name, const std::function< void() >& fn) {
+    auto const start_time = Clock::now();
+    fn();
+    auto const elapsed_ms = get_elapsed_time_ms(start_time);
+    m_start_phase_ms.emplace_back(name, elapsed_ms);
+    LOGINFO("HomeStore startup phase={} completed in {} ms", name, elapsed_ms);
+}
+
 void HomeStore::shutdown() {
     if (!m_init_done) {
         LOGWARN("Homestore shutdown is called before init is completed");
@@ -20,7 +20,9 @@
 #include "index/wb_cache.hpp"
 #include "index/index_cp.hpp"
 #include "common/homestore_utils.hpp"
+#include "common/iobuf_pool.hpp"
 #include "common/homestore_assert.hpp"
+#include "common/homestore_status_mgr.hpp"
 #include "device/virtual_dev.hpp"
 #include "device/physical_dev.hpp"
 #include "device/chunk.h"
@@ -121,15 +123,23 @@ void IndexService::start() {
     // Force taking cp after recovery done. This makes sure that the index table is in consistent state and dirty
     // buffer after recovery can be added to dirty list for flushing in the new cp
     hs()->cp_mgr().trigger_cp_flush(true /* force */);
+
+    hs()->status_mgr()->register_status_cb("IndexService", [this](int log_level) { return get_status(log_level); });
 }
 
-void IndexService::write_sb(uint32_t ordinal) {
-    if (is_stopping()) return;
+folly::Future< bool > IndexService::write_sb(uint32_t ordinal) {
+    if (is_stopping()) return folly::makeFuture< bool >(false);
     incr_pending_request_num();
-    std::unique_lock lg(m_index_map_mtx);
-    auto const it = m_ordinal_index_map.find(ordinal);
-    if (it != m_ordinal_index_map.cend()) { it->second->update_sb(); }
-    decr_pending_request_num();
+    auto fut = folly::makeFuture< bool >(false);
+    {
+        std::unique_lock lg(m_index_map_mtx);
+        auto const it = m_ordinal_index_map.find(ordinal);
+        if (it != m_ordinal_index_map.cend()) { fut = it->second->update_sb(); }
+    }
+    return std::move(fut).thenValue([this](bool persisted) {
+        decr_pending_request_num();
+        return persisted;
+    });
 }
 
 IndexService::~IndexService() { m_wb_cache.reset(); }
@@ -143,6 +153,7 @@ bool IndexService::sanity_check(const uint32_t index_ordinal, const IndexBufferP
 }
 
 void IndexService::stop() {
+    hs()->status_mgr()->deregister_status_cb("IndexService");
     start_stopping();
     while (true) {
         if (!get_pending_request_num()) break;
@@ -241,6 +252,20 @@ uint64_t IndexService::used_size() const {
     return size;
 }
 
+nlohmann::json IndexService::get_status(int log_level) const {
+    nlohmann::json j;
+    if (is_stopping()) return j;
+    incr_pending_request_num();
+    {
+        std::unique_lock lg{m_index_map_mtx};
+        for (auto& [ordinal, table] : m_ordinal_index_map) {
+            j[std::to_string(ordinal)] = table->get_status(log_level);
+        }
+    }
+    decr_pending_request_num();
+    return j;
+}
+
 /////////////////////// IndexBuffer methods //////////////////////////
 IndexBuffer::IndexBuffer(BlkId blkid, uint32_t buf_size, uint32_t align_size) :
         m_blkid{blkid}, m_bytes{hs_utils::iobuf_alloc(buf_size, sisl::buftag::btree_node, align_size)} {}
@@ -346,13 +371,15 @@ MetaIndexBuffer::MetaIndexBuffer(superblk< index_table_sb >& sb) : IndexBuffer{n
 MetaIndexBuffer::MetaIndexBuffer(shared< MetaIndexBuffer > const& other) :
         IndexBuffer{nullptr, BlkId{}}, m_sb{other->m_sb} {
     m_is_meta_buf = true;
-    m_bytes = hs_utils::iobuf_alloc(m_sb.size(), sisl::buftag::metablk, meta_service().align_size());
+    // A copy is made for every table on every cp, so take it from the io buf pool
+    m_buf_size = m_sb.size();
+    m_bytes = IOBufPool::alloc(m_buf_size, meta_service().align_size());
     copy_sb_to_buf();
 }
 
 MetaIndexBuffer::~MetaIndexBuffer() {
     if (m_bytes) {
-        hs_utils::iobuf_free(m_bytes, sisl::buftag::metablk);
+        IOBufPool::free(m_bytes, m_buf_size);
         m_bytes = nullptr;
     }
     m_valid = false;
@@ -858,20 +858,36 @@ folly::Future< bool > IndexWBCache::async_cp_flush(IndexCPContext* cp_ctx) {
 
     cp_ctx->prepare_flush_iteration();
     m_updated_ordinals.clear();
-    for (auto& fiber : m_cp_flush_fibers) {
-        iomanager.run_on_forget(fiber, [this, cp_ctx]() {
+    prepare_flush_queues();
+    m_cp_flush_start_time = Clock::now();
+    m_cp_flush_bytes.store(0);
+
+    // Use as many flush fibers as the tables which has dirty buffers (upto the number of fibers configured). Each fiber
+    // issues its share of the initial queue depth and the completions of those writes are processed in that fiber's
+    // reactor, which in turn issues the follow up writes.
+    auto const nfibers = std::min(uint32_cast(m_cp_flush_fibers.size()), std::max(1u, num_dirty_ordinals(cp_ctx)));
+    auto const total_qd = resource_mgr().get_dirty_buf_qd() * uint32_cast(m_flush_dev_queues.size());
+    auto const per_fiber_qd = std::max(1u, total_qd / nfibers);
+    GAUGE_UPDATE(m_metrics, cp_flush_fibers, nfibers);
+
+    for (uint32_t i{0}; i < nfibers; ++i) {
+        iomanager.run_on_forget(m_cp_flush_fibers[i], [this, cp_ctx, per_fiber_qd]() {
             IndexBufferPtrList buf_list;
-            get_next_bufs(cp_ctx, resource_mgr().get_dirty_buf_qd(), buf_list);
-
-            for (auto& buf : buf_list) {
-                do_flush_one_buf(cp_ctx, buf, true);
-            }
-            m_vdev->submit_batch();
+            get_next_bufs(cp_ctx, per_fiber_qd, buf_list);
+            flush_bufs(cp_ctx, buf_list);
         });
     }
     return cp_ctx->get_future();
 }
 
+void IndexWBCache::flush_bufs(IndexCPContext* cp_ctx, IndexBufferPtrList const& bufs) {
+    if (bufs.empty()) { return; }
+    for (auto const& buf : bufs) {
+        do_flush_one_buf(cp_ctx, buf, true /* part_of_batch */);
+    }
+    m_vdev->submit_batch();
+}
+
 void IndexWBCache::do_flush_one_buf(IndexCPContext* cp_ctx, IndexBufferPtr const& buf, bool part_of_batch) {
     static std::once_flag flag;
 #ifdef _PRERELEASE
@@ -897,7 +913,14 @@ void IndexWBCache::do_flush_one_buf(IndexCPContext* cp_ctx, IndexBufferPtr const
         if (sb_buf->m_valid) {
             auto const& sb = sb_buf->m_sb;
             if (!sb.is_empty()) {
-                meta_service().update_sub_sb(buf->m_bytes, sb.size(), sb.meta_blk());
+                // Completion is processed back in this flush fiber once the sb is persisted
+                meta_service()
+                    .async_update_sub_sb(buf->m_bytes, sb.size(), sb.meta_blk())
+                    .thenValue([this, cp_ctx, buf, fiber = iomanager.iofiber_self()](bool) {
+                        iomanager.run_on_forget(fiber,
+                                                [this, cp_ctx, buf]() { process_write_completion(cp_ctx, buf); });
+                    });
+                return;
             } else {
                 LOGTRACEMOD(wbcache, "Skipping flushing meta buf {} as sb is empty", buf->to_string());
             }
@@ -914,6 +937,7 @@ void IndexWBCache::do_flush_one_buf(IndexCPContext* cp_ctx, IndexBufferPtr const
             LOGTRACEMOD(wbcache, "Flushing cp {} new node buf {} blkid {}", cp_ctx->id(), buf->to_string(),
                         buf->blkid().to_string());
         }
+        m_cp_flush_bytes.fetch_add(m_node_size, std::memory_order_relaxed);
         m_vdev->async_write(r_cast< const char* >(buf->raw_buffer()), m_node_size, buf->m_blkid, part_of_batch)
             .thenValue([buf, cp_ctx](auto) {
                 try {
@@ -941,41 +965,54 @@ void IndexWBCache::process_write_completion(IndexCPContext* cp_ctx, IndexBufferP
     LOGTRACEMOD(wbcache, "cp {} completed flushed for buf {} blkid {}", cp_ctx->id(), buf->to_string(),
                 buf->blkid().to_string());
     resource_mgr().dec_dirty_buf_size(m_node_size);
-    m_updated_ordinals.insert(buf->m_index_ordinal);
-    auto [next_buf, has_more] = on_buf_flush_done(cp_ctx, buf);
-    if (next_buf) {
-        do_flush_one_buf(cp_ctx, next_buf, false);
+
+    IndexBufferPtrList next_bufs;
+    bool has_more;
+    {
+        std::unique_lock lg(m_flush_mtx);
+        m_updated_ordinals.insert(buf->m_index_ordinal);
+        has_more = on_buf_flush_done(cp_ctx, buf, next_bufs);
+    }
+
+    if (!next_bufs.empty()) {
+        // Submit all the follow up buffers that became ready as one batch
+        flush_bufs(cp_ctx, next_bufs);
     } else if (!has_more) {
+        auto const flush_time_us = get_elapsed_time_us(m_cp_flush_start_time);
+        auto const flush_bytes = m_cp_flush_bytes.load();
+        auto const bandwidth_mbps = (flush_bytes * 1000000) / (std::max(flush_time_us, 1ul) * 1024 * 1024);
+        COUNTER_INCREMENT(m_metrics, cp_flush_bufs, flush_bytes / m_node_size);
+        COUNTER_INCREMENT(m_metrics, cp_flush_bytes, flush_bytes);
+        GAUGE_UPDATE(m_metrics, cp_flush_bandwidth_mbps, bandwidth_mbps);
+        HISTOGRAM_OBSERVE(m_metrics, cp_flush_latency_us, flush_time_us);
+        CP_PERIODIC_LOG(INFO, unmove(cp_ctx->id()), "Index flush wrote {} bytes to {} devices in {} us, bw={} MB/s",
+                        flush_bytes, m_flush_dev_queues.size(), flush_time_us, bandwidth_mbps);
+
+        // Sbs of all the updated tables are written asynchronously, which meta service coalesces into few passes
+        std::vector< folly::Future< bool > > sb_futs;
+        sb_futs.reserve(m_updated_ordinals.size());
         for (const auto& ordinal : m_updated_ordinals) {
             LOGTRACEMOD(wbcache, "Updating sb for ordinal {}", ordinal);
-            index_service().write_sb(ordinal);
+            sb_futs.emplace_back(index_service().write_sb(ordinal));
         }
 
         // We are done flushing the buffers, We flush the vdev to persist the vdev bitmaps and free blks
         // Pick a CP Manager blocking IO fiber to execute the cp flush of vdev
-        iomanager.run_on_forget(cp_mgr().pick_blocking_io_fiber(), [this, cp_ctx]() {
-            auto cp_id = cp_ctx->id();
-            LOGTRACEMOD(wbcache, "Initiating CP {} flush", cp_id);
-            m_vdev->cp_flush(cp_ctx); // This is a blocking io call
-            LOGTRACEMOD(wbcache, "CP {} freed blkids: \n{}", cp_id, cp_ctx->to_string_free_list());
-            cp_ctx->complete(true);
-            LOGTRACEMOD(wbcache, "Completed CP {} flush", cp_id);
+        folly::collectAllUnsafe(sb_futs).thenValue([this, cp_ctx](auto&&) {
+            iomanager.run_on_forget(cp_mgr().pick_blocking_io_fiber(), [this, cp_ctx]() {
+                auto cp_id = cp_ctx->id();
+                LOGTRACEMOD(wbcache, "Initiating CP {} flush", cp_id);
+                m_vdev->cp_flush(cp_ctx); // This is a blocking io call
+                LOGTRACEMOD(wbcache, "CP {} freed blkids: \n{}", cp_id, cp_ctx->to_string_free_list());
+                cp_ctx->complete(true);
+                LOGTRACEMOD(wbcache, "Completed CP {} flush", cp_id);
+            });
         });
     }
 }
 
-std::pair< IndexBufferPtr, bool > IndexWBCache::on_buf_flush_done(IndexCPContext* cp_ctx, IndexBufferPtr const& buf) {
-    if (m_cp_flush_fibers.size() > 1) {
-        std::unique_lock lg(m_flush_mtx);
-        return on_buf_flush_done_internal(cp_ctx, buf);
-    } else {
-        return on_buf_flush_done_internal(cp_ctx, buf);
-    }
-}
-
-std::pair< IndexBufferPtr, bool > IndexWBCache::on_buf_flush_done_internal(IndexCPContext* cp_ctx,
-                                                                           IndexBufferPtr const& buf) {
-    IndexBufferPtrList buf_list;
+// Expected to be called with m_flush_mtx held
+bool IndexWBCache::on_buf_flush_done(IndexCPContext* cp_ctx, IndexBufferPtr const& buf, IndexBufferPtrList& next_bufs) {
 #ifndef NDEBUG
     {
         std::lock_guard lg(buf->m_down_buffers_mtx);
@@ -983,30 +1020,60 @@ std::pair< IndexBufferPtr, bool > IndexWBCache::on_buf_flush_done_internal(Index
     }
 #endif
 
+    auto& dq = flush_dev_queue(buf);
+    HS_DBG_ASSERT_GT(dq.outstanding, 0, "Flush completed on a device without any outstanding writes");
+    --dq.outstanding;
+
     if (cp_ctx->m_dirty_buf_count.decrement_testz()) {
         buf->set_state(index_buf_state_t::CLEAN);
-        return std::make_pair(nullptr, false);
+        return false;
     } else {
-        get_next_bufs_internal(cp_ctx, 1u, buf, buf_list);
+        get_next_bufs_internal(cp_ctx, std::numeric_limits< uint32_t >::max(), buf, next_bufs);
         buf->set_state(index_buf_state_t::CLEAN);
-        return std::make_pair((buf_list.size() ? buf_list[0] : nullptr), true);
+        return true;
     }
 }
 
-void IndexWBCache::get_next_bufs(IndexCPContext* cp_ctx, uint32_t max_count, IndexBufferPtrList& bufs) {
-    if (m_cp_flush_fibers.size() > 1) {
-        std::unique_lock lg(m_flush_mtx);
-        get_next_bufs_internal(cp_ctx, max_count, nullptr, bufs);
-    } else {
-        get_next_bufs_internal(cp_ctx, max_count, nullptr, bufs);
+void IndexWBCache::prepare_flush_queues() {
+    std::unique_lock lg(m_flush_mtx);
+    std::unordered_map< PhysicalDev const*, uint32_t > pdev_to_queue;
+    m_chunk_to_dev_queue.clear();
+    for (auto const& [chunk_num, chunk] : m_vdev->get_chunks()) {
+        auto const [it, inserted] = pdev_to_queue.insert({chunk->physical_dev(), uint32_cast(pdev_to_queue.size())});
+        m_chunk_to_dev_queue[chunk_num] = it->second;
     }
+
+    m_flush_dev_queues.clear();
+    m_flush_dev_queues.resize(std::max(1ul, pdev_to_queue.size()));
+    m_dirty_list_exhausted = false;
+}
+
+IndexWBCache::FlushDevQueue& IndexWBCache::flush_dev_queue(IndexBufferPtr const& buf) {
+    // Meta buffers and any buffer outside of known chunks are accounted against the first device
+    auto const it = m_chunk_to_dev_queue.find(buf->m_blkid.chunk_num());
+    return m_flush_dev_queues[(it == m_chunk_to_dev_queue.end()) ? 0 : it->second];
+}
+
+uint32_t IndexWBCache::num_dirty_ordinals(IndexCPContext* cp_ctx) const {
+    std::unordered_set< uint32_t > ordinals;
+    for (auto it = cp_ctx->m_dirty_buf_list.begin(); it != cp_ctx->m_dirty_buf_list.end(); ++it) {
+        ordinals.insert((*it)->m_index_ordinal);
+    }
+    return uint32_cast(ordinals.size());
 }
 
+void IndexWBCache::get_next_bufs(IndexCPContext* cp_ctx, uint32_t max_count, IndexBufferPtrList& bufs) {
+    std::unique_lock lg(m_flush_mtx);
+    get_next_bufs_internal(cp_ctx, max_count, nullptr, bufs);
+}
+
+// Expected to be called with m_flush_mtx held
 void IndexWBCache::get_next_bufs_internal(IndexCPContext* cp_ctx, uint32_t max_count,
                                           IndexBufferPtr const& prev_flushed_buf, IndexBufferPtrList& bufs) {
     uint32_t count{0};
+    auto const qd = std::max(1u, resource_mgr().get_dirty_buf_qd());
 
-    // First attempt to execute any follower buffer flush
+    // First queue any follower buffer, which is now ready to flush
     if (prev_flushed_buf) {
         auto next_buffer = prev_flushed_buf->m_up_buffer;
         if (next_buffer && next_buffer->m_wait_for_down_buffers.decrement_testz()) {
@@ -1014,8 +1081,7 @@ void IndexWBCache::get_next_bufs_internal(IndexCPContext* cp_ctx, uint32_t max_c
                           "Trying to flush a up_buffer after down buffer is completed, but up_buffer is "
                           "not in dirty state, but in {} state",
                           (int)next_buffer->state());
-            bufs.emplace_back(next_buffer);
-            ++count;
+            flush_dev_queue(next_buffer).ready_bufs.emplace_back(next_buffer);
         }
 #ifndef NDEBUG
         // Retain prev up buffer for debugging purposes
@@ -1024,18 +1090,43 @@ void IndexWBCache::get_next_bufs_internal(IndexCPContext* cp_ctx, uint32_t max_c
         prev_flushed_buf->m_up_buffer.reset();
     }
 
-    // If we still have room to push the next buffer, take it from the main list
-    while (count < max_count) {
+    // Issue the ready buffers to all the devices which has room in their queue depth
+    for (auto& dq : m_flush_dev_queues) {
+        while ((count < max_count) && (dq.outstanding < qd) && !dq.ready_bufs.empty()) {
+            bufs.emplace_back(std::move(dq.ready_bufs.front()));
+            dq.ready_bufs.pop_front();
+            ++dq.outstanding;
+            ++count;
+        }
+    }
+
+    // If some device still has room, pick the next buffers from the main list. Buffers of the devices which are full,
+    // are queued and will be issued on completion of writes on that device.
+    auto const any_room = [this, qd]() {
+        return std::any_of(m_flush_dev_queues.cbegin(), m_flush_dev_queues.cend(),
+                           [qd](FlushDevQueue const& dq) { return dq.outstanding < qd; });
+    };
+
+    while ((count < max_count) && !m_dirty_list_exhausted && any_room()) {
         std::optional< IndexBufferPtr > buf = cp_ctx->next_dirty();
-        if (!buf) { break; } // End of list
+        if (!buf) {
+            m_dirty_list_exhausted = true;
+            break;
+        }
 
         // If a buffer is reused during overlapping cp, there is a possibility that
         // the buffer which is already flushed in cp x is dirtied by cp x + 1
         // and is picked up again to flush by cp x through this code path.
         if ((*buf)->state() == index_buf_state_t::DIRTY && (*buf)->m_dirtied_cp_id == cp_ctx->id() &&
             (*buf)->m_wait_for_down_buffers.testz()) {
-            bufs.emplace_back(std::move(*buf));
-            ++count;
+            auto& dq = flush_dev_queue(*buf);
+            if (dq.outstanding < qd) {
+                ++dq.outstanding;
+                bufs.emplace_back(std::move(*buf));
+                ++count;
+            } else {
+                dq.ready_bufs.emplace_back(std::move(*buf));
+            }
         } else {
             // There is some leader buffer still flushing, once done its completion will flush this buffer
         }
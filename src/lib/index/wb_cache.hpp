@@ -14,6 +14,7 @@
  *
  *********************************************************************************/
 #pragma once
+#include <deque>
 #include <memory>
 
 #include <iomgr/iomgr.hpp>
@@ -32,8 +33,34 @@ class Evictor;
 namespace homestore {
 class VirtualDev;
 
+class IndexWBCacheMetrics : public sisl::MetricsGroup {
+public:
+    explicit IndexWBCacheMetrics() : sisl::MetricsGroup("index_wb_cache", "index_wb_cache") {
+        REGISTER_COUNTER(cp_flush_bufs, "Total index buffers written as part of cp flush");
+        REGISTER_COUNTER(cp_flush_bytes, "Total index bytes written as part of cp flush");
+        REGISTER_GAUGE(cp_flush_bandwidth_mbps, "Index write bandwidth in MB/s of the last cp flush");
+        REGISTER_GAUGE(cp_flush_fibers, "Number of fibers used to flush the last cp");
+        REGISTER_HISTOGRAM(cp_flush_latency_us, "Time taken to write all dirty index buffers of a cp",
+                           HistogramBucketsType(OpLatecyBuckets));
+        register_me_to_farm();
+    }
+
+    IndexWBCacheMetrics(const IndexWBCacheMetrics&) = delete;
+    IndexWBCacheMetrics(IndexWBCacheMetrics&&) noexcept = delete;
+    IndexWBCacheMetrics& operator=(const IndexWBCacheMetrics&) = delete;
+    IndexWBCacheMetrics& operator=(const IndexWBCacheMetrics&&) noexcept = delete;
+    ~IndexWBCacheMetrics() { deregister_me_from_farm(); }
+};
+
 class IndexWBCache : public IndexWBCacheBase {
 private:
+    // Flush state of a physical device during cp flush. Writes are issued to a device as long as it has less than
+    // dirty_buf_qd writes outstanding, rest of the ready buffers wait in the queue for completions on that device.
+    struct FlushDevQueue {
+        uint32_t outstanding{0};
+        std::deque< IndexBufferPtr > ready_bufs;
+    };
+
     std::shared_ptr< VirtualDev > m_vdev;
     sisl::SimpleCache< BlkId, BtreeNodePtr > m_cache;
     uint32_t m_node_size;
@@ -43,6 +70,15 @@ private:
     bool m_in_recovery{false};
     std::unordered_set< uint32_t > m_updated_ordinals;
 
+    // All the below are protected by m_flush_mtx and reset at the start of every cp flush
+    std::vector< FlushDevQueue > m_flush_dev_queues;
+    std::unordered_map< chunk_num_t, uint32_t > m_chunk_to_dev_queue;
+    bool m_dirty_list_exhausted{false};
+
+    Clock::time_point m_cp_flush_start_time;
+    std::atomic< uint64_t > m_cp_flush_bytes{0};
+    IndexWBCacheMetrics m_metrics;
+
 public:
     IndexWBCache(const std::shared_ptr< VirtualDev >& vdev, std::pair< meta_blk*, sisl::byte_view > sb,
                  const std::shared_ptr< sisl::Evictor >& evictor, uint32_t node_size);
@@ -75,11 +111,14 @@ private:
     void recover_new_nodes(sisl::byte_view sb);
     void process_write_completion(IndexCPContext* cp_ctx, IndexBufferPtr const& pbuf);
     void do_flush_one_buf(IndexCPContext* cp_ctx, IndexBufferPtr const& buf, bool part_of_batch);
+    void flush_bufs(IndexCPContext* cp_ctx, IndexBufferPtrList const& bufs);
     void link_buf(IndexBufferPtr const& up, IndexBufferPtr const& down, bool is_sibling_link, CPContext* cp_ctx);
 
-    std::pair< IndexBufferPtr, bool > on_buf_flush_done(IndexCPContext* cp_ctx, IndexBufferPtr const& buf);
-    std::pair< IndexBufferPtr, bool > on_buf_flush_done_internal(IndexCPContext* cp_ctx, IndexBufferPtr const& buf);
+    bool on_buf_flush_done(IndexCPContext* cp_ctx, IndexBufferPtr const& buf, IndexBufferPtrList& next_bufs);
 
+    void prepare_flush_queues();
+    FlushDevQueue& flush_dev_queue(IndexBufferPtr const& buf);
+    uint32_t num_dirty_ordinals(IndexCPContext* cp_ctx) const;
     void get_next_bufs(IndexCPContext* cp_ctx, uint32_t max_count, IndexBufferPtrList& bufs);
     void get_next_bufs_internal(IndexCPContext* cp_ctx, uint32_t max_count, IndexBufferPtr const& prev_flushed_buf,
                                 IndexBufferPtrList& bufs);
@@ -31,6 +31,7 @@
 #include "common/homestore_assert.hpp"
 #include "common/homestore_config.hpp"
 #include "common/homestore_utils.hpp"
+#include "common/iobuf_pool.hpp"
 #include "common/crash_simulator.hpp"
 #include "replication/service/generic_repl_svc.h"
 
@@ -293,6 +294,8 @@ log_buffer LogDev::read(const logdev_key& key) {
     if (is_stopping()) return -1;
     incr_pending_request_num();
     std::unique_lock lg = flush_guard();
+    // Unlike read_record_header, the header buffer is not from IOBufPool: a record within it is returned as a view
+    // into it, which outlives this call, so it can't go back to the pool here.
     auto buf = sisl::make_byte_array(initial_read_size, m_flush_size_multiple, sisl::buftag::logread);
     auto ec = m_vdev_jd->sync_pread(buf->bytes(), initial_read_size, key.dev_offset);
     if (ec) {
@@ -324,11 +327,11 @@ void LogDev::read_record_header(const logdev_key& key, serialized_log_record& re
     if (is_stopping()) return;
     incr_pending_request_num();
     std::unique_lock lg = flush_guard();
-    auto buf = sisl::make_byte_array(initial_read_size, m_flush_size_multiple, sisl::buftag::logread);
-    auto ec = m_vdev_jd->sync_pread(buf->bytes(), initial_read_size, key.dev_offset);
+    pooled_iobuf buf{initial_read_size, m_flush_size_multiple};
+    auto ec = m_vdev_jd->sync_pread(buf.bytes(), initial_read_size, key.dev_offset);
     if (ec) LOGERROR("Failed to read from Journal vdev log_dev={} {} {}", m_logdev_id, ec.value(), ec.message());
 
-    auto* header = r_cast< const log_group_header* >(buf->cbytes());
+    auto* header = r_cast< const log_group_header* >(buf.cbytes());
     verify_log_group_header(key.idx, header);
 
     auto record_header = header->nth_record(key.idx - header->start_log_idx);
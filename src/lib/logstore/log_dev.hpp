@@ -236,6 +236,8 @@ public:
     static constexpr uint32_t optimal_num_records{16};
     static constexpr uint32_t estimated_iovs{10};
     static constexpr size_t inline_log_buf_size{512 * optimal_num_records};
+    // Number of groups after which the log buffer is shrunk, if none of them needed more than half of it
+    static constexpr uint32_t log_buf_shrink_window{1024};
     static constexpr uint32_t max_records_in_a_batch{(initial_read_size - sizeof(log_group_header)) /
                                                      sizeof(serialized_log_record)};
 
@@ -251,7 +253,7 @@ public:
     void start(const uint64_t flush_size_multiple, const uint32_t align_size);
     void stop();
     void reset(const uint32_t max_records);
-    void create_overflow_buf(const uint32_t min_needed);
+    void grow_log_buf(const uint32_t min_needed);
     bool add_record(log_record& record, const int64_t log_idx);
     bool can_accomodate(const log_record& record) const { return (m_nrecords <= m_max_records); }
 
@@ -269,17 +271,24 @@ public:
     auto flush_log_idx_upto() const { return m_flush_log_idx_upto; }
     auto log_dev_offset() const { return m_log_dev_offset; }
 
+    // Log buffer is retained across groups at the largest size needed by recent groups, so that groups with large
+    // inlined data don't reallocate and copy the buffer on every flush
     sisl::aligned_unique_ptr< uint8_t, sisl::buftag::logwrite > m_log_buf;
     sisl::aligned_unique_ptr< uint8_t, sisl::buftag::logwrite > m_footer_buf;
-    sisl::aligned_unique_ptr< uint8_t, sisl::buftag::logwrite > m_overflow_log_buf;
 
     uint8_t* m_cur_log_buf;
     uint32_t m_cur_buf_len;
     uint32_t m_footer_buf_len;
+    uint32_t m_align_size{0};
+    uint32_t m_window_max_len{0}; // Largest log buffer length needed by groups in the current shrink window
+    uint32_t m_window_ngroups{0};
 
     serialized_log_record* m_record_slots;
+    uint32_t m_inline_data_start;
     uint32_t m_inline_data_pos;
     uint32_t m_oob_data_pos;
+    crc32_t m_inline_data_crc; // crc of the inline data added so far
+    crc32_t m_oob_data_crc;    // crc of the out of band data added so far
 
     uint32_t m_nrecords{0};
     uint32_t m_max_records{0};
@@ -296,6 +305,7 @@ public:
 private:
     log_group_footer* add_and_get_footer();
     bool new_iovec_for_footer() const;
+    crc32_t finish_crc() const;
 };
 } // namespace homestore
 
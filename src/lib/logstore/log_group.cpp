@@ -16,16 +16,34 @@
 #include <cstring>
 
 #include <homestore/logstore/log_store.hpp>
+#include <homestore/logstore_service.hpp>
 #include "common/homestore_assert.hpp"
+#include "crc_impl.h"
 #include "log_dev.hpp"
 
 namespace homestore {
 SISL_LOGGING_DECL(logstore)
 
+// Copies the record to the group buffer and accumulates its crc in the same pass, a few KB at a time, so that the crc
+// reads the bytes just copied from the cache instead of walking the whole group buffer again at finish.
+static crc32_t copy_with_crc(uint8_t* dst, const uint8_t* src, size_t len, crc32_t crc) {
+    static constexpr size_t stride{4096};
+    while (len) {
+        auto const n = std::min(len, stride);
+        std::memcpy(s_cast< void* >(dst), s_cast< const void* >(src), n);
+        crc = crc32_ieee(crc, dst, n);
+        dst += n;
+        src += n;
+        len -= n;
+    }
+    return crc;
+}
+
 LogGroup::LogGroup() = default;
 void LogGroup::start(const uint64_t flush_multiple_size, const uint32_t align_size) {
     m_iovecs.reserve(estimated_iovs);
     m_flush_multiple_size = flush_multiple_size;
+    m_align_size = align_size;
 
     // TO DO: Might need to differentiate based on data or fast type
     m_cur_buf_len = sisl::round_up(inline_log_buf_size, flush_multiple_size);
@@ -38,18 +56,30 @@ void LogGroup::start(const uint64_t flush_multiple_size, const uint32_t align_si
 
 void LogGroup::stop() {
     m_log_buf.reset();
-    m_overflow_log_buf.reset();
     m_footer_buf.reset();
 }
 
 void LogGroup::reset(const uint32_t max_records) {
-    m_cur_buf_len = sisl::round_up(inline_log_buf_size, m_flush_multiple_size);
+    if (++m_window_ngroups == log_buf_shrink_window) {
+        // Shrink the buffer back if it has grown for a few large groups, but the recent ones didn't need as much
+        auto const needed = sisl::round_up(std::max(m_window_max_len, uint32_cast(inline_log_buf_size)),
+                                           m_flush_multiple_size);
+        if (needed * 2 <= m_cur_buf_len) {
+            m_log_buf = sisl::aligned_unique_ptr< uint8_t, sisl::buftag::logwrite >::make_sized(m_align_size, needed);
+            m_cur_buf_len = needed;
+            COUNTER_INCREMENT(logstore_service().metrics(), logdev_group_buf_shrink_count, 1);
+        }
+        m_window_ngroups = 0;
+        m_window_max_len = 0;
+    }
     m_cur_log_buf = m_log_buf.get();
     m_record_slots = reinterpret_cast< serialized_log_record* >(m_cur_log_buf + sizeof(log_group_header));
     m_inline_data_pos = sizeof(log_group_header) + (sizeof(serialized_log_record) * max_records);
+    m_inline_data_start = m_inline_data_pos;
     m_oob_data_pos = 0;
+    m_inline_data_crc = init_crc32;
+    m_oob_data_crc = init_crc32;
 
-    m_overflow_log_buf = nullptr;
     m_nrecords = 0;
     m_max_records = std::min(max_records, max_records_in_a_batch);
     m_actual_data_size = 0;
@@ -58,14 +88,18 @@ void LogGroup::reset(const uint32_t max_records) {
     m_iovecs.emplace_back(static_cast< void* >(m_cur_log_buf), m_inline_data_pos);
 }
 
-void LogGroup::create_overflow_buf(const uint32_t min_needed) {
+void LogGroup::grow_log_buf(const uint32_t min_needed) {
     auto const new_len = sisl::round_up(std::max(min_needed, m_cur_buf_len * 2), m_flush_multiple_size);
-    auto new_buf =
-        sisl::aligned_unique_ptr< uint8_t, sisl::buftag::logwrite >::make_sized(m_flush_multiple_size, new_len);
-    std::memcpy(s_cast< void* >(new_buf.get()), s_cast< const void* >(m_cur_log_buf), m_cur_buf_len);
+    auto new_buf = sisl::aligned_unique_ptr< uint8_t, sisl::buftag::logwrite >::make_sized(m_align_size, new_len);
+
+    // Only the part filled so far needs to be copied
+    auto const copy_len = std::min(m_inline_data_pos, m_cur_buf_len);
+    std::memcpy(s_cast< void* >(new_buf.get()), s_cast< const void* >(m_cur_log_buf), copy_len);
+    COUNTER_INCREMENT(logstore_service().metrics(), logdev_group_buf_grow_count, 1);
+    COUNTER_INCREMENT(logstore_service().metrics(), logdev_group_buf_grow_copied_bytes, copy_len);
 
-    m_overflow_log_buf = std::move(new_buf);
-    m_cur_log_buf = m_overflow_log_buf.get();
+    m_log_buf = std::move(new_buf);
+    m_cur_log_buf = m_log_buf.get();
     m_cur_buf_len = new_len;
     m_record_slots = r_cast< serialized_log_record* >(m_cur_log_buf + sizeof(log_group_header));
 
@@ -82,7 +116,7 @@ bool LogGroup::add_record(log_record& record, const int64_t log_idx) {
 
     m_actual_data_size += record.data.size();
     if ((m_inline_data_pos + record.data.size()) >= m_cur_buf_len) {
-        create_overflow_buf(m_inline_data_pos + record.data.size());
+        grow_log_buf(m_inline_data_pos + record.data.size());
     }
 
     // We use log_idx reference in the header as we expect each slot record is in order.
@@ -97,8 +131,8 @@ bool LogGroup::add_record(log_record& record, const int64_t log_idx) {
     if (record.is_inlineable(m_flush_multiple_size)) {
         m_record_slots[m_nrecords].offset = m_inline_data_pos;
         m_record_slots[m_nrecords].set_inlined(true);
-        std::memcpy(s_cast< void* >(m_cur_log_buf + m_inline_data_pos), s_cast< const void* >(record.data.cbytes()),
-                    record.data.size());
+        m_inline_data_crc = copy_with_crc(m_cur_log_buf + m_inline_data_pos, record.data.cbytes(), record.data.size(),
+                                          m_inline_data_crc);
         m_inline_data_pos += record.data.size();
         m_iovecs[0].iov_len = m_inline_data_pos;
     } else {
@@ -106,6 +140,7 @@ bool LogGroup::add_record(log_record& record, const int64_t log_idx) {
         m_record_slots[m_nrecords].offset = m_oob_data_pos;
         m_record_slots[m_nrecords].set_inlined(false);
         m_iovecs.emplace_back(s_cast< void* >(record.data.bytes()), record.data.size());
+        m_oob_data_crc = crc32_ieee(m_oob_data_crc, record.data.cbytes(), record.data.size());
         m_oob_data_pos += record.data.size();
     }
     ++m_nrecords;
@@ -122,6 +157,7 @@ const iovec_array& LogGroup::finish(logdev_id_t logdev_id, const crc32_t prev_cr
     auto footer = add_and_get_footer();
 
     m_iovecs[0].iov_len = sisl::round_up(m_iovecs[0].iov_len, m_flush_multiple_size);
+    m_window_max_len = std::max(m_window_max_len, uint32_cast(m_iovecs[0].iov_len));
 
     log_group_header* hdr = new (header()) log_group_header{};
     hdr->logdev_id = logdev_id;
@@ -138,17 +174,18 @@ const iovec_array& LogGroup::finish(logdev_id_t logdev_id, const crc32_t prev_cr
     }
     HS_DBG_ASSERT_LE((hdr->footer_offset + sizeof(log_group_footer)), hdr->group_size);
 
+    footer->start_log_idx = hdr->start_log_idx;
+    hdr->cur_grp_crc = finish_crc();
+
 #ifndef NDEBUG
     uint64_t len = 0;
     for (auto const& iv : m_iovecs) {
         len += iv.iov_len;
     }
     HS_DBG_ASSERT_EQ(hdr->group_size, len, "length is not same");
+    HS_DBG_ASSERT_EQ(hdr->cur_grp_crc, compute_crc(), "incrementally computed crc mismatch");
 #endif
 
-    footer->start_log_idx = hdr->start_log_idx;
-    hdr->cur_grp_crc = compute_crc();
-
     return m_iovecs;
 }
 
@@ -165,6 +202,21 @@ log_group_footer* LogGroup::add_and_get_footer() {
     return footer;
 }
 
+crc32_t LogGroup::finish_crc() const {
+    // Same as compute_crc, but the crc of inline and out of band data is already accumulated by add_record. So only
+    // the record slots ahead of the inline data and the footer/padding after it need to be read here.
+    auto const base = static_cast< const unsigned char* >(m_iovecs[0].iov_base);
+    crc32_t crc =
+        crc32_ieee(init_crc32, base + sizeof(log_group_header), m_inline_data_start - sizeof(log_group_header));
+    crc = crc::crc32_ieee_combine(crc, m_inline_data_crc, m_inline_data_pos - m_inline_data_start, init_crc32);
+    crc = crc32_ieee(crc, base + m_inline_data_pos, m_iovecs[0].iov_len - m_inline_data_pos);
+    crc = crc::crc32_ieee_combine(crc, m_oob_data_crc, m_oob_data_pos, init_crc32);
+    if (m_iovecs.back().iov_base == m_footer_buf.get()) {
+        crc = crc32_ieee(crc, m_footer_buf.get(), m_footer_buf_len);
+    }
+    return crc;
+}
+
 crc32_t LogGroup::compute_crc() {
     crc32_t crc =
         crc32_ieee(init_crc32, static_cast< const unsigned char* >(m_iovecs[0].iov_base) + sizeof(log_group_header),
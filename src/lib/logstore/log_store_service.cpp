@@ -27,6 +27,7 @@
 
 #include "common/homestore_assert.hpp"
 #include "common/homestore_status_mgr.hpp"
+#include "common/homestore_utils.hpp"
 #include "device/journal_vdev.hpp"
 #include "device/physical_dev.hpp"
 #include "log_dev.hpp"
@@ -114,9 +115,31 @@ void LogStoreService::start(bool format) {
     // Create an truncate thread loop which handles truncation which does sync IO
     start_threads();
 
+    // Logdevs are independent of each other, so during recovery they are loaded and replayed in parallel.
+    std::vector< std::shared_ptr< LogDev > > logdevs;
     for (auto& [logdev_id, logdev] : m_id_logdev_map) {
-        logdev->start(format, m_logdev_vdev);
+        logdevs.push_back(logdev);
     }
+
+    std::vector< uint64_t > start_ms(logdevs.size(), 0);
+    auto const start_time = Clock::now();
+    auto const nthreads = format ? 1u : HS_DYNAMIC_CONFIG(generic.recovery_threads);
+    hs_utils::parallel_for(logdevs.size(), nthreads, [&](size_t i) {
+        auto const logdev_start_time = Clock::now();
+        logdevs[i]->start(format, m_logdev_vdev);
+        start_ms[i] = get_elapsed_time_ms(logdev_start_time);
+    });
+
+    for (size_t i{0}; i < logdevs.size(); ++i) {
+        m_logdev_start_ms.emplace(logdevs[i]->get_id(), start_ms[i]);
+    }
+    m_start_ms = get_elapsed_time_ms(start_time);
+    LOGINFO("Started {} logdevs in {} ms", logdevs.size(), m_start_ms);
+}
+
+uint64_t LogStoreService::logdev_start_time_ms(logdev_id_t logdev_id) const {
+    auto const it = m_logdev_start_ms.find(logdev_id);
+    return (it == m_logdev_start_ms.end()) ? 0 : it->second;
 }
 
 void LogStoreService::stop() {
@@ -423,6 +446,9 @@ LogStoreServiceMetrics::LogStoreServiceMetrics() : sisl::MetricsGroup("LogStores
                        HistogramBucketsType(OpLatecyBuckets));
     REGISTER_HISTOGRAM(logdev_flush_time_us, "time elapsed since last flush time in us",
                        HistogramBucketsType(OpLatecyBuckets));
+    REGISTER_COUNTER(logdev_group_buf_grow_count, "Number of times a log group buffer was grown to fit inlined data");
+    REGISTER_COUNTER(logdev_group_buf_grow_copied_bytes, "Bytes copied while growing log group buffers");
+    REGISTER_COUNTER(logdev_group_buf_shrink_count, "Number of times an under used log group buffer was shrunk");
 
     register_me_to_farm();
 }
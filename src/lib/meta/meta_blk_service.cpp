@@ -13,6 +13,7 @@
  * specific language governing permissions and limitations under the License.
  *
  *********************************************************************************/
+#include <algorithm>
 #include <array>
 #include <cstdint>
 #include <cstring>
@@ -20,11 +21,16 @@
 #include <filesystem>
 #include <memory>
 #include <mutex>
+#include <set>
+#include <shared_mutex>
 #include <system_error>
 
 #include <sisl/fds/compress.hpp>
 #include <sisl/fds/utils.hpp>
+#include <sisl/utility/thread_factory.hpp>
+#include <iomgr/iomgr.hpp>
 #include <iomgr/iomgr_flip.hpp>
+#include <folly/futures/Future.h>
 
 #include <homestore/meta_service.hpp>
 #include <homestore/homestore.hpp>
@@ -32,6 +38,7 @@
 #include <homestore/chunk_selector.h>
 #include "common/homestore_flip.hpp"
 #include "common/homestore_utils.hpp"
+#include "common/iobuf_pool.hpp"
 #include "common/crash_simulator.hpp"
 #include "device/device.h"
 #include "device/virtual_dev.hpp"
@@ -45,6 +52,20 @@ namespace homestore {
 
 MetaBlkService& meta_service() { return hs()->meta_service(); }
 
+// Blks staged by an async update pass, so that they can be written in parallel after m_meta_mtx is released. Each blk
+// carries its own copy of the content, since compress buffer and in-memory meta blks can change meanwhile.
+struct meta_write_batch {
+    using blk_list_t = std::vector< std::pair< BlkId, pooled_iobuf > >;
+    blk_list_t ovf_blks;  // ovf hdr and data blks, have to be persisted before the meta blks pointing to them;
+    blk_list_t meta_blks; // meta blks
+
+    static void stage(blk_list_t& blks, const BlkId& bid, const uint8_t* buf, uint32_t size, uint32_t align) {
+        pooled_iobuf b{size, align};
+        std::memcpy(b.bytes(), buf, size);
+        blks.emplace_back(bid, std::move(b));
+    }
+};
+
 MetaBlkService::MetaBlkService(const char* name) : m_metrics{name} { m_last_mblk_id = std::make_unique< BlkId >(); }
 
 void MetaBlkService::create_vdev(uint64_t size, HSDevType devType, uint32_t num_chunks) {
@@ -102,11 +123,32 @@ void MetaBlkService::start(bool need_format) {
         scan_meta_blks();
     }
     recover();
+
+    {
+        std::lock_guard< std::mutex > lk{m_async_update_mtx};
+        m_async_update_stop = false;
+    }
+    m_async_update_thread = sisl::named_thread("meta_async_upd", [this]() { async_update_thread(); });
 }
 
 void MetaBlkService::stop() {
+    if (m_async_update_thread.joinable()) {
+        // Thread writes all the updates which are already queued before exiting
+        {
+            std::lock_guard< std::mutex > lk{m_async_update_mtx};
+            m_async_update_stop = true;
+        }
+        m_async_update_cv.notify_one();
+        m_async_update_thread.join();
+    }
+
     {
         std::lock_guard< decltype(m_shutdown_mtx) > lg_shutdown{m_shutdown_mtx};
+        if (m_inited && m_sb_vdev) {
+            // Refresh the directory on clean shutdown, so that next startup can prefetch all meta blks
+            std::lock_guard< decltype(m_meta_mtx) > lg{m_meta_mtx};
+            if (is_meta_blk_dir_stale()) { write_meta_blk_dir(); }
+        }
         cache_clear();
 
         {
@@ -218,12 +260,234 @@ void MetaBlkService::write_ssb() {
 
 void MetaBlkService::scan_meta_blks() {
     cache_clear();
-    const auto self_recover = scan_and_load_meta_blks(m_meta_blks, m_ovf_blk_hdrs, m_last_mblk_id.get(), m_sub_info);
+    const auto start_time = Clock::now();
+
+    // Read all the blks listed in directory upfront in parallel, the chain walk below then only has to issue
+    // synchronous reads for blks which are not listed (i.e. directory is stale or missing).
+    auto prefetched = prefetch_meta_blks(load_meta_blk_dir());
+    const auto nprefetched = prefetched.size();
+    const auto self_recover =
+        scan_and_load_meta_blks(m_meta_blks, m_ovf_blk_hdrs, m_last_mblk_id.get(), m_sub_info, &prefetched);
     if (self_recover) { set_self_recover(); }
+
+    // Whatever is left over are blks which are no longer part of the chain
+    for (auto& [bid, buf] : prefetched) {
+        hs_utils::iobuf_free(buf, sisl::buftag::metablk);
+    }
+
+    const auto scan_time_ms = get_elapsed_time_ms(start_time);
+    GAUGE_UPDATE(m_metrics, scan_time_ms, scan_time_ms);
+    LOGINFO("Scanned meta blks in {} ms, num_meta_blks={}, num_ovf_hdr_blks={}, prefetched={}, unused_prefetch={}",
+            scan_time_ms, m_meta_blks.size(), m_ovf_blk_hdrs.size(), nprefetched, prefetched.size());
+
+    // Directory is refreshed at clean shutdown as well, but doing it here covers the restart after a crash.
+    std::lock_guard< decltype(m_meta_mtx) > lg{m_meta_mtx};
+    if (is_meta_blk_dir_stale()) { write_meta_blk_dir(); }
+}
+
+uint8_t* MetaBlkService::read_scan_blk(const BlkId& bid, prefetch_buf_map_t* prefetched) {
+    if (prefetched) {
+        if (auto it = prefetched->find(bid.to_integer()); it != prefetched->end()) {
+            auto* buf = it->second;
+            prefetched->erase(it);
+            COUNTER_INCREMENT(m_metrics, scan_prefetched_blks, 1);
+            return buf;
+        }
+    }
+
+    // TODO: add a new API in blkstore read to by pass cache;
+    // e.g. take caller's read buf to avoid this extra memory copy;
+    auto* buf = hs_utils::iobuf_alloc(block_size(), sisl::buftag::metablk, align_size());
+    read(bid, buf, block_size());
+    COUNTER_INCREMENT(m_metrics, scan_sync_read_blks, 1);
+    return buf;
+}
+
+uint64_t MetaBlkService::dir_blk_max_num_bids() const {
+    return (block_size() - sizeof(meta_blk_dir_hdr)) / sizeof(BlkId);
+}
+
+std::vector< BlkId > MetaBlkService::load_meta_blk_dir() {
+    std::vector< BlkId > bids;
+    m_dir_blks.clear();
+    m_dir_listed_bids.clear();
+    m_dir_valid = false;
+    if (m_ssb->dir_magic != META_BLK_DIR_MAGIC) {
+        HS_LOG(INFO, metablk, "No meta blk directory found, meta blks will be scanned sequentially");
+        return bids;
+    }
+
+    auto* dir = r_cast< meta_blk_dir_hdr* >(hs_utils::iobuf_alloc(block_size(), sisl::buftag::metablk, align_size()));
+    auto dbid = m_ssb->dir_bid;
+    m_dir_valid = true;
+    while (dbid.is_valid()) {
+        read(dbid, uintptr_cast(dir), block_size());
+
+        // directory is only a hint, so on any corruption we stop using it instead of asserting
+        if ((dir->magic != META_BLK_DIR_MAGIC) || (dir->bid.to_integer() != dbid.to_integer()) ||
+            (dir->nbids > dir_blk_max_num_bids()) ||
+            (dir->crc !=
+             crc32_ieee(init_crc32, r_cast< const uint8_t* >(dir->get_bids()), dir->nbids * sizeof(BlkId)))) {
+            LOGWARN("Meta blk directory blk {} is corrupted, ignoring the directory, magic={} self_bid={} nbids={}",
+                    dbid.to_string(), dir->magic, dir->bid.to_string(), dir->nbids);
+            m_dir_valid = false;
+            break;
+        }
+
+        // mark allocated, these blks are reused when directory is rewritten
+        auto alloc_status = m_sb_vdev->commit_blk(dbid);
+        if (alloc_status != BlkAllocStatus::SUCCESS) HS_REL_ASSERT(0, "Failed to commit blk: {} ", dbid.to_string());
+        m_dir_blks.push_back(dbid);
+
+        bids.insert(bids.end(), dir->get_bids(), dir->get_bids() + dir->nbids);
+        dbid = dir->next_bid;
+    }
+    hs_utils::iobuf_free(uintptr_cast(dir), sisl::buftag::metablk);
+
+    if (!m_dir_valid) {
+        bids.clear();
+        return bids;
+    }
+
+    m_dir_listed_bids.reserve(bids.size());
+    for (const auto& bid : bids) {
+        m_dir_listed_bids.push_back(bid.to_integer());
+    }
+    std::sort(m_dir_listed_bids.begin(), m_dir_listed_bids.end());
+
+    HS_LOG(INFO, metablk, "Loaded meta blk directory, num_dir_blks={}, num_listed_blks={}", m_dir_blks.size(),
+           bids.size());
+    return bids;
+}
+
+prefetch_buf_map_t MetaBlkService::prefetch_meta_blks(const std::vector< BlkId >& bids) {
+    prefetch_buf_map_t bufs;
+    const uint32_t qd = HS_DYNAMIC_CONFIG(metablk.scan_parallel_reads);
+
+    // Can't block on the io completion if we are on a reactor, fallback to synchronous reads in that case
+    if (bids.empty() || (qd == 0) || iomanager.am_i_io_reactor()) { return bufs; }
+
+    bufs.reserve(bids.size());
+    std::vector< folly::Future< std::error_code > > futs;
+    futs.reserve(qd);
+    size_t i{0};
+    while (i < bids.size()) {
+        const size_t batch_start = i;
+        futs.clear();
+        for (; (i < bids.size()) && (futs.size() < qd); ++i) {
+            auto* buf = hs_utils::iobuf_alloc(block_size(), sisl::buftag::metablk, align_size());
+            bufs[bids[i].to_integer()] = buf;
+            futs.emplace_back(
+                m_sb_vdev->async_read(r_cast< char* >(buf), block_size(), bids[i], true /* part_of_batch */));
+        }
+        m_sb_vdev->submit_batch();
+
+        auto results = folly::collectAllUnsafe(futs).get();
+        for (size_t j{0}; j < results.size(); ++j) {
+            if (results[j].hasValue() && !results[j].value()) { continue; }
+
+            // Don't fail here, chain walk will read it synchronously and report the error there
+            const auto& bid = bids[batch_start + j];
+            LOGWARN("Failed to prefetch meta blk {}, will be read again during scan", bid.to_string());
+            if (auto it = bufs.find(bid.to_integer()); it != bufs.end()) {
+                hs_utils::iobuf_free(it->second, sisl::buftag::metablk);
+                bufs.erase(it);
+            }
+        }
+    }
+    return bufs;
+}
+
+std::vector< uint64_t > MetaBlkService::meta_blk_dir_bids() const {
+    std::vector< uint64_t > bids;
+    bids.reserve(m_meta_blks.size() + m_ovf_blk_hdrs.size());
+    for (const auto& [bid, mblk] : m_meta_blks) {
+        bids.push_back(bid);
+    }
+    for (const auto& [bid, ovf_hdr] : m_ovf_blk_hdrs) {
+        bids.push_back(bid);
+    }
+    std::sort(bids.begin(), bids.end());
+    return bids;
+}
+
+bool MetaBlkService::is_meta_blk_dir_stale() const {
+    return !m_dir_valid || (m_dir_listed_bids != meta_blk_dir_bids());
+}
+
+void MetaBlkService::write_meta_blk_dir() {
+    auto bids = meta_blk_dir_bids();
+    const auto max_bids = dir_blk_max_num_bids();
+    const size_t ndir_blks = std::max(sisl::round_up(bids.size(), max_bids) / max_bids, size_t{1});
+
+    // Reuse the existing directory blks and allocate more if needed. Directory is only a hint, so if we can't allocate
+    // we leave the existing directory as is rather than failing.
+    auto dir_blks = m_dir_blks;
+    blk_alloc_hints hints;
+    hints.is_contiguous = true;
+    while (dir_blks.size() < ndir_blks) {
+        BlkId bid;
+        if (m_sb_vdev->alloc_contiguous_blks(1, hints, bid) != BlkAllocStatus::SUCCESS) {
+            LOGWARN("Unable to allocate blk for meta blk directory, skip updating directory");
+            for (size_t i{m_dir_blks.size()}; i < dir_blks.size(); ++i) {
+                m_sb_vdev->free_blk(dir_blks[i]);
+            }
+            return;
+        }
+        dir_blks.push_back(bid);
+    }
+
+    // Write from the tail, so that a dir blk is linked only after its next blk is written
+    auto* dir = r_cast< meta_blk_dir_hdr* >(hs_utils::iobuf_alloc(block_size(), sisl::buftag::metablk, align_size()));
+    for (size_t i{ndir_blks}; i-- > 0;) {
+        std::memset(voidptr_cast(dir), 0, block_size());
+        const size_t start = i * max_bids;
+        dir->magic = META_BLK_DIR_MAGIC;
+        dir->nbids = uint32_cast(std::min(bids.size() - std::min(start, bids.size()), max_bids));
+        dir->bid = dir_blks[i];
+        if (i + 1 < ndir_blks) {
+            dir->next_bid = dir_blks[i + 1];
+        } else {
+            dir->next_bid.invalidate();
+        }
+        auto* dir_bids = dir->get_bids_mutable();
+        for (uint32_t j{0}; j < dir->nbids; ++j) {
+            dir_bids[j] = BlkId{bids[start + j]};
+        }
+        dir->crc = crc32_ieee(init_crc32, r_cast< const uint8_t* >(dir->get_bids()), dir->nbids * sizeof(BlkId));
+
+        auto error = m_sb_vdev->sync_write(r_cast< const char* >(dir), block_size(), dir_blks[i]);
+        if (error.value()) {
+            // Leave whatever is on disk, the crc check on load will skip a partially written directory
+            LOGWARN("Failed to write meta blk directory blk {}, error={}", dir_blks[i].to_string(), error.message());
+            m_dir_valid = false;
+            hs_utils::iobuf_free(uintptr_cast(dir), sisl::buftag::metablk);
+            return;
+        }
+    }
+    hs_utils::iobuf_free(uintptr_cast(dir), sisl::buftag::metablk);
+
+    if ((m_ssb->dir_magic != META_BLK_DIR_MAGIC) || (m_ssb->dir_bid.to_integer() != dir_blks[0].to_integer())) {
+        m_ssb->dir_magic = META_BLK_DIR_MAGIC;
+        m_ssb->dir_bid = dir_blks[0];
+        write_ssb();
+    }
+
+    // Free the surplus dir blks only after the new tail is persisted
+    for (size_t i{ndir_blks}; i < dir_blks.size(); ++i) {
+        m_sb_vdev->free_blk(dir_blks[i]);
+    }
+    dir_blks.resize(ndir_blks);
+
+    HS_LOG(INFO, metablk, "Written meta blk directory, num_dir_blks={}, num_listed_blks={}", ndir_blks, bids.size());
+    m_dir_blks = std::move(dir_blks);
+    m_dir_listed_bids = std::move(bids);
+    m_dir_valid = true;
 }
 
 bool MetaBlkService::scan_and_load_meta_blks(meta_blk_map_t& meta_blks, ovf_hdr_map_t& ovf_blk_hdrs,
-                                             BlkId* last_mblk_id, client_info_map_t& sub_info) {
+                                             BlkId* last_mblk_id, client_info_map_t& sub_info,
+                                             prefetch_buf_map_t* prefetched) {
     // take a look so that before scan is complete, no add/remove/update operations will be allowed;
     std::lock_guard< decltype(m_meta_mtx) > lg{m_meta_mtx};
     auto bid = m_ssb->next_bid;
@@ -233,10 +497,7 @@ bool MetaBlkService::scan_and_load_meta_blks(meta_blk_map_t& meta_blks, ovf_hdr_
     while (bid.is_valid()) {
         *last_mblk_id = bid;
 
-        // TODO: add a new API in blkstore read to by pass cache;
-        // e.g. take caller's read buf to avoid this extra memory copy;
-        auto* mblk = r_cast< meta_blk* >(hs_utils::iobuf_alloc(block_size(), sisl::buftag::metablk, align_size()));
-        read(bid, uintptr_cast(mblk), block_size());
+        auto* mblk = r_cast< meta_blk* >(read_scan_blk(bid, prefetched));
 
         // add meta blk to cache;
         meta_blks[bid.to_integer()] = mblk;
@@ -293,9 +554,7 @@ bool MetaBlkService::scan_and_load_meta_blks(meta_blk_map_t& meta_blks, ovf_hdr_
 
         while (obid.is_valid()) {
             // ovf blk header occupies whole blk;
-            auto* ovf_hdr =
-                r_cast< meta_blk_ovf_hdr* >(hs_utils::iobuf_alloc(block_size(), sisl::buftag::metablk, align_size()));
-            read(obid, uintptr_cast(ovf_hdr), block_size());
+            auto* ovf_hdr = r_cast< meta_blk_ovf_hdr* >(read_scan_blk(obid, prefetched));
 
             // verify self bid
             HS_REL_ASSERT_EQ(ovf_hdr->h.bid.to_integer(), obid.to_integer(), "Corrupted self-bid: {}/{}",
@@ -371,7 +630,7 @@ void MetaBlkService::deregister_handler(meta_sub_type type) {
 
 void MetaBlkService::register_handler(meta_sub_type type, const meta_blk_found_cb_t& cb,
                                       const meta_blk_recover_comp_cb_t& comp_cb, bool do_crc,
-                                      std::optional< meta_subtype_vec_t > deps) {
+                                      std::optional< meta_subtype_vec_t > deps, bool concurrent_recovery) {
     std::lock_guard< decltype(m_meta_mtx) > lk(m_meta_mtx);
     HS_REL_ASSERT_LT(type.length(), MAX_SUBSYS_TYPE_LEN, "type len: {} should not exceed len: {}", type.length(),
                      MAX_SUBSYS_TYPE_LEN);
@@ -388,6 +647,7 @@ void MetaBlkService::register_handler(meta_sub_type type, const meta_blk_found_c
     m_sub_info[type].cb = cb;
     m_sub_info[type].comp_cb = comp_cb;
     m_sub_info[type].do_crc = do_crc ? 1 : 0;
+    m_sub_info[type].concurrent_recovery = concurrent_recovery;
     if (deps.has_value()) {
         m_sub_info[type].has_deps = true;
         for (auto const& x : deps.value()) {
@@ -398,6 +658,8 @@ void MetaBlkService::register_handler(meta_sub_type type, const meta_blk_found_c
 }
 
 void MetaBlkService::add_sub_sb(meta_sub_type type, const uint8_t* context_data, uint64_t sz, void*& cookie) {
+    // linkage of last meta blk is updated, so wait for ongoing updates
+    std::unique_lock< iomgr::FiberManagerLib::shared_mutex > update_lg{m_sb_update_rwlock};
     std::lock_guard< decltype(m_meta_mtx) > lg(m_meta_mtx);
     HS_REL_ASSERT_EQ(m_inited, true, "accessing metablk store before init is not allowed.");
     HS_REL_ASSERT_LT(type.length(), MAX_SUBSYS_TYPE_LEN, "type len: {} should not exceed len: {}", type.length(),
@@ -445,11 +707,17 @@ sisl::byte_array MetaBlkService::to_meta_buf(sisl::byte_view buf, size_t size) c
 }
 
 void MetaBlkService::write_ovf_blk_to_disk(meta_blk_ovf_hdr* ovf_hdr, const uint8_t* context_data, uint64_t sz,
-                                           uint64_t offset, const std::string& type) {
+                                           uint64_t offset, const std::string& type, meta_write_batch* batch) {
     HS_DBG_ASSERT_LE(ovf_hdr->h.context_sz + offset, sz);
 
     // write current ovf blk to disk;
-    auto error = m_sb_vdev->sync_write((const char*)ovf_hdr, block_size(), ovf_hdr->h.bid);
+    std::error_code error;
+    if (batch) {
+        meta_write_batch::stage(batch->ovf_blks, ovf_hdr->h.bid, r_cast< const uint8_t* >(ovf_hdr), block_size(),
+                                align_size());
+    } else {
+        error = m_sb_vdev->sync_write((const char*)ovf_hdr, block_size(), ovf_hdr->h.bid);
+    }
     if (error.value()) {
         // the offset and buffer length is printed in the error messages of iomgr.
         // buf address here is to show whether the buffer is aligned or not.
@@ -463,22 +731,22 @@ void MetaBlkService::write_ovf_blk_to_disk(meta_blk_ovf_hdr* ovf_hdr, const uint
     const auto align_sz = align_size();
     uint8_t* write_context_data = (const_cast< uint8_t* >(context_data) + offset);
     size_t write_size = ovf_hdr->h.context_sz;
-    uint8_t* context_data_aligned{nullptr};
+    pooled_iobuf context_data_aligned;
     if (!hs_utils::is_ptr_aligned(write_context_data, align_sz) || !hs_utils::mod_aligned_sz(write_size, align_sz)) {
         HS_LOG_EVERY_N(WARN, metablk, unmove(50),
                        "[type={}] Unaligned address found for input context_data, ptr {}, size {}, align {} ", type,
                        (void*)write_context_data, write_size, align_sz);
         const size_t aligned_write_size = uint64_cast(sisl::round_up(write_size, align_sz));
-        context_data_aligned = hs_utils::iobuf_alloc(aligned_write_size, sisl::buftag::metablk, align_size());
-        std::memcpy(context_data_aligned, write_context_data, write_size);
-        std::memset(context_data_aligned + write_size, 0, aligned_write_size - write_size);
+        context_data_aligned = pooled_iobuf{aligned_write_size, align_sz};
+        std::memcpy(context_data_aligned.bytes(), write_context_data, write_size);
+        std::memset(context_data_aligned.bytes() + write_size, 0, aligned_write_size - write_size);
 
         // update to use new pointer and size
-        write_context_data = context_data_aligned;
+        write_context_data = context_data_aligned.bytes();
         write_size = aligned_write_size;
     }
 
-    uint8_t* data_buf{nullptr}; // avoid copying entire context_data if sz is not aligned
+    pooled_iobuf data_buf; // avoid copying entire context_data if sz is not aligned
     // write data blk to disk;
     size_t size_written{0};
     auto* data_bid = ovf_hdr->get_data_bid();
@@ -500,10 +768,10 @@ void MetaBlkService::write_ovf_blk_to_disk(meta_blk_ovf_hdr* ovf_hdr, const uint
                                ovf_hdr->h.context_sz);
                 const size_t round_sz = uint64_cast(sisl::round_up(remain_sz_to_write, align_sz));
                 cur_size = round_sz;
-                data_buf = hs_utils::iobuf_alloc(round_sz, sisl::buftag::metablk, align_size());
-                std::memcpy(data_buf, cur_ptr, remain_sz_to_write);
-                std::memset(data_buf + remain_sz_to_write, 0, round_sz - remain_sz_to_write);
-                cur_ptr = data_buf;
+                data_buf = pooled_iobuf{round_sz, align_sz};
+                std::memcpy(data_buf.bytes(), cur_ptr, remain_sz_to_write);
+                std::memset(data_buf.bytes() + remain_sz_to_write, 0, round_sz - remain_sz_to_write);
+                cur_ptr = data_buf.bytes();
             }
             // adjust size written to be the actual data and not write size
             size_written += (ovf_hdr->h.context_sz - size_written);
@@ -513,6 +781,10 @@ void MetaBlkService::write_ovf_blk_to_disk(meta_blk_ovf_hdr* ovf_hdr, const uint
         HS_REL_ASSERT(hs_utils::is_ptr_aligned(cur_ptr, align_sz) || hs_utils::mod_aligned_sz(cur_size, align_sz),
                       "Unaligned address found for input context_data, ptr {}, size {}, align {} ", (void*)cur_ptr,
                       cur_size, align_sz);
+        if (batch) {
+            meta_write_batch::stage(batch->ovf_blks, data_bid[i], cur_ptr, cur_size, align_sz);
+            continue;
+        }
         auto error = m_sb_vdev->sync_write(r_cast< const char* >(cur_ptr), cur_size, data_bid[i]);
         if (error.value()) {
             // the offset and buffer length is printed in the error messages of iomgr.
@@ -523,13 +795,16 @@ void MetaBlkService::write_ovf_blk_to_disk(meta_blk_ovf_hdr* ovf_hdr, const uint
         }
     }
 
-    if (data_buf) { hs_utils::iobuf_free(data_buf, sisl::buftag::metablk); }
-    if (context_data_aligned) { hs_utils::iobuf_free(context_data_aligned, sisl::buftag::metablk); }
-
     HS_DBG_ASSERT_EQ(size_written, ovf_hdr->h.context_sz);
 }
 
-void MetaBlkService::write_meta_blk_to_disk(meta_blk* mblk) {
+void MetaBlkService::write_meta_blk_to_disk(meta_blk* mblk, meta_write_batch* batch) {
+    if (batch) {
+        meta_write_batch::stage(batch->meta_blks, mblk->hdr.h.bid, r_cast< const uint8_t* >(mblk), block_size(),
+                                align_size());
+        return;
+    }
+
     // write current ovf blk to disk;
     auto error = m_sb_vdev->sync_write((const char*)mblk, block_size(), mblk->hdr.h.bid);
     if (error.value()) {
@@ -608,7 +883,7 @@ meta_blk* MetaBlkService::init_meta_blk(BlkId& bid, meta_sub_type type, const ui
 // free after reboot
 //
 void MetaBlkService::write_meta_blk_ovf(BlkId& out_obid, const uint8_t* context_data, uint64_t sz,
-                                        const std::string& type) {
+                                        const std::string& type, meta_write_batch* batch) {
     HS_DBG_ASSERT(m_meta_mtx.try_lock() == false, "mutex should be already be locked");
 
     // allocate data blocks
@@ -657,7 +932,7 @@ void MetaBlkService::write_meta_blk_ovf(BlkId& out_obid, const uint8_t* context_
         m_ovf_blk_hdrs[cur_bid.to_integer()] = ovf_hdr;
 
         // write ovf header blk to disk
-        write_ovf_blk_to_disk(ovf_hdr, context_data, sz, offset_in_ctx, type);
+        write_ovf_blk_to_disk(ovf_hdr, context_data, sz, offset_in_ctx, type, batch);
 
         offset_in_ctx += ovf_hdr->h.context_sz;
     }
@@ -665,7 +940,8 @@ void MetaBlkService::write_meta_blk_ovf(BlkId& out_obid, const uint8_t* context_
     HS_REL_ASSERT_EQ(offset_in_ctx, sz);
 }
 
-void MetaBlkService::write_meta_blk_internal(meta_blk* mblk, const uint8_t* context_data, uint64_t sz) {
+void MetaBlkService::write_meta_blk_internal(meta_blk* mblk, const uint8_t* context_data, uint64_t sz,
+                                             meta_write_batch* batch) {
     auto data_sz = sz;
     // start compression
     if (HS_DYNAMIC_CONFIG(metablk.compress_feature_on) && (sz >= min_compress_size())) {
@@ -735,7 +1011,7 @@ void MetaBlkService::write_meta_blk_internal(meta_blk* mblk, const uint8_t* cont
         BlkId obid;
 
         // write overflow block to disk;
-        write_meta_blk_ovf(obid, context_data, data_sz, mblk->hdr.h.type);
+        write_meta_blk_ovf(obid, context_data, data_sz, mblk->hdr.h.type, batch);
 
         HS_DBG_ASSERT(obid.is_valid(), "Expected valid blkid");
         mblk->hdr.h.ovf_bid = obid;
@@ -751,7 +1027,7 @@ void MetaBlkService::write_meta_blk_internal(meta_blk* mblk, const uint8_t* cont
     }
 
     // write meta blk;
-    write_meta_blk_to_disk(mblk);
+    write_meta_blk_to_disk(mblk, batch);
 
 #ifdef _PRERELEASE
     if (hs()->crash_simulator().crash_if_flip_set("write_sb_abort")) { return; }
@@ -803,27 +1079,71 @@ void MetaBlkService::_cookie_sanity_check(const void* cookie) const {
 // 3. free old ovf_bid if there is any
 //
 void MetaBlkService::update_sub_sb(const uint8_t* context_data, uint64_t sz, void* cookie) {
-    std::lock_guard< decltype(m_meta_mtx) > lg{m_meta_mtx};
-    HS_REL_ASSERT_EQ(m_inited, true, "accessing metablk store before init is not allowed.");
+    meta_blk* mblk = s_cast< meta_blk* >(cookie);
+    std::vector< folly::Promise< bool > > superseded;
+    {
+        std::shared_lock< iomgr::FiberManagerLib::shared_mutex > update_lg{m_sb_update_rwlock};
+        std::lock_guard< iomgr::FiberManagerLib::mutex > type_lg{sub_update_mtx(mblk->hdr.h.type)};
+        std::lock_guard< decltype(m_meta_mtx) > lg{m_meta_mtx};
+        HS_REL_ASSERT_EQ(m_inited, true, "accessing metablk store before init is not allowed.");
 
 #ifdef _PRERELEASE
-    _cookie_sanity_check(cookie);
+        _cookie_sanity_check(cookie);
 #endif
-    meta_blk* mblk = s_cast< meta_blk* >(cookie);
 
-    HS_LOG(DEBUG, metablk, "[type={}], update_sub_sb old sb: context_sz: {}, ovf_bid: {}, mstore used size: {}",
-           mblk->hdr.h.type, (unsigned long)(mblk->hdr.h.context_sz), mblk->hdr.h.ovf_bid.to_string(),
-           m_sb_vdev->used_size());
+        HS_LOG(DEBUG, metablk, "[type={}], update_sub_sb old sb: context_sz: {}, ovf_bid: {}, mstore used size: {}",
+               mblk->hdr.h.type, (unsigned long)(mblk->hdr.h.context_sz), mblk->hdr.h.ovf_bid.to_string(),
+               m_sb_vdev->used_size());
 
-    const auto ovf_bid_to_free = mblk->hdr.h.ovf_bid;
+        const auto ovf_bid_to_free = mblk->hdr.h.ovf_bid;
 
 #ifdef _PRERELEASE
-    uint32_t crc{0};
-    const auto it = m_sub_info.find(mblk->hdr.h.type);
-    HS_DBG_ASSERT(it != std::end(m_sub_info), "[type={}] not registered yet!", mblk->hdr.h.type);
-    if (it->second.do_crc) { crc = crc32_ieee(init_crc32, s_cast< const uint8_t* >(context_data), sz); }
+        uint32_t crc{0};
+        const auto it = m_sub_info.find(mblk->hdr.h.type);
+        HS_DBG_ASSERT(it != std::end(m_sub_info), "[type={}] not registered yet!", mblk->hdr.h.type);
+        if (it->second.do_crc) { crc = crc32_ieee(init_crc32, s_cast< const uint8_t* >(context_data), sz); }
 #endif
 
+        // Any async update queued before this one is superseded by it
+        superseded = take_pending_sb_update(cookie);
+
+        update_meta_blk(mblk, context_data, sz, nullptr /* batch */);
+
+#ifdef _PRERELEASE
+        if (hs()->crash_simulator().crash_if_flip_set("update_sb_abort")) { return; }
+#endif
+
+        // free the overflow bid if it is there
+        free_ovf_blk_chain(ovf_bid_to_free);
+
+        HS_LOG(DEBUG, metablk, "[type={}], update_sub_sb new sb: context_sz: {}, ovf_bid: {}, mstore used size: {}",
+               mblk->hdr.h.type, uint64_cast(mblk->hdr.h.context_sz), mblk->hdr.h.ovf_bid.to_string(),
+               m_sb_vdev->used_size());
+
+#ifdef _PRERELEASE
+        if (!(mblk->hdr.h.compressed) && it->second.do_crc) {
+            HS_REL_ASSERT_EQ(crc, uint32_cast(mblk->hdr.h.crc),
+                             "[type={}]: Input context data has been changed since received, crc mismatch: {}/{}",
+                             mblk->hdr.h.type, crc, uint32_cast(mblk->hdr.h.crc));
+        }
+#endif
+
+        // no need to update cookie and in-memory meta blk map
+
+#ifdef _PRERELEASE
+        // validate since update will change content of cookie
+        _cookie_sanity_check(cookie);
+#endif
+    }
+
+    // Notify outside of the locks, since waiters could issue further meta blk operations right away
+    for (auto& p : superseded) {
+        p.setValue(true);
+    }
+}
+
+void MetaBlkService::update_meta_blk(meta_blk* mblk, const uint8_t* context_data, uint64_t sz,
+                                     meta_write_batch* batch) {
 #ifdef _PRERELEASE
     auto old_compressed_val = mblk->hdr.h.compressed;
 #endif
@@ -840,112 +1160,265 @@ void MetaBlkService::update_sub_sb(const uint8_t* context_data, uint64_t sz, voi
     mblk->hdr.h.gen_cnt += 1;
 
     // write this meta blk to disk
-    write_meta_blk_internal(mblk, context_data, sz);
+    write_meta_blk_internal(mblk, context_data, sz, batch);
+}
 
-#ifdef _PRERELEASE
-    if (hs()->crash_simulator().crash_if_flip_set("update_sb_abort")) { return; }
-#endif
+folly::Future< bool > MetaBlkService::async_update_sub_sb(const uint8_t* context_data, uint64_t sz, void* cookie) {
+    return async_update_sub_sbs({sub_sb_update_t{context_data, sz, cookie}});
+}
 
-    // free the overflow bid if it is there
-    free_ovf_blk_chain(ovf_bid_to_free);
+folly::Future< bool > MetaBlkService::async_update_sub_sbs(const std::vector< sub_sb_update_t >& updates) {
+    HS_REL_ASSERT_EQ(m_inited, true, "accessing metablk store before init is not allowed.");
+    std::vector< folly::Future< bool > > futs;
+    futs.reserve(updates.size());
+    {
+        std::lock_guard< std::mutex > lk{m_async_update_mtx};
+        if (m_async_update_stop) { return folly::makeFuture< bool >(false); }
+
+        for (const auto& u : updates) {
+            auto& pending = m_pending_sb_updates[u.cookie];
+            if (!pending.promises.empty()) { COUNTER_INCREMENT(m_metrics, async_update_coalesced_cnt, 1); }
+
+            // Only the latest content of a sb needs to be written, all the callers waiting on it are notified then
+            pending.buf = sisl::io_blob_safe{uint32_cast(u.sz), align_size(), sisl::buftag::metablk};
+            std::memcpy(pending.buf.bytes(), u.context_data, u.sz);
+            pending.promises.emplace_back();
+            futs.emplace_back(pending.promises.back().getFuture());
+        }
+    }
+    COUNTER_INCREMENT(m_metrics, async_update_cnt, updates.size());
+    m_async_update_cv.notify_one();
 
-    HS_LOG(DEBUG, metablk, "[type={}], update_sub_sb new sb: context_sz: {}, ovf_bid: {}, mstore used size: {}",
-           mblk->hdr.h.type, uint64_cast(mblk->hdr.h.context_sz), mblk->hdr.h.ovf_bid.to_string(),
-           m_sb_vdev->used_size());
+    return folly::collectAllUnsafe(futs).thenValue([](auto&& results) {
+        return std::all_of(results.begin(), results.end(), [](auto const& t) { return t.hasValue() && t.value(); });
+    });
+}
 
-#ifdef _PRERELEASE
-    if (!(mblk->hdr.h.compressed) && it->second.do_crc) {
-        HS_REL_ASSERT_EQ(crc, uint32_cast(mblk->hdr.h.crc),
-                         "[type={}]: Input context data has been changed since received, crc mismatch: {}/{}",
-                         mblk->hdr.h.type, crc, uint32_cast(mblk->hdr.h.crc));
+std::vector< folly::Promise< bool > > MetaBlkService::take_pending_sb_update(void* cookie) {
+    std::vector< folly::Promise< bool > > promises;
+    std::lock_guard< std::mutex > lk{m_async_update_mtx};
+    if (auto it = m_pending_sb_updates.find(cookie); it != m_pending_sb_updates.end()) {
+        promises = std::move(it->second.promises);
+        m_pending_sb_updates.erase(it);
     }
-#endif
+    return promises;
+}
 
-    // no need to update cookie and in-memory meta blk map
+iomgr::FiberManagerLib::mutex& MetaBlkService::sub_update_mtx(const meta_sub_type& type) {
+    std::lock_guard< decltype(m_meta_mtx) > lg{m_meta_mtx};
+    auto& mtx = m_sub_update_mtx[type];
+    if (!mtx) { mtx = std::make_unique< iomgr::FiberManagerLib::mutex >(); }
+    return *mtx;
+}
 
-#ifdef _PRERELEASE
-    // validate since update will change content of cookie
-    _cookie_sanity_check(cookie);
-#endif
+void MetaBlkService::async_update_thread() {
+    while (true) {
+        {
+            std::unique_lock< std::mutex > lk{m_async_update_mtx};
+            m_async_update_cv.wait(lk, [this] { return m_async_update_stop || !m_pending_sb_updates.empty(); });
+            if (m_pending_sb_updates.empty()) { return; }
+        }
+
+        std::map< void*, pending_sb_update > updates;
+        bool success{true};
+        {
+            // Take the pending updates only after acquiring update lock, so that none of those sbs can be removed
+            // until the pass is complete.
+            std::shared_lock< iomgr::FiberManagerLib::shared_mutex > update_lg{m_sb_update_rwlock};
+
+            // Lock the types of the pending updates (in sorted order) before taking them out of the pending map. A sync
+            // update_sub_sb takes the pending update of its sb under the same type lock, so it either finds it still
+            // queued and supersedes it, or waits for this pass and writes its newer content after it.
+            std::set< meta_sub_type > types;
+            {
+                std::lock_guard< std::mutex > lk{m_async_update_mtx};
+                for (const auto& [cookie, upd] : m_pending_sb_updates) {
+                    types.emplace(s_cast< const meta_blk* >(cookie)->hdr.h.type);
+                }
+            }
+            std::vector< std::unique_lock< iomgr::FiberManagerLib::mutex > > type_lgs;
+            type_lgs.reserve(types.size());
+            for (const auto& type : types) {
+                type_lgs.emplace_back(sub_update_mtx(type));
+            }
+
+            {
+                // Updates of types queued after the types were collected are left for the next pass
+                std::lock_guard< std::mutex > lk{m_async_update_mtx};
+                for (auto it = m_pending_sb_updates.begin(); it != m_pending_sb_updates.end();) {
+                    if (types.count(s_cast< const meta_blk* >(it->first)->hdr.h.type)) {
+                        updates.insert(m_pending_sb_updates.extract(it++));
+                    } else {
+                        ++it;
+                    }
+                }
+            }
+            if (!updates.empty()) { success = write_pending_sb_updates(updates, types.size()); }
+        }
+
+        // Notify outside of the locks, since waiters could issue further meta blk operations right away
+        for (auto& [cookie, upd] : updates) {
+            for (auto& p : upd.promises) {
+                p.setValue(success);
+            }
+        }
+    }
 }
 
-std::error_condition MetaBlkService::remove_sub_sb(void* cookie) {
-    std::lock_guard< decltype(m_meta_mtx) > lg{m_meta_mtx};
+// Caller holds the type locks of all the updates, sync updates of other types can proceed in parallel
+bool MetaBlkService::write_pending_sb_updates(std::map< void*, pending_sb_update >& updates, size_t ntypes) {
+    const auto start_time = Clock::now();
+
+    // Populate all meta blks and their ovf chains under the lock, but write them after releasing it
+    meta_write_batch batch;
+    std::vector< BlkId > ovf_bids_to_free;
+    {
+        std::lock_guard< decltype(m_meta_mtx) > lg{m_meta_mtx};
+        for (auto& [cookie, upd] : updates) {
 #ifdef _PRERELEASE
-    _cookie_sanity_check(cookie);
+            _cookie_sanity_check(cookie);
 #endif
-    HS_REL_ASSERT_EQ(m_inited, true, "accessing metablk store before init is not allowed.");
-    meta_blk* rm_blk = s_cast< meta_blk* >(cookie);
-    const BlkId rm_bid = rm_blk->hdr.h.bid;
-    const auto type = rm_blk->hdr.h.type;
+            auto* mblk = s_cast< meta_blk* >(cookie);
+            ovf_bids_to_free.push_back(mblk->hdr.h.ovf_bid);
+            update_meta_blk(mblk, upd.buf.cbytes(), upd.buf.size(), &batch);
+        }
+    }
 
-    // this record must exist in-memory copy
-    HS_DBG_ASSERT(m_meta_blks.find(rm_bid.to_integer()) != m_meta_blks.end(), "{}, id: {} not found!", type,
-                  rm_bid.to_string());
-    HS_DBG_ASSERT(m_sub_info.find(type) != m_sub_info.end(), "{}, meta blk being reomved has not registered yet!",
-                  type);
+    if (!write_batch(batch)) {
+        // Meta blks on disk could still point to the old ovf chains, so they are not freed
+        LOGERROR("Async update pass failed to write {} sbs of {} types", updates.size(), ntypes);
+        return false;
+    }
 
-    // remove from disk;
-    const auto rm_blk_in_cache = m_meta_blks[rm_bid.to_integer()];
-    auto prev_bid = rm_blk_in_cache->hdr.h.prev_bid;
-    auto next_bid = rm_blk_in_cache->hdr.h.next_bid;
+    // Old ovf chains can be freed only after the meta blks pointing to new chains are persisted
+    {
+        std::lock_guard< decltype(m_meta_mtx) > lg{m_meta_mtx};
+        for (const auto& obid : ovf_bids_to_free) {
+            free_ovf_blk_chain(obid);
+        }
+    }
 
-    HS_LOG(INFO, metablk, "[type={}], remove_sub_sb meta blk id: {}, prev_bid: {}, next_bid: {}, mstore used size: {}",
-           type, rm_bid.to_string(), prev_bid.to_string(), next_bid.to_string(), m_sb_vdev->used_size());
+    const auto latency_us = get_elapsed_time_us(start_time);
+    HISTOGRAM_OBSERVE(m_metrics, async_update_batch_size, updates.size());
+    HISTOGRAM_OBSERVE(m_metrics, async_update_latency_us, latency_us);
+    HS_LOG(DEBUG, metablk, "Async update pass wrote {} sbs of {} types, ovf_blks={}, latency={} us", updates.size(),
+           ntypes, batch.ovf_blks.size(), latency_us);
+    return true;
+}
 
-    // validate bid/prev/next with cache data;
-    if (rm_blk != rm_blk_in_cache) {
-        HS_DBG_ASSERT(false, "{}, cookie doesn't match with cached blk, invalid cookie!", type);
-    }
+bool MetaBlkService::write_batch(meta_write_batch& batch) {
+    const auto write_blks = [this](meta_write_batch::blk_list_t& blks) {
+        if (blks.empty()) { return true; }
+        // Writes are issued from the async update thread, which is not an io reactor and so can't batch them
+        std::vector< folly::Future< std::error_code > > futs;
+        futs.reserve(blks.size());
+        for (auto& [bid, buf] : blks) {
+            futs.emplace_back(m_sb_vdev->async_write(r_cast< const char* >(buf.cbytes()), buf.size(), bid));
+        }
 
-    // update prev-blk's next pointer
-    if (prev_bid.to_integer() == m_ssb->bid.to_integer()) {
-        m_ssb->next_bid = next_bid;
-        // persist m_ssb to disk;
-        write_ssb();
-        if (m_last_mblk_id->to_integer() == rm_bid.to_integer()) { m_last_mblk_id->invalidate(); }
-    } else {
-        // find the in-memory copy of prev meta block;
-        HS_DBG_ASSERT(m_meta_blks.find(prev_bid.to_integer()) != m_meta_blks.end(), "prev: {} not found!",
-                      prev_bid.to_string());
+        bool success{true};
+        for (auto const& t : folly::collectAllUnsafe(futs).get()) {
+            if (t.hasValue() && !t.value()) { continue; }
+            LOGERROR("error happens during async update of meta blks: {}",
+                     t.hasValue() ? t.value().message() : "exception");
+            success = false;
+        }
+        return success;
+    };
 
-        // update prev meta blk's both in-memory and on-disk copy;
-        m_meta_blks[prev_bid.to_integer()]->hdr.h.next_bid = next_bid;
-        write_meta_blk_to_disk(m_meta_blks[prev_bid.to_integer()]);
-    }
+    // ovf blks have to be on disk before the meta blks pointing to them are written
+    return write_blks(batch.ovf_blks) && write_blks(batch.meta_blks);
+}
 
-    // update next-blk's prev pointer
-    if (next_bid.is_valid()) {
-        HS_DBG_ASSERT(m_meta_blks.find(next_bid.to_integer()) != m_meta_blks.end(), "next_bid: {} not found in cache",
-                      type, next_bid.to_string());
-        auto next_mblk = m_meta_blks[next_bid.to_integer()];
+std::error_condition MetaBlkService::remove_sub_sb(void* cookie) {
+    std::vector< folly::Promise< bool > > dropped;
+    {
+        // linkage of prev and next meta blks are updated, so wait for ongoing updates
+        std::unique_lock< iomgr::FiberManagerLib::shared_mutex > update_lg{m_sb_update_rwlock};
+        std::lock_guard< decltype(m_meta_mtx) > lg{m_meta_mtx};
+        dropped = take_pending_sb_update(cookie);
+#ifdef _PRERELEASE
+        _cookie_sanity_check(cookie);
+#endif
+        HS_REL_ASSERT_EQ(m_inited, true, "accessing metablk store before init is not allowed.");
+        meta_blk* rm_blk = s_cast< meta_blk* >(cookie);
+        const BlkId rm_bid = rm_blk->hdr.h.bid;
+        const auto type = rm_blk->hdr.h.type;
+
+        // this record must exist in-memory copy
+        HS_DBG_ASSERT(m_meta_blks.find(rm_bid.to_integer()) != m_meta_blks.end(), "{}, id: {} not found!", type,
+                      rm_bid.to_string());
+        HS_DBG_ASSERT(m_sub_info.find(type) != m_sub_info.end(), "{}, meta blk being reomved has not registered yet!",
+                      type);
+
+        // remove from disk;
+        const auto rm_blk_in_cache = m_meta_blks[rm_bid.to_integer()];
+        auto prev_bid = rm_blk_in_cache->hdr.h.prev_bid;
+        auto next_bid = rm_blk_in_cache->hdr.h.next_bid;
+
+        HS_LOG(INFO, metablk,
+               "[type={}], remove_sub_sb meta blk id: {}, prev_bid: {}, next_bid: {}, mstore used size: {}", type,
+               rm_bid.to_string(), prev_bid.to_string(), next_bid.to_string(), m_sb_vdev->used_size());
+
+        // validate bid/prev/next with cache data;
+        if (rm_blk != rm_blk_in_cache) {
+            HS_DBG_ASSERT(false, "{}, cookie doesn't match with cached blk, invalid cookie!", type);
+        }
 
-        // update next meta blk's both in-memory and on-disk copy;
-        next_mblk->hdr.h.prev_bid = prev_bid;
-        write_meta_blk_to_disk(next_mblk);
-    } else {
-        // if we are removing the last meta blk, update last to its previous blk;
-        HS_DBG_ASSERT_EQ(m_last_mblk_id->to_integer(), rm_bid.to_integer());
+        // update prev-blk's next pointer
+        if (prev_bid.to_integer() == m_ssb->bid.to_integer()) {
+            m_ssb->next_bid = next_bid;
+            // persist m_ssb to disk;
+            write_ssb();
+            if (m_last_mblk_id->to_integer() == rm_bid.to_integer()) { m_last_mblk_id->invalidate(); }
+        } else {
+            // find the in-memory copy of prev meta block;
+            HS_DBG_ASSERT(m_meta_blks.find(prev_bid.to_integer()) != m_meta_blks.end(), "prev: {} not found!",
+                          prev_bid.to_string());
 
-        HS_LOG(DEBUG, metablk, "removing last mblk, change m_last_mblk to bid: {}, [type={}]", prev_bid.to_string(),
-               m_meta_blks[prev_bid.to_integer()]->hdr.h.type);
-        *m_last_mblk_id = prev_bid;
-    }
+            // update prev meta blk's both in-memory and on-disk copy;
+            m_meta_blks[prev_bid.to_integer()]->hdr.h.next_bid = next_bid;
+            write_meta_blk_to_disk(m_meta_blks[prev_bid.to_integer()]);
+        }
 
-    // remove the in-memory handle from meta blk map;
-    m_meta_blks.erase(rm_bid.to_integer());
+        // update next-blk's prev pointer
+        if (next_bid.is_valid()) {
+            HS_DBG_ASSERT(m_meta_blks.find(next_bid.to_integer()) != m_meta_blks.end(),
+                          "next_bid: {} not found in cache", type, next_bid.to_string());
+            auto next_mblk = m_meta_blks[next_bid.to_integer()];
 
-    // clear in-memory cop of meta bids;
-    m_sub_info[type].meta_bids.erase(rm_bid.to_integer());
+            // update next meta blk's both in-memory and on-disk copy;
+            next_mblk->hdr.h.prev_bid = prev_bid;
+            write_meta_blk_to_disk(next_mblk);
+        } else {
+            // if we are removing the last meta blk, update last to its previous blk;
+            HS_DBG_ASSERT_EQ(m_last_mblk_id->to_integer(), rm_bid.to_integer());
+
+            HS_LOG(DEBUG, metablk, "removing last mblk, change m_last_mblk to bid: {}, [type={}]", prev_bid.to_string(),
+                   m_meta_blks[prev_bid.to_integer()]->hdr.h.type);
+            *m_last_mblk_id = prev_bid;
+        }
 
-    // free the on-disk meta blk
-    free_meta_blk(rm_blk);
+        // remove the in-memory handle from meta blk map;
+        m_meta_blks.erase(rm_bid.to_integer());
+
+        // clear in-memory cop of meta bids;
+        m_sub_info[type].meta_bids.erase(rm_bid.to_integer());
+
+        // free the on-disk meta blk
+        free_meta_blk(rm_blk);
 
 #ifdef _PRERELEASE
-    if (hs()->crash_simulator().crash_if_flip_set("remove_sb_abort")) { return no_error; }
+        if (hs()->crash_simulator().crash_if_flip_set("remove_sb_abort")) { return no_error; }
 #endif
 
-    HS_LOG(DEBUG, metablk, "after remove, mstore used size: {}", m_sb_vdev->used_size());
+        HS_LOG(DEBUG, metablk, "after remove, mstore used size: {}", m_sb_vdev->used_size());
+    }
+
+    // Pending async updates of this sb are dropped, notify them outside of the locks
+    for (auto& p : dropped) {
+        p.setValue(false);
+    }
     return no_error;
 }
 
@@ -1131,21 +1604,35 @@ void MetaBlkService::recover(bool do_comp_cb) {
         recover_meta_sub_type(do_comp_cb, subtype);
     }
 
-    // TODO: for independent subsystems, we can use concurrent recovery if necessary.
-    for (auto const& x : m_sub_info) {
-        auto& reg_info = x.second;
-        if (!reg_info.has_deps) { recover_meta_sub_type(do_comp_cb, x.first); }
+    // Independent subsystems which opted for it (e.g. blk allocators, one per chunk) are recovered in parallel, the
+    // rest of them one after another.
+    std::vector< meta_sub_type > concurrent_subtypes;
+    for (auto const& [subtype, reg_info] : m_sub_info) {
+        if (reg_info.has_deps) { continue; }
+        if (reg_info.concurrent_recovery) {
+            concurrent_subtypes.push_back(subtype);
+        } else {
+            recover_meta_sub_type(do_comp_cb, subtype);
+        }
     }
+
+    auto const start_time = Clock::now();
+    hs_utils::parallel_for(concurrent_subtypes.size(), HS_DYNAMIC_CONFIG(generic.recovery_threads),
+                           [&](size_t i) { recover_meta_sub_type(do_comp_cb, concurrent_subtypes[i]); });
+    HS_LOG(INFO, metablk, "Recovered {} subsystems concurrently in {} ms", concurrent_subtypes.size(),
+           get_elapsed_time_ms(start_time));
 }
 
 void MetaBlkService::recover_meta_sub_type(bool do_comp_cb, const meta_sub_type& sub_type) {
-    for (const auto& m : m_sub_info[sub_type].meta_bids) {
-        auto mblk = m_meta_blks[m];
+    // Could be called concurrently for different sub types, so do only lookups on the maps
+    auto const& reg_info = m_sub_info.at(sub_type);
+    for (const auto& m : reg_info.meta_bids) {
+        auto mblk = m_meta_blks.at(m);
         recover_meta_block(mblk);
     }
 
-    if (do_comp_cb && m_sub_info[sub_type].comp_cb) {
-        m_sub_info[sub_type].comp_cb(true);
+    if (do_comp_cb && reg_info.comp_cb) {
+        reg_info.comp_cb(true);
         HS_LOG(DEBUG, metablk, "[type={}] completion callback sent.", sub_type);
     }
 }
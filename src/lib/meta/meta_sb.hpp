@@ -31,6 +31,7 @@ static constexpr uint32_t META_BLK_HDR_MAX_SZ{512}; // max meta_blk_hdr size
 static constexpr uint32_t META_BLK_MAGIC{0xCEEDBEED};
 static constexpr uint32_t META_BLK_OVF_MAGIC{0xDEADBEEF};
 static constexpr uint32_t META_BLK_SB_MAGIC{0xABCDCEED};
+static constexpr uint32_t META_BLK_DIR_MAGIC{0xD1BEC7ED};
 static constexpr uint32_t META_BLK_SB_VERSION{0x1};
 static constexpr uint32_t META_BLK_VERSION{0x1};
 static constexpr uint32_t MAX_SUBSYS_TYPE_LEN{64};
@@ -82,6 +83,19 @@ typedef uint32_t crc32_t;
  *                                   |      |-------------|       |     |-------------|
  *                                   |--->  | data buffer |       |---> | data buffer |
  *                                          | ------------|             |-------------|
+ *
+ * 4. Meta Blk Directory (optional, only a hint to speed up startup scan)
+ *
+ *    The ssb points to a chain of directory blks which lists the bids of all meta blks and overflow header blks.
+ *    During startup all the listed blks are read in parallel, so that walking the meta blk chain doesn't need a
+ *    synchronous read per blk. The meta blk chain above is still the source of truth, a stale or corrupted
+ *    directory only results in some of the blks being read synchronously again.
+ *
+ *   |----------|        |--------------|              |--------------|
+ *   | Meta SSB | -----> |   next_bid   | -----------> |   next_bid   | -----------> ... --> null
+ *   |----------|        |--------------|              |--------------|
+ *                       | bid, bid,... |              | bid, bid,... |
+ *                       |--------------|              |--------------|
  * */
 // clang-format on
 
@@ -92,6 +106,7 @@ struct MetaSubRegInfo {
     meta_blk_found_cb_t cb{nullptr};
     meta_blk_recover_comp_cb_t comp_cb{nullptr};
     bool has_deps{false};
+    bool concurrent_recovery{false}; // meta blks of this client can be recovered in parallel to other clients
 };
 
 // meta blk super block put as 1st block in the block chain;
@@ -103,9 +118,31 @@ struct meta_blk_sb {
     BlkId bid;
     uint8_t migrated;
     uint8_t pad[7];
+    uint32_t dir_magic; // dir_bid is valid only if it is set to META_BLK_DIR_MAGIC
+    BlkId dir_bid;      // first blk of meta blk directory chain;
     std::string to_string() const {
-        return fmt::format("magic: {}, version: {}, next_bid: {}, self_bid: {}", magic, version, next_bid.to_string(),
-                           bid.to_string());
+        return fmt::format("magic: {}, version: {}, next_bid: {}, self_bid: {}, dir_bid: {}", magic, version,
+                           next_bid.to_string(), bid.to_string(),
+                           (dir_magic == META_BLK_DIR_MAGIC) ? dir_bid.to_string() : "none");
+    }
+};
+#pragma pack()
+
+// meta blk directory blk, it is followed by array of nbids bids of meta blks and ovf hdr blks
+#pragma pack(1)
+struct meta_blk_dir_hdr {
+    uint32_t magic; // dir magic
+    uint32_t nbids; // number of blkids stored in this dir blk;
+    crc32_t crc;    // crc of the stored blkids
+    uint32_t pad;
+    BlkId next_bid; // next dir blk id;
+    BlkId bid;      // self blkid
+
+    const BlkId* get_bids() const {
+        return reinterpret_cast< const BlkId* >(reinterpret_cast< const uint8_t* >(this) + sizeof(meta_blk_dir_hdr));
+    }
+    BlkId* get_bids_mutable() {
+        return reinterpret_cast< BlkId* >(reinterpret_cast< uint8_t* >(this) + sizeof(meta_blk_dir_hdr));
     }
 };
 #pragma pack()
@@ -1,4 +1,5 @@
 #include <sisl/fds/vector_pool.hpp>
+#include <homestore/io_trace.hpp>
 #include "replication/log_store/repl_log_store.h"
 #include "replication/repl_dev/raft_state_machine.h"
 #include "replication/repl_dev/raft_repl_dev.h"
@@ -20,6 +21,7 @@ uint64_t ReplLogStore::append(nuraft::ptr< nuraft::log_entry >& entry) {
 
     ulong lsn = HomeRaftLogStore::append(entry);
     m_sm.link_lsn_to_req(rreq, int64_cast(lsn));
+    IOTrace::record(rreq->traceID(), io_trace_stage_t::journal_append);
     RD_LOGT(rreq->traceID(), "Raft Channel: Received append log entry rreq=[{}]", rreq->to_compact_string());
     return lsn;
 }
@@ -81,7 +83,10 @@ void ReplLogStore::end_of_append_batch(ulong start_lsn, ulong count) {
 
     // Mark all the reqs completely written
     for (auto const& rreq : *reqs) {
-        if (rreq) { rreq->add_state(repl_req_state_t::LOG_FLUSHED); }
+        if (rreq) {
+            IOTrace::record(rreq->traceID(), io_trace_stage_t::journal_flushed);
+            rreq->add_state(repl_req_state_t::LOG_FLUSHED);
+        }
     }
 
     // Data corresponding to proposer reqs have already been written before propose reqs to raft,
@@ -91,6 +96,7 @@ void ReplLogStore::end_of_append_batch(ulong start_lsn, ulong count) {
             RD_LOGT(rreq->traceID(),
                     "Raft Channel: end_of_append_batch, I am proposer for lsn {}, only flushed log for it",
                     rreq->lsn());
+            IOTrace::record(rreq->traceID(), io_trace_stage_t::journal_flushed);
             rreq->add_state(repl_req_state_t::LOG_FLUSHED);
         }
     }
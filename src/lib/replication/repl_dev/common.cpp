@@ -142,6 +142,7 @@ ReplServiceError repl_req_ctx::alloc_local_blks(cshared< ReplDevListener >& list
         m_local_blkids.emplace_back(hints_result.value().committed_blk_id.value());
         add_state(repl_req_state_t::BLK_ALLOCATED);
         add_state(repl_req_state_t::DATA_RECEIVED);
+        // Called under m_state_mtx, before the request can be added to any batch waiter
         add_state(repl_req_state_t::DATA_WRITTEN);
         add_state(repl_req_state_t::DATA_COMMITTED);
         m_data_received_promise.setValue();
@@ -177,7 +178,7 @@ void repl_req_ctx::set_lsn(int64_t lsn) {
 }
 
 bool repl_req_ctx::save_pushed_data(intrusive< sisl::GenericRpcData > const& pushed_data, uint8_t const* data,
-                                    uint32_t data_size) {
+                                    uint32_t data_size, bool respond_on_release) {
     if (!add_state_if_not_already(repl_req_state_t::DATA_RECEIVED)) { return false; }
 
     if (((uintptr_t)data % data_service().get_align_size()) != 0) {
@@ -188,6 +189,7 @@ bool repl_req_ctx::save_pushed_data(intrusive< sisl::GenericRpcData > const& pus
     }
 
     m_pushed_data = pushed_data;
+    m_respond_pushed_data = respond_on_release;
     m_data = data;
     m_data_received_promise.setValue();
     return true;
@@ -212,6 +214,26 @@ bool repl_req_ctx::save_fetched_data(sisl::GenericClientResponse const& fetched_
 
 void repl_req_ctx::add_state(repl_req_state_t s) { m_state.fetch_or(uint32_cast(s)); }
 
+void repl_req_ctx::set_data_written() {
+    shared< repl_req_batch_waiter > waiter;
+    {
+        std::unique_lock< std::mutex > lg(m_state_mtx);
+        add_state(repl_req_state_t::DATA_WRITTEN);
+        waiter = std::move(m_data_written_waiter);
+    }
+    m_data_written_promise.setValue();
+    if (waiter) { waiter->complete_one(); }
+}
+
+bool repl_req_ctx::add_data_written_waiter(shared< repl_req_batch_waiter > const& waiter) {
+    std::unique_lock< std::mutex > lg(m_state_mtx);
+    if (has_state(repl_req_state_t::DATA_WRITTEN)) { return false; }
+    DEBUG_ASSERT(m_data_written_waiter == nullptr, "rreq={} is already waited on by another batch", to_string());
+    waiter->add_one();
+    m_data_written_waiter = waiter;
+    return true;
+}
+
 bool repl_req_ctx::add_state_if_not_already(repl_req_state_t s) {
     bool changed{false};
     auto cur_v = m_state.load();
@@ -239,7 +261,7 @@ void repl_req_ctx::release_data() {
     if (m_pushed_data) {
         LOGTRACEMOD(replication, "[traceID={}] m_pushed_data addr={}, m_rkey={}, m_lsn={}", rkey().traceID,
                     static_cast< void* >(m_pushed_data.get()), m_rkey.to_string(), m_lsn);
-        m_pushed_data->send_response();
+        if (m_respond_pushed_data) { m_pushed_data->send_response(); }
         m_pushed_data = nullptr;
     }
     m_fetched_data = sisl::GenericClientResponse{};
@@ -10,6 +10,7 @@
 #include <sisl/grpc/rpc_client.hpp>
 #include <sisl/fds/vector_pool.hpp>
 #include <homestore/blkdata_service.hpp>
+#include <homestore/io_trace.hpp>
 #include <homestore/logstore_service.hpp>
 #include <homestore/superblk_handler.hpp>
 
@@ -97,17 +98,20 @@ bool RaftReplDev::bind_data_service() {
     RD_LOGI(NO_TRACE_ID, "Starting data channel, group_id={}, replica_id={}", group_id_str(), my_replica_id_str());
     bool success = false;
 #ifdef _PRERELEASE
-    success =
-        m_msg_mgr.bind_data_service_request(PUSH_DATA, m_group_id, [this](intrusive< sisl::GenericRpcData >& rpc_data) {
-            if (iomgr_flip::instance()->delay_flip("slow_down_data_channel", [this, rpc_data]() mutable {
+    auto const slow_down_cb = [this](auto handler) {
+        return [this, handler](intrusive< sisl::GenericRpcData >& rpc_data) {
+            if (iomgr_flip::instance()->delay_flip("slow_down_data_channel", [this, handler, rpc_data]() mutable {
                     RD_LOGI(NO_TRACE_ID, "Resuming after slow down data channel flip");
-                    on_push_data_received(rpc_data);
+                    (this->*handler)(rpc_data);
                 })) {
                 RD_LOGI(NO_TRACE_ID, "Slow down data channel flip is enabled, scheduling to call later");
             } else {
-                on_push_data_received(rpc_data);
+                (this->*handler)(rpc_data);
             }
-        });
+        };
+    };
+    success = m_msg_mgr.bind_data_service_request(PUSH_DATA, m_group_id,
+                                                  slow_down_cb(&RaftReplDev::on_push_data_received));
 #else
     success =
         m_msg_mgr.bind_data_service_request(PUSH_DATA, m_group_id, bind_this(RaftReplDev::on_push_data_received, 1));
@@ -116,6 +120,17 @@ bool RaftReplDev::bind_data_service() {
         RD_LOGE(NO_TRACE_ID, "Failed to bind data service request for PUSH_DATA");
         return false;
     }
+#ifdef _PRERELEASE
+    success = m_msg_mgr.bind_data_service_request(PUSH_DATA_BATCH, m_group_id,
+                                                  slow_down_cb(&RaftReplDev::on_push_data_batch_received));
+#else
+    success = m_msg_mgr.bind_data_service_request(PUSH_DATA_BATCH, m_group_id,
+                                                  bind_this(RaftReplDev::on_push_data_batch_received, 1));
+#endif
+    if (!success) {
+        RD_LOGE(NO_TRACE_ID, "Failed to bind data service request for PUSH_DATA_BATCH");
+        return false;
+    }
     success =
         m_msg_mgr.bind_data_service_request(FETCH_DATA, m_group_id, bind_this(RaftReplDev::on_fetch_data_received, 1));
     if (!success) {
@@ -801,6 +816,7 @@ void RaftReplDev::async_alloc_write(sisl::blob const& header, sisl::blob const&
 
     RD_LOGD(tid, "repl_key [{}], header size [{}] bytes, user_key size [{}] bytes, data size [{}] bytes", rreq->rkey(),
             header.size(), key.size(), data.size);
+    IOTrace::record(tid, io_trace_stage_t::repl_write_start);
 
     // Add the request to the repl_dev_rreq map, it will be accessed throughout the life cycle of this request
     auto const [_, happened] = m_repl_key_req_map.emplace(rreq->rkey(), rreq);
@@ -830,12 +846,15 @@ void RaftReplDev::async_alloc_write(sisl::blob const& header, sisl::blob const&
         COUNTER_INCREMENT(m_metrics, outstanding_data_write_cnt, 1);
 
         auto const data_write_start_time = Clock::now();
+        IOTrace::record(tid, io_trace_stage_t::data_write_submit);
+        io_trace_scope trace_scope{tid};
         // Write the data
         data_service()
             .async_write(data, rreq->local_blkid())
             .thenValue([this, rreq, data_write_start_time](auto&& err) {
                 // update outstanding no matter error or not;
                 COUNTER_DECREMENT(m_metrics, outstanding_data_write_cnt, 1);
+                IOTrace::record(rreq->traceID(), io_trace_stage_t::data_write_done);
 
                 if (err) {
                     HS_DBG_ASSERT(false, "Error in writing data, err_code={}, category={}, err_message={}", err.value(),
@@ -863,6 +882,49 @@ void RaftReplDev::async_alloc_write(sisl::blob const& header, sisl::blob const&
 }
 
 void RaftReplDev::push_data_to_all_followers(repl_req_ptr_t rreq, sisl::sg_list const& data) {
+    auto const max_delay_us = HS_DYNAMIC_CONFIG(consensus.push_data_batch_max_delay_us);
+    if ((max_delay_us == 0) || !iomanager.am_i_io_reactor()) {
+        send_push_data(std::move(rreq), data);
+        return;
+    }
+
+    // Coalesce the push of concurrent writes into one rpc per follower. The batch is sent either when it reaches the
+    // max size or when the timer armed by the first write of the batch fires, whichever is earlier.
+    push_data_batch batch;
+    bool arm_timer{false};
+    {
+        std::unique_lock lg(m_push_batch_mtx);
+        m_push_batch.rreqs.push_back(std::move(rreq));
+        m_push_batch.data.push_back(data);
+        m_push_batch.size += data.size;
+        if (m_push_batch.size >= HS_DYNAMIC_CONFIG(consensus.push_data_batch_max_size_kb) * 1024) {
+            batch = std::move(m_push_batch);
+            m_push_batch = push_data_batch{};
+        } else if (!m_push_batch_timer_armed) {
+            m_push_batch_timer_armed = arm_timer = true;
+        }
+    }
+
+    if (!batch.rreqs.empty()) {
+        send_push_data_batch(std::move(batch));
+    } else if (arm_timer) {
+        iomanager.schedule_thread_timer(uint64_cast(max_delay_us) * 1000, false /* recurring */, nullptr /* cookie */,
+                                        [rd = shared_from_this()](void*) { rd->flush_push_data_batch(); });
+    }
+}
+
+void RaftReplDev::flush_push_data_batch() {
+    push_data_batch batch;
+    {
+        std::unique_lock lg(m_push_batch_mtx);
+        m_push_batch_timer_armed = false;
+        batch = std::move(m_push_batch);
+        m_push_batch = push_data_batch{};
+    }
+    if (!batch.rreqs.empty()) { send_push_data_batch(std::move(batch)); }
+}
+
+void RaftReplDev::send_push_data(repl_req_ptr_t rreq, sisl::sg_list const& data) {
     auto& builder = rreq->create_fb_builder();
 
     // Prepare the rpc request packet with all repl_reqs details
@@ -886,6 +948,8 @@ void RaftReplDev::push_data_to_all_followers(repl_req_ptr_t rreq, sisl::sg_list
                             ->data_service_request_unidirectional(peer, PUSH_DATA, rreq->m_pkts)
                             .via(&folly::InlineExecutor::instance()));
     }
+    COUNTER_INCREMENT(m_metrics, push_data_rpc_cnt, calls.size());
+    HISTOGRAM_OBSERVE(m_metrics, push_data_batch_entries, 1);
     folly::collectAllUnsafe(calls).thenValue([this, rreq](auto&& v_res) {
         for (auto const& res : v_res) {
             if (sisl_likely(res.value())) {
@@ -904,6 +968,67 @@ void RaftReplDev::push_data_to_all_followers(repl_req_ptr_t rreq, sisl::sg_list
     });
 }
 
+void RaftReplDev::send_push_data_batch(push_data_batch batch) {
+    // A single write is pushed with the plain PushDataRequest, so that the common case of no concurrency doesn't pay
+    // for the batch envelope.
+    if (batch.rreqs.size() == 1) {
+        send_push_data(std::move(batch.rreqs[0]), batch.data[0]);
+        return;
+    }
+
+    auto builder = std::make_shared< flatbuffers::FlatBufferBuilder >();
+    auto const push_time_ms = get_time_since_epoch_ms();
+    std::vector< flatbuffers::Offset< PushDataRequest > > entries;
+    entries.reserve(batch.rreqs.size());
+    for (size_t i{0}; i < batch.rreqs.size(); ++i) {
+        auto const& rreq = batch.rreqs[i];
+        entries.push_back(CreatePushDataRequest(
+            *builder, rreq->traceID(), server_id(), rreq->term(), rreq->dsn(),
+            builder->CreateVector(rreq->header().cbytes(), rreq->header().size()),
+            builder->CreateVector(rreq->key().cbytes(), rreq->key().size()), batch.data[i].size, push_time_ms));
+    }
+    builder->FinishSizePrefixed(CreatePushDataBatchRequest(*builder, builder->CreateVector(entries)));
+
+    // Data of all the entries follow the flatbuffer back to back in the order of entries
+    sisl::io_blob_list_t pkts;
+    pkts.emplace_back(builder->GetBufferPointer(), builder->GetSize(), false);
+    for (auto const& data : batch.data) {
+        auto const data_pkts = sisl::io_blob::sg_list_to_ioblob_list(data);
+        pkts.insert(pkts.end(), data_pkts.begin(), data_pkts.end());
+    }
+
+    auto peers = get_active_peers();
+    auto calls = std::vector< nuraft_mesg::NullAsyncResult >();
+    for (auto peer : peers) {
+        RD_LOGD(NO_TRACE_ID, "Data Channel: Pushing data of {} rreqs, size={} to follower {}", batch.rreqs.size(),
+                batch.size, peer);
+        calls.push_back(group_msg_service()
+                            ->data_service_request_unidirectional(peer, PUSH_DATA_BATCH, pkts)
+                            .via(&folly::InlineExecutor::instance()));
+    }
+    COUNTER_INCREMENT(m_metrics, push_data_rpc_cnt, calls.size());
+    COUNTER_INCREMENT(m_metrics, push_data_coalesced_cnt, batch.rreqs.size());
+    HISTOGRAM_OBSERVE(m_metrics, push_data_batch_entries, batch.rreqs.size());
+
+    // The builder and rreqs (and thus the data buffers they refer to) are kept alive until the rpcs are done
+    folly::collectAllUnsafe(calls).thenValue(
+        [this, builder = std::move(builder), rreqs = std::move(batch.rreqs)](auto&& v_res) {
+            for (auto const& res : v_res) {
+                if (sisl_likely(res.value())) {
+                    auto r = res.value();
+                    if (r.hasError()) {
+                        // Just logging PushData error, no action is needed as follower can try by fetchData.
+                        RD_LOGI(NO_TRACE_ID,
+                                "Data Channel: Error in pushing data of {} rreqs to all followers, first rreq=[{}] "
+                                "error={}",
+                                rreqs.size(), rreqs[0]->to_string(), r.error());
+                    }
+                }
+            }
+            RD_LOGD(NO_TRACE_ID, "Data Channel: Data push completed for {} rreqs", rreqs.size());
+        });
+}
+
 void RaftReplDev::on_push_data_received(intrusive< sisl::GenericRpcData >& rpc_data) {
     auto const push_data_rcv_time = Clock::now();
     auto const& incoming_buf = rpc_data->request_blob();
@@ -923,19 +1048,10 @@ void RaftReplDev::on_push_data_received(intrusive< sisl::GenericRpcData >& rpc_d
         rpc_data->send_response();
         return;
     }
-    sisl::blob header = sisl::blob{push_req->user_header()->Data(), push_req->user_header()->size()};
-    sisl::blob key = sisl::blob{push_req->user_key()->Data(), push_req->user_key()->size()};
-    repl_key rkey{.server_id = push_req->issuer_replica_id(),
-                  .term = push_req->raft_term(),
-                  .dsn = push_req->dsn(),
-                  .traceID = push_req->trace_id()};
-    auto const req_orig_time_ms = push_req->time_ms();
-
-    RD_LOGD(rkey.traceID, "Data Channel: PushData received: time diff={} ms.", get_elapsed_time_ms(req_orig_time_ms));
 
 #ifdef _PRERELEASE
     if (iomgr_flip::instance()->test_flip("drop_push_data_request")) {
-        RD_LOGI(rkey.traceID,
+        RD_LOGI(push_req->trace_id(),
                 "Data Channel: Flip is enabled, skip on_push_data_received to simulate fetch remote data, "
                 "server_id={}, term={}, dsn={}",
                 push_req->issuer_replica_id(), push_req->raft_term(), push_req->dsn());
@@ -944,6 +1060,86 @@ void RaftReplDev::on_push_data_received(intrusive< sisl::GenericRpcData >& rpc_d
     }
 #endif
 
+    auto rreq = save_pushed_data(rpc_data, push_req, incoming_buf.cbytes() + fb_size, true /* respond_on_release */);
+    if (rreq == nullptr) {
+        rpc_data->send_response();
+        return;
+    }
+    write_pushed_data(rreq, push_req->data_size(), push_data_rcv_time, false /* part_of_batch */);
+}
+
+void RaftReplDev::on_push_data_batch_received(intrusive< sisl::GenericRpcData >& rpc_data) {
+    auto const push_data_rcv_time = Clock::now();
+    auto const& incoming_buf = rpc_data->request_blob();
+    if (!incoming_buf.cbytes()) {
+        RD_LOGW(NO_TRACE_ID, "Data Channel: PushDataBatch received with empty buffer, ignoring this call");
+        rpc_data->send_response();
+        return;
+    }
+
+    auto const fb_size =
+        flatbuffers::ReadScalar< flatbuffers::uoffset_t >(incoming_buf.cbytes()) + sizeof(flatbuffers::uoffset_t);
+    auto batch_req = flatbuffers::GetSizePrefixedRoot< PushDataBatchRequest >(incoming_buf.cbytes());
+    uint64_t data_size{0};
+    for (auto const push_req : *batch_req->entries()) {
+        data_size += push_req->data_size();
+    }
+    if (fb_size + data_size != incoming_buf.size()) {
+        RD_LOGW(NO_TRACE_ID,
+                "Data Channel: PushDataBatch received with size mismatch, header size {}, data size {}, received "
+                "size {}",
+                fb_size, data_size, incoming_buf.size());
+        rpc_data->send_response();
+        return;
+    }
+    HISTOGRAM_OBSERVE(m_metrics, push_data_batch_rcv_entries, batch_req->entries()->size());
+
+#ifdef _PRERELEASE
+    if (iomgr_flip::instance()->test_flip("drop_push_data_request")) {
+        RD_LOGI(NO_TRACE_ID,
+                "Data Channel: Flip is enabled, skip on_push_data_batch_received of {} entries to simulate fetch "
+                "remote data",
+                batch_req->entries()->size());
+        rpc_data->send_response();
+        return;
+    }
+#endif
+
+    // All the entries share the rpc buffer, so the response is sent only once all of their data is written. Writes
+    // of all entries are submitted as one batch to the data service, if this rpc is served on an io reactor, which is
+    // the only place a batch can be queued.
+    bool const part_of_batch = iomanager.am_i_io_reactor();
+    auto data = incoming_buf.cbytes() + fb_size;
+    std::vector< folly::Future< folly::Unit > > futs;
+    for (auto const push_req : *batch_req->entries()) {
+        auto rreq = save_pushed_data(rpc_data, push_req, data, false /* respond_on_release */);
+        if (rreq != nullptr) {
+            futs.emplace_back(write_pushed_data(rreq, push_req->data_size(), push_data_rcv_time, part_of_batch));
+        }
+        data += push_req->data_size();
+    }
+
+    if (futs.empty()) {
+        rpc_data->send_response();
+        return;
+    }
+    if (part_of_batch) { data_service().submit_io_batch(); }
+    folly::collectAllUnsafe(futs).thenValue([rpc_data](auto&&) { rpc_data->send_response(); });
+}
+
+repl_req_ptr_t RaftReplDev::save_pushed_data(intrusive< sisl::GenericRpcData > const& rpc_data,
+                                             PushDataRequest const* push_req, uint8_t const* data,
+                                             bool respond_on_release) {
+    sisl::blob header = sisl::blob{push_req->user_header()->Data(), push_req->user_header()->size()};
+    sisl::blob key = sisl::blob{push_req->user_key()->Data(), push_req->user_key()->size()};
+    repl_key rkey{.server_id = push_req->issuer_replica_id(),
+                  .term = push_req->raft_term(),
+                  .dsn = push_req->dsn(),
+                  .traceID = push_req->trace_id()};
+    auto const req_orig_time_ms = push_req->time_ms();
+
+    RD_LOGD(rkey.traceID, "Data Channel: PushData received: time diff={} ms.", get_elapsed_time_ms(req_orig_time_ms));
+
     auto rreq = applier_create_req(rkey, journal_type_t::HS_DATA_LINKED, header, key, push_req->data_size(),
                                    true /* is_data_channel */);
     if (rreq == nullptr) {
@@ -951,26 +1147,31 @@ void RaftReplDev::on_push_data_received(intrusive< sisl::GenericRpcData >& rpc_d
                 "Data Channel: Creating rreq on applier has failed, will ignore the push and let Raft channel send "
                 "trigger a fetch explicitly if needed. rkey={}",
                 rkey.to_string());
-        rpc_data->send_response();
-        return;
+        return nullptr;
     }
 
-    if (!rreq->save_pushed_data(rpc_data, incoming_buf.cbytes() + fb_size, push_req->data_size())) {
+    if (!rreq->save_pushed_data(rpc_data, data, push_req->data_size(), respond_on_release)) {
         RD_LOGT(rkey.traceID, "Data Channel: Data already received for rreq=[{}], ignoring this data",
                 rreq->to_string());
-        rpc_data->send_response();
-        return;
+        return nullptr;
     }
+    return rreq;
+}
 
+folly::Future< folly::Unit > RaftReplDev::write_pushed_data(repl_req_ptr_t rreq, uint32_t data_size,
+                                                           Clock::time_point push_data_rcv_time, bool part_of_batch) {
     COUNTER_INCREMENT(m_metrics, total_write_cnt, 1);
     COUNTER_INCREMENT(m_metrics, outstanding_data_write_cnt, 1);
 
     // Schedule a write and upon completion, mark the data as written.
-    data_service()
-        .async_write(r_cast< const char* >(rreq->data()), push_req->data_size(), rreq->local_blkid())
+    IOTrace::record(rreq->traceID(), io_trace_stage_t::data_write_submit);
+    io_trace_scope trace_scope{rreq->traceID()};
+    return data_service()
+        .async_write(r_cast< const char* >(rreq->data()), data_size, rreq->local_blkid(), part_of_batch)
         .thenValue([this, rreq, push_data_rcv_time](auto&& err) {
             // update outstanding no matter error or not;
             COUNTER_DECREMENT(m_metrics, outstanding_data_write_cnt, 1);
+            IOTrace::record(rreq->traceID(), io_trace_stage_t::data_write_done);
 
             if (err) {
                 COUNTER_INCREMENT(m_metrics, write_err_cnt, 1);
@@ -979,8 +1180,7 @@ void RaftReplDev::on_push_data_received(intrusive< sisl::GenericRpcData >& rpc_d
                 handle_error(rreq, ReplServiceError::DRIVE_WRITE_ERROR);
             } else {
                 rreq->release_data();
-                rreq->add_state(repl_req_state_t::DATA_WRITTEN);
-                rreq->m_data_written_promise.setValue();
+                rreq->set_data_written();
                 // if rreq create time is earlier than push_data receive time, that means the rreq was created by raft
                 // channel log. Otherwise set to zero as rreq is created by data channel.
                 const auto data_log_diff_us =
@@ -1015,6 +1215,10 @@ repl_req_ptr_t RaftReplDev::applier_create_req(repl_key const& rkey, journal_typ
     RD_DBG_ASSERT((it != m_repl_key_req_map.end()), "Unexpected error in map_repl_key_to_req");
     auto rreq = it->second;
 
+    // Index the req for gc as soon as it is in the map, so that it is collected even if init_req_ctx below fails and
+    // is not retried. Proposer reqs are not gc'ed.
+    if (happened && (m_raft_server_id != rkey.server_id)) { add_to_gc_index(rkey, rreq->created_time()); }
+
     if (!happened) {
         // We already have the entry in the map, reset its start time to prevent it from being incorrectly gc during
         // use.
@@ -1057,8 +1261,10 @@ repl_req_ptr_t RaftReplDev::applier_create_req(repl_key const& rkey, journal_typ
 }
 
 folly::Future< folly::Unit > RaftReplDev::notify_after_data_written(std::vector< repl_req_ptr_t >* rreqs) {
-    std::vector< folly::Future< folly::Unit > > futs;
-    futs.reserve(rreqs->size());
+    // Rather than a future per request, the whole append batch waits on one waiter, which the write completion of its
+    // last pending request signals.
+    auto waiter = std::make_shared< repl_req_batch_waiter >();
+    uint32_t num_pending{0};
     std::vector< repl_req_ptr_t > unreceived_data_reqs;
 
     // Walk through the list of requests and wait for the data to be received and written
@@ -1077,8 +1283,8 @@ folly::Future< folly::Unit > RaftReplDev::notify_after_data_written(std::vector<
             // append_entry handler callback). Hence we do that step of receiving data now. The same scenario can
             // happen in case of leader is not the propose (i.e raft forwarding is enabled)
             unreceived_data_reqs.emplace_back(rreq);
-        } else {
-            futs.emplace_back(rreq->m_data_written_promise.getFuture());
+        } else if (rreq->add_data_written_waiter(waiter)) {
+            ++num_pending;
         }
     }
 
@@ -1095,14 +1301,17 @@ folly::Future< folly::Unit > RaftReplDev::notify_after_data_written(std::vector<
             HS_REL_ASSERT(false, "Data fetch timeout, should not happen");
         }
         for (auto const& rreq : unreceived_data_reqs) {
-            futs.emplace_back(rreq->m_data_written_promise.getFuture());
+            if (rreq->add_data_written_waiter(waiter)) { ++num_pending; }
         }
     }
 
     // All the entries are done already, no need to wait
-    if (futs.size() == 0) { return folly::makeFuture< folly::Unit >(folly::Unit{}); }
+    if (num_pending == 0) { return folly::makeFuture< folly::Unit >(folly::Unit{}); }
 
-    return folly::collectAllUnsafe(futs).thenValue([this, rreqs](auto&& e) {
+    HISTOGRAM_OBSERVE(m_metrics, data_write_wait_batch_entries, num_pending);
+    auto fut = waiter->m_done_promise.getFuture();
+    waiter->complete_one(); // Done adding the requests
+    return std::move(fut).thenValue([this, rreqs](auto&&) {
 #ifndef NDEBUG
         for (auto const& rreq : *rreqs) {
             if ((rreq == nullptr) || (!rreq->has_linked_data())) { continue; }
@@ -1147,7 +1356,7 @@ bool RaftReplDev::wait_for_data_receive(std::vector< repl_req_ptr_t > const& rre
     if (is_resync_mode()) {
         check_and_fetch_remote_data(only_wait_reqs);
     } else {
-        m_repl_svc.add_to_fetch_queue(shared_from_this(), only_wait_reqs);
+        schedule_fetch_remote_data(only_wait_reqs);
     }
 
     // block waiting here until all the futs are ready (data channel filled in and promises are made);
@@ -1197,6 +1406,87 @@ void RaftReplDev::check_and_fetch_remote_data(std::vector< repl_req_ptr_t > rreq
     fetch_data_from_remote(std::move(next_batch_rreqs));
 }
 
+void RaftReplDev::schedule_fetch_remote_data(std::vector< repl_req_ptr_t > rreqs) {
+    auto const wait_ms = std::chrono::milliseconds(HS_DYNAMIC_CONFIG(consensus.wait_data_write_timer_ms));
+    auto deadline = Clock::time_point::max();
+    for (auto const& rreq : rreqs) {
+        deadline = std::min(deadline, rreq->created_time() + wait_ms);
+    }
+
+    bool arm_timer{false};
+    {
+        std::unique_lock lg(m_fetch_sched_mtx);
+        auto& reqs = m_fetch_deadlines[deadline];
+        reqs.insert(reqs.end(), std::make_move_iterator(rreqs.begin()), std::make_move_iterator(rreqs.end()));
+        if (m_fetch_timer_deadlines.empty() || (deadline < *m_fetch_timer_deadlines.begin())) {
+            m_fetch_timer_deadlines.insert(deadline);
+            arm_timer = true;
+        }
+    }
+    COUNTER_INCREMENT(m_metrics, fetch_scheduled_rreq_cnt, rreqs.size());
+    if (arm_timer) { arm_fetch_timer(deadline); }
+}
+
+void RaftReplDev::arm_fetch_timer(Clock::time_point deadline) {
+    auto const now = Clock::now();
+    uint64_t const delay_ns =
+        (deadline > now) ? std::chrono::duration_cast< std::chrono::nanoseconds >(deadline - now).count() : 0;
+
+    // Several of these non-recurring timers can be armed at once and any of them could outlive the repl dev, so they
+    // hold a weak reference instead of being tracked and cancelled on stop.
+    iomanager.schedule_global_timer(
+        std::max(delay_ns, 1ul), false /* recurring */, nullptr /* cookie */, iomgr::reactor_regex::random_worker,
+        [rd = weak_from_this(), deadline](void*) {
+            if (auto rdev = rd.lock()) { rdev->on_fetch_timer(deadline); }
+        });
+}
+
+void RaftReplDev::on_fetch_timer(Clock::time_point deadline) {
+    auto const now = Clock::now();
+    std::vector< repl_req_ptr_t > expired_rreqs;
+    auto next_deadline = Clock::time_point::max();
+    {
+        std::unique_lock lg(m_fetch_sched_mtx);
+        if (auto it = m_fetch_timer_deadlines.find(deadline); it != m_fetch_timer_deadlines.end()) {
+            m_fetch_timer_deadlines.erase(it);
+        }
+
+        auto it = m_fetch_deadlines.begin();
+        for (; (it != m_fetch_deadlines.end()) && (it->first <= now); ++it) {
+            HISTOGRAM_OBSERVE(m_metrics, fetch_deadline_lag_us, get_elapsed_time_us(it->first, now));
+            expired_rreqs.insert(expired_rreqs.end(), std::make_move_iterator(it->second.begin()),
+                                 std::make_move_iterator(it->second.end()));
+        }
+        m_fetch_deadlines.erase(m_fetch_deadlines.begin(), it);
+
+        // Keep a timer armed for the earliest remaining deadline, unless an earlier one is armed already
+        if (!m_fetch_deadlines.empty()) {
+            auto const earliest = m_fetch_deadlines.begin()->first;
+            if (m_fetch_timer_deadlines.empty() || (earliest < *m_fetch_timer_deadlines.begin())) {
+                m_fetch_timer_deadlines.insert(earliest);
+                next_deadline = earliest;
+            }
+        }
+    }
+    if (next_deadline != Clock::time_point::max()) { arm_fetch_timer(next_deadline); }
+    if (expired_rreqs.empty()) { return; }
+
+    // Regroup all the expired requests by their originator, so that each originator gets as few fetch rpcs as
+    // possible, each bounded by data_fetch_max_size_kb. Same request could have been scheduled more than once.
+    std::map< int32_t, std::vector< repl_req_ptr_t > > originator_rreqs;
+    std::set< repl_req_ctx* > seen;
+    for (auto& rreq : expired_rreqs) {
+        if (rreq->has_state(repl_req_state_t::DATA_RECEIVED) || !seen.insert(rreq.get()).second) { continue; }
+        originator_rreqs[rreq->remote_blkid().server_id].emplace_back(std::move(rreq));
+    }
+
+    for (auto& [originator, rreqs] : originator_rreqs) {
+        RD_LOGD(NO_TRACE_ID, "Data Channel: Wait for data expired for {} rreqs, fetching from originator={}",
+                rreqs.size(), originator);
+        check_and_fetch_remote_data(std::move(rreqs));
+    }
+}
+
 void RaftReplDev::fetch_data_from_remote(std::vector< repl_req_ptr_t > rreqs) {
     if (rreqs.size() == 0) { return; }
 
@@ -1383,6 +1673,11 @@ void RaftReplDev::handle_fetch_data_response(sisl::GenericClientResponse respons
 
     RD_LOGD(NO_TRACE_ID, "Data Channel: FetchData completed for {} requests", rreqs.size());
 
+    // Writes of all the fetched entries are issued as one batch to the data service, if the response is handled on an
+    // io reactor, which is the only place a batch can be queued. Each request is still marked written individually as
+    // soon as its own write completes and the append batch waiting on them is signalled once the last one is done.
+    bool const part_of_batch = iomanager.am_i_io_reactor();
+    uint32_t nwrites{0};
     for (auto const& rreq : rreqs) {
         auto const data_size = rreq->remote_blkid().blkid.blk_count() * get_blk_size();
 
@@ -1399,11 +1694,14 @@ void RaftReplDev::handle_fetch_data_response(sisl::GenericClientResponse respons
             auto const data_write_start_time = Clock::now();
             COUNTER_INCREMENT(m_metrics, total_write_cnt, 1);
             COUNTER_INCREMENT(m_metrics, outstanding_data_write_cnt, 1);
+            IOTrace::record(rreq->traceID(), io_trace_stage_t::data_write_submit);
+            io_trace_scope trace_scope{rreq->traceID()};
             data_service()
-                .async_write(r_cast< const char* >(rreq->data()), data_size, rreq->local_blkid())
+                .async_write(r_cast< const char* >(rreq->data()), data_size, rreq->local_blkid(), part_of_batch)
                 .thenValue([this, rreq, data_write_start_time](auto&& err) {
                     // update outstanding no matter error or not;
                     COUNTER_DECREMENT(m_metrics, outstanding_data_write_cnt, 1);
+                    IOTrace::record(rreq->traceID(), io_trace_stage_t::data_write_done);
                     auto const data_write_latency = get_elapsed_time_us(data_write_start_time);
                     auto const total_data_write_latency = get_elapsed_time_us(rreq->created_time());
                     auto const write_num_pieces = rreq->local_blkid().num_pieces();
@@ -1416,14 +1714,14 @@ void RaftReplDev::handle_fetch_data_response(sisl::GenericClientResponse respons
                                   err.value(), err.category().name(), err.message());
                     // TODO: Find a way to return error to the Listener
                     rreq->release_data();
-                    rreq->add_state(repl_req_state_t::DATA_WRITTEN);
-                    rreq->m_data_written_promise.setValue();
+                    rreq->set_data_written();
 
                     RD_LOGD(rreq->traceID(),
                             "Data Channel: Data Write completed rreq=[{}], data_write_latency_us={}, "
                             "total_write_latency_us={}, write_num_pieces={}",
                             rreq->to_compact_string(), data_write_latency, total_data_write_latency, write_num_pieces);
                 });
+            ++nwrites;
 
             RD_LOGT(rreq->traceID(),
                     "Data Channel: Data fetched from remote: rreq=[{}], data_size: {}, total_size: {}, local_blkid: {}",
@@ -1433,6 +1731,10 @@ void RaftReplDev::handle_fetch_data_response(sisl::GenericClientResponse respons
         total_size -= data_size;
     }
 
+    if (nwrites) {
+        if (part_of_batch) { data_service().submit_io_batch(); }
+        HISTOGRAM_OBSERVE(m_metrics, fetch_data_write_batch_entries, nwrites);
+    }
     RD_DBG_ASSERT_EQ(total_size, 0, "Total size mismatch, some data is not consumed");
 }
 
@@ -1487,6 +1789,7 @@ void RaftReplDev::handle_commit(repl_req_ptr_t rreq, bool recovery) {
     }
 
     if (!recovery) {
+        IOTrace::record(rreq->traceID(), io_trace_stage_t::commit);
         auto prev_lsn = m_commit_upto_lsn.exchange(rreq->lsn());
         RD_DBG_ASSERT_GT(rreq->lsn(), prev_lsn,
                          "Out of order commit of lsns, it is not expected in RaftReplDev. cur_lsns={}, prev_lsns={}",
@@ -1950,6 +2253,8 @@ void RaftReplDev::become_ready() {
 
 uint32_t RaftReplDev::get_logstore_id() const { return m_data_journal->logstore_id(); }
 
+logdev_id_t RaftReplDev::get_logdev_id() const { return m_data_journal->logdev_id(); }
+
 std::shared_ptr< nuraft::state_machine > RaftReplDev::get_state_machine() { return m_state_machine; }
 
 void RaftReplDev::permanent_destroy() {
@@ -2213,6 +2518,16 @@ cshared< ReplDevCPContext > RaftReplDev::get_cp_ctx(CP* cp) {
 
 void RaftReplDev::cp_cleanup(CP*) {}
 
+static uint64_t gc_expiry_sec(Clock::time_point created_time) {
+    return std::chrono::duration_cast< std::chrono::seconds >(created_time.time_since_epoch()).count() +
+        HS_DYNAMIC_CONFIG(consensus.repl_req_timeout_sec) + 1;
+}
+
+void RaftReplDev::add_to_gc_index(repl_key const& rkey, Clock::time_point created_time) {
+    std::unique_lock lg(m_gc_mtx);
+    m_gc_expiry_buckets[gc_expiry_sec(created_time)].emplace_back(rkey);
+}
+
 void RaftReplDev::gc_repl_reqs() {
     auto cur_dsn = m_next_dsn.load();
     if (cur_dsn != 0) cur_dsn = cur_dsn - 1;
@@ -2222,45 +2537,54 @@ void RaftReplDev::gc_repl_reqs() {
     // proposing to raft. Two simultaneous write requests on leader can have
     // <LSN=100, DSN=102> and <LSN=101, DSN =101> during the window.
     std::vector< repl_req_ptr_t > expired_rreqs;
+    uint64_t nscanned{0};
 
-    auto req_map_size = m_repl_key_req_map.size();
-    RD_LOGI(NO_TRACE_ID, "m_repl_key_req_map size is {};", req_map_size);
-    for (auto [key, rreq] : m_repl_key_req_map) {
-        // FIXME: Skipping proposer for now, the DSN in proposer increased in proposing stage, not when commit().
-        // Need other mechanism.
-        if (rreq->is_proposer()) {
-            // don't clean up proposer's request
-            continue;
+    // Only the buckets which have become expirable are looked at. Requests whose start time was reset since or whose
+    // DSN is not yet behind are put back to be looked at again later.
+    {
+        std::unique_lock lg(m_gc_mtx);
+        auto const now_sec =
+            std::chrono::duration_cast< std::chrono::seconds >(Clock::now().time_since_epoch()).count();
+        std::vector< std::pair< uint64_t, repl_key > > requeue;
+
+        auto bucket_it = m_gc_expiry_buckets.begin();
+        for (; (bucket_it != m_gc_expiry_buckets.end()) && (bucket_it->first <= uint64_cast(now_sec)); ++bucket_it) {
+            for (auto const& rkey : bucket_it->second) {
+                ++nscanned;
+                auto const it = m_repl_key_req_map.find(rkey);
+                if (it == m_repl_key_req_map.end()) { continue; } // Already committed or rolled back
+                auto const& rreq = it->second;
+
+                // FIXME: Skipping proposer for now, the DSN in proposer increased in proposing stage, not when
+                // commit(). Need other mechanism.
+                if (rreq->is_proposer()) { continue; }
+                if (!rreq->is_expired()) {
+                    requeue.emplace_back(gc_expiry_sec(rreq->created_time()), rkey);
+                } else if (rreq->dsn() >= cur_dsn) {
+                    // The DSN can be out of order, wait till it is behind
+                    requeue.emplace_back(now_sec + 1, rkey);
+                } else {
+                    RD_LOGD(rreq->traceID(),
+                            "legacy req with commited DSN, rreq=[{}] , dsn = {}, next_dsn = {}, gap= {}, "
+                            "elapsed_time_sec {}",
+                            rreq->to_string(), rreq->dsn(), cur_dsn, cur_dsn - rreq->dsn(),
+                            get_elapsed_time_sec(rreq->created_time()));
+                    expired_rreqs.push_back(rreq);
+                }
+            }
         }
-        if (rreq->dsn() < cur_dsn && rreq->is_expired()) {
-            // The DSN can be out of order, wait till rreq expired.
-            RD_LOGD(rreq->traceID(),
-                    "legacy req with commited DSN, rreq=[{}] , dsn = {}, next_dsn = {}, gap= {}, elapsed_time_sec {}",
-                    rreq->to_string(), rreq->dsn(), cur_dsn, cur_dsn - rreq->dsn(),
-                    get_elapsed_time_sec(rreq->created_time()));
-            expired_rreqs.push_back(rreq);
+        m_gc_expiry_buckets.erase(m_gc_expiry_buckets.begin(), bucket_it);
+        for (auto& [expiry_sec, rkey] : requeue) {
+            m_gc_expiry_buckets[expiry_sec].emplace_back(std::move(rkey));
         }
     }
-    int sm_req_cnt = 0;
-    // FIXME: we ensured data written before appending log to log store, in which we add rreq to state_machine
-    // and during pre-commit/commit we retrieve rreq from state_machine. Removing requests outside of state
-    // machine is risky.
-    // Below logs are logging only, can be removed once we get more confidence.
-    m_state_machine->iterate_repl_reqs([this, cur_dsn, &sm_req_cnt](auto key, auto rreq) {
-        sm_req_cnt++;
-        if (rreq->is_proposer()) {
-            // don't clean up proposer's request
-            return;
-        }
-        if (rreq->is_expired()) {
-            RD_LOGD(rreq->traceID(), "StateMachine: rreq=[{}] is expired, elapsed_time_sec{};", rreq->to_string(),
-                    get_elapsed_time_sec(rreq->created_time()));
-        }
-    });
-    RD_LOGT(NO_TRACE_ID, "state_machine req map size is {};", sm_req_cnt);
 
+    uint64_t nreclaimed{0};
     for (auto removing_rreq : expired_rreqs) {
         // once log flushed, the commit progress controlled by raft
+        // FIXME: we ensured data written before appending log to log store, in which we add rreq to state_machine
+        // and during pre-commit/commit we retrieve rreq from state_machine. Removing requests outside of state
+        // machine is risky.
         if (removing_rreq->has_state(repl_req_state_t::LOG_FLUSHED)) {
             RD_LOGT(removing_rreq->traceID(), "Skipping GC rreq [{}] because it is in state machine",
                     removing_rreq->to_string());
@@ -2290,6 +2614,14 @@ void RaftReplDev::gc_repl_reqs() {
         if (m_repl_key_req_map.find(removing_rreq->rkey()) != m_repl_key_req_map.end()) {
             m_repl_key_req_map.erase(removing_rreq->rkey());
         }
+        ++nreclaimed;
+    }
+
+    COUNTER_INCREMENT(m_metrics, gc_scanned_rreq_cnt, nscanned);
+    COUNTER_INCREMENT(m_metrics, gc_reclaimed_rreq_cnt, nreclaimed);
+    if (nscanned) {
+        RD_LOGD(NO_TRACE_ID, "GC rreqs: scanned={}, reclaimed={}, m_repl_key_req_map size={}", nscanned, nreclaimed,
+                m_repl_key_req_map.size());
     }
 }
 
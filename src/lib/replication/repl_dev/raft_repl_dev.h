@@ -1,5 +1,7 @@
 #pragma once
 
+#include <map>
+#include <set>
 #include <string>
 
 #include <libnuraft/ptr.hxx>
@@ -16,6 +18,7 @@
 
 namespace homestore {
 
+struct PushDataRequest;
 static constexpr uint64_t max_replace_member_task_id_len = 64;
 
 struct replace_member_task_superblk {
@@ -76,6 +79,12 @@ public:
         REGISTER_COUNTER(fetch_total_blk_size, "total fetch data blocks size", "fetch_total_blk_size", {"op", "fetch"});
         REGISTER_COUNTER(fetch_total_entries_cnt, "total fetch total entries count", "fetch_total_entries_cnt",
                          {"op", "fetch"});
+        REGISTER_COUNTER(fetch_scheduled_rreq_cnt, "total rreqs scheduled to fetch data after wait",
+                         "fetch_scheduled_rreq_cnt", {"op", "fetch"});
+        REGISTER_COUNTER(gc_scanned_rreq_cnt, "total rreqs looked at by gc", "gc_rreq_cnt", {"op", "scanned"});
+        REGISTER_COUNTER(gc_reclaimed_rreq_cnt, "total rreqs reclaimed by gc", "gc_rreq_cnt", {"op", "reclaimed"});
+        REGISTER_HISTOGRAM(fetch_deadline_lag_us, "Delay of scheduled fetch data past its deadline in us",
+                           HistogramBucketsType(OpLatecyBuckets));
 
         // TODO: do we want to put this under _PRERELEASE only?
         REGISTER_COUNTER(total_read_cnt, "total write count", "total_write_cnt", {"op", "read"}); // placeholder
@@ -104,6 +113,21 @@ public:
         REGISTER_HISTOGRAM(rreq_pieces_per_write, "Number of individual pieces per write",
                            HistogramBucketsType(SteppedUpto32Buckets));
 
+        // Data channel push batching
+        REGISTER_COUNTER(push_data_rpc_cnt, "Total push data rpcs sent to followers", "push_data_rpc_cnt",
+                         {"op", "push"});
+        REGISTER_COUNTER(push_data_coalesced_cnt, "Total write requests pushed in a coalesced push data rpc",
+                         "push_data_coalesced_cnt", {"op", "push"});
+        REGISTER_HISTOGRAM(push_data_batch_entries, "Number of write requests coalesced in a push data rpc",
+                           "push_data_batch_entries", {"op", "push"}, HistogramBucketsType(SteppedUpto32Buckets));
+        REGISTER_HISTOGRAM(fetch_data_write_batch_entries, "Number of fetched data writes submitted as a batch",
+                           "push_data_batch_entries", {"op", "fetch"}, HistogramBucketsType(SteppedUpto32Buckets));
+        REGISTER_HISTOGRAM(data_write_wait_batch_entries,
+                           "Number of data writes an append batch waited on with a single completion",
+                           HistogramBucketsType(SteppedUpto32Buckets));
+        REGISTER_HISTOGRAM(push_data_batch_rcv_entries, "Number of write requests in a received push data rpc",
+                           "push_data_batch_entries", {"op", "receive"}, HistogramBucketsType(SteppedUpto32Buckets));
+
         // In the identical layout chunk, the blk num of the follower and leader is expected to be the same.
         // However, due to the concurrency between the data channel and the raft channel, there might be some
         // allocation differences on the same lsn. When a leader switch occurs, these differences could become garbage.
@@ -221,8 +245,27 @@ private:
 
     std::atomic< uint64_t > m_next_dsn{0}; // Data Sequence Number that will keep incrementing for each data entry
 
-    iomgr::timer_handle_t m_wait_data_timer_hdl{
-        iomgr::null_timer_handle}; // non-recurring timer doesn't need to be cancelled on shutdown;
+    // Write requests whose data is waiting to be pushed to followers in one coalesced rpc
+    struct push_data_batch {
+        std::vector< repl_req_ptr_t > rreqs;
+        std::vector< sisl::sg_list > data;
+        uint64_t size{0};
+    };
+    std::mutex m_push_batch_mtx;
+    push_data_batch m_push_batch;
+    bool m_push_batch_timer_armed{false};
+
+    // Expiry index of the requests created by data or raft channel on applier, keyed by the second at which they
+    // become expirable, so that gc only looks at the requests which could be reclaimed.
+    std::mutex m_gc_mtx;
+    std::map< uint64_t, std::vector< repl_key > > m_gc_expiry_buckets;
+
+    // Requests whose data didn't arrive through the data channel, keyed by the time at which their data is to be
+    // fetched from the originator. A timer is kept armed for the earliest deadline, so that the fetch is issued as
+    // soon as the wait expires.
+    std::mutex m_fetch_sched_mtx;
+    std::map< Clock::time_point, std::vector< repl_req_ptr_t > > m_fetch_deadlines;
+    std::multiset< Clock::time_point > m_fetch_timer_deadlines; // Deadlines for which a timer is armed
     Clock::time_point m_destroyed_time;
     folly::Promise< ReplServiceError > m_destroy_promise;
     RaftReplDevMetrics m_metrics;
@@ -446,6 +489,7 @@ protected:
 
     //////////////// All nuraft_mesg::mesg_state_mgr overrides ///////////////////////
     uint32_t get_logstore_id() const override;
+    logdev_id_t get_logdev_id() const;
     std::shared_ptr< nuraft::state_machine > get_state_machine() override;
     void permanent_destroy() override;
     void leave() override;
@@ -455,9 +499,20 @@ protected:
 private:
     shared< nuraft::log_store > data_journal() { return m_data_journal; }
     void push_data_to_all_followers(repl_req_ptr_t rreq, sisl::sg_list const& data);
+    void flush_push_data_batch();
+    void send_push_data(repl_req_ptr_t rreq, sisl::sg_list const& data);
+    void send_push_data_batch(push_data_batch batch);
     void on_push_data_received(intrusive< sisl::GenericRpcData >& rpc_data);
+    void on_push_data_batch_received(intrusive< sisl::GenericRpcData >& rpc_data);
+    repl_req_ptr_t save_pushed_data(intrusive< sisl::GenericRpcData > const& rpc_data, PushDataRequest const* push_req,
+                                    uint8_t const* data, bool respond_on_release);
+    folly::Future< folly::Unit > write_pushed_data(repl_req_ptr_t rreq, uint32_t data_size,
+                                                   Clock::time_point push_data_rcv_time, bool part_of_batch);
     void on_fetch_data_received(intrusive< sisl::GenericRpcData >& rpc_data);
     void fetch_data_from_remote(std::vector< repl_req_ptr_t > rreqs);
+    void schedule_fetch_remote_data(std::vector< repl_req_ptr_t > rreqs);
+    void arm_fetch_timer(Clock::time_point deadline);
+    void on_fetch_timer(Clock::time_point deadline);
     void handle_fetch_data_response(sisl::GenericClientResponse response, std::vector< repl_req_ptr_t > rreqs);
     bool is_resync_mode();
 
@@ -481,6 +536,7 @@ private:
     void update_truncation_boundary(repl_req_ptr_t rreq);
     void propose_truncate_boundary();
 
+    void add_to_gc_index(repl_key const& rkey, Clock::time_point created_time);
     void report_blk_metrics_if_needed(repl_req_ptr_t rreq);
     ReplServiceError init_req_ctx(repl_req_ptr_t rreq, repl_key rkey, journal_type_t op_code, bool is_proposer,
                                   sisl::blob const& user_header, sisl::blob const& key, uint32_t data_size,
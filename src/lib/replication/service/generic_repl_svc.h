@@ -36,6 +36,7 @@
 namespace homestore {
 
 static std::string const PUSH_DATA{"push_data"};
+static std::string const PUSH_DATA_BATCH{"push_data_batch"};
 static std::string const FETCH_DATA{"fetch_data"};
 
 struct repl_dev_superblk;
@@ -21,6 +21,8 @@
 #include <homestore/logstore_service.hpp>
 #include "common/homestore_config.hpp"
 #include "common/homestore_assert.hpp"
+#include "common/homestore_utils.hpp"
+#include "common/homestore_status_mgr.hpp"
 #include "replication/service/raft_repl_service.h"
 #include "replication/repl_dev/raft_repl_dev.h"
 
@@ -132,6 +134,8 @@ void RaftReplService::start() {
     r_params.return_method_ = nuraft::raft_params::async_handler;
     m_msg_mgr->register_mgr_type(params.default_group_type_, r_params);
 
+    auto const start_time = Clock::now();
+
     // Step 3: Load all the repl devs from the cached superblks. This step creates the ReplDev instances and adds to
     // list. It is still not joined the Raft group yet
     for (auto const& [buf, mblk] : m_sb_bufs) {
@@ -155,6 +159,10 @@ void RaftReplService::start() {
     // The upper layer(m_repl_app) can leverage this cb to initiate and recover its data.
     // If some errors occurs, m_repl_app can set back the stage of repl_dev to repl_dev_stage_t::UNREADY.
     m_repl_app->on_repl_devs_init_completed();
+    {
+        std::unique_lock lg{m_startup_info_mtx};
+        m_startup_info.load_repl_devs_ms = get_elapsed_time_ms(start_time);
+    }
 
     // Step 5: Start the data and logstore service now. This step is essential before we can ask Raft to join groups etc
 
@@ -171,29 +179,51 @@ void RaftReplService::start() {
     LOGINFO("Starting LogStore service, fist_boot = {}", hs()->is_first_time_boot());
     hs()->logstore_service().start(hs()->is_first_time_boot());
     LOGINFO("Started LogStore service, log replay should already done till this point");
+    {
+        std::unique_lock lg{m_startup_info_mtx};
+        m_startup_info.logstore_start_ms = hs()->logstore_service().start_time_ms();
+    }
     // all log stores are replayed, time to start data service.
     LOGINFO("Starting DataService");
     hs()->data_service().start();
 
-    // Step 6: Iterate all the repl devs and ask each one of them to join the raft group concurrently.
-    std::vector< std::future< bool > > join_group_futures;
+    // Step 6: Ask each of the repl devs to join its raft group, on a bounded number of threads. A group starts serving
+    // as soon as its own join completes, without waiting for the rest of the groups.
+    std::vector< shared< RaftReplDev > > rdevs;
     for (const auto& [_, repl_dev] : m_rd_map) {
         if (repl_dev->get_stage() == repl_dev_stage_t::UNREADY) {
             LOGINFO("Repl dev is unready, skip join group, group_id={}", boost::uuids::to_string(repl_dev->group_id()));
             continue;
         }
-        join_group_futures.emplace_back(std::async(std::launch::async, [&repl_dev]() {
-            auto rdev = std::dynamic_pointer_cast< RaftReplDev >(repl_dev);
-            rdev->wait_for_logstore_ready();
-
-            // upper layer can register a callback to be notified when log replay is done.
-            if (auto listener = rdev->get_listener(); listener) listener->on_log_replay_done(rdev->group_id());
-            return rdev->join_group();
-        }));
+        auto rdev = std::dynamic_pointer_cast< RaftReplDev >(repl_dev);
+        std::unique_lock lg{m_startup_info_mtx};
+        m_startup_info.groups[rdev->group_id()].replay_ms =
+            hs()->logstore_service().logdev_start_time_ms(rdev->get_logdev_id());
+        rdevs.push_back(std::move(rdev));
     }
 
-    for (auto& future : join_group_futures) {
-        if (!future.get()) HS_REL_ASSERT(false, "FAILED TO JOIN GROUP, PANIC HERE");
+    auto const join_start_time = Clock::now();
+    hs_utils::parallel_for(rdevs.size(), HS_DYNAMIC_CONFIG(generic.recovery_threads), [&](size_t i) {
+        auto& rdev = rdevs[i];
+        rdev->wait_for_logstore_ready();
+
+        // upper layer can register a callback to be notified when log replay is done.
+        if (auto listener = rdev->get_listener(); listener) listener->on_log_replay_done(rdev->group_id());
+        if (!rdev->join_group()) HS_REL_ASSERT(false, "FAILED TO JOIN GROUP, PANIC HERE");
+
+        std::unique_lock lg{m_startup_info_mtx};
+        auto& info = m_startup_info.groups[rdev->group_id()];
+        info.ready_ms = get_elapsed_time_ms(start_time);
+        info.joined = true;
+    });
+    {
+        std::unique_lock lg{m_startup_info_mtx};
+        m_startup_info.join_groups_ms = get_elapsed_time_ms(join_start_time);
+        m_startup_info.total_ms = get_elapsed_time_ms(start_time);
+        LOGINFO("Repl devs recovered, num_groups={} load_repl_devs={}ms logstore_start={}ms join_groups={}ms "
+                "total={}ms",
+                rdevs.size(), m_startup_info.load_repl_devs_ms, m_startup_info.logstore_start_ms,
+                m_startup_info.join_groups_ms, m_startup_info.total_ms);
     }
 
     // Step 7: Register to CPManager to ensure we can flush the superblk.
@@ -204,6 +234,27 @@ void RaftReplService::start() {
 
     // Delete any unopened logstores.
     hs()->logstore_service().delete_unopened_logdevs();
+
+    hs()->status_mgr()->register_status_cb("ReplicationService",
+                                           [this](int verbosity) { return get_status(verbosity); });
+}
+
+nlohmann::json RaftReplService::get_status(int verbosity) const {
+    nlohmann::json js;
+    std::unique_lock lg{m_startup_info_mtx};
+    js["startup"]["load_repl_devs_ms"] = m_startup_info.load_repl_devs_ms;
+    js["startup"]["logstore_start_ms"] = m_startup_info.logstore_start_ms;
+    js["startup"]["join_groups_ms"] = m_startup_info.join_groups_ms;
+    js["startup"]["total_ms"] = m_startup_info.total_ms;
+    if (verbosity > 0) {
+        for (auto const& [group_id, info] : m_startup_info.groups) {
+            auto& gjs = js["startup"]["groups"][boost::uuids::to_string(group_id)];
+            gjs["replay_ms"] = info.replay_ms;
+            gjs["ready_ms"] = info.ready_ms;
+            gjs["joined"] = info.joined;
+        }
+    }
+    return js;
 }
 
 void RaftReplService::stop() {
@@ -213,6 +264,7 @@ void RaftReplService::stop() {
     // FIXME: there is still a case that before we stop_reaper_thread, some fetch_data requests have already been sent
     // out. we need use a counter to make sure all the fetch_data request has completed.
     stop_repl_service_timers();
+    hs()->status_mgr()->deregister_status_cb("ReplicationService");
 
     start_stopping();
     while (true) {
@@ -589,13 +641,6 @@ void RaftReplService::start_repl_service_timers() {
         },
         true /* wait_to_schedule */);
 
-    // Check for queued fetches at the minimum every second
-    uint64_t interval_ns =
-        std::min(HS_DYNAMIC_CONFIG(consensus.wait_data_write_timer_ms) * 1000 * 1000, 1ul * 1000 * 1000 * 1000);
-    m_rdev_fetch_timer_hdl = iomanager.schedule_global_timer(
-        interval_ns, true /* recurring */, nullptr, iomgr::reactor_regex::all_worker,
-        [this](void*) { fetch_pending_data(); }, true /* wait_to_schedule */);
-
     // Flush durable commit lsns to superblock
     // FIXUP: what is the best value for flush_durable_commit_interval_ms?
     m_flush_durable_commit_timer_hdl = iomanager.schedule_global_timer(
@@ -610,39 +655,31 @@ void RaftReplService::start_repl_service_timers() {
 
 void RaftReplService::stop_repl_service_timers() {
     iomanager.cancel_timer(m_rdev_gc_timer_hdl, true);
-    iomanager.cancel_timer(m_rdev_fetch_timer_hdl, true);
     iomanager.cancel_timer(m_flush_durable_commit_timer_hdl, true);
     iomanager.cancel_timer(m_replace_member_sync_check_timer_hdl, true);
 }
 
-void RaftReplService::add_to_fetch_queue(cshared< RaftReplDev >& rdev, std::vector< repl_req_ptr_t > rreqs) {
-    std::unique_lock lg(m_pending_fetch_mtx);
-    m_pending_fetch_batches.push(std::make_pair(rdev, std::move(rreqs)));
-}
-
-void RaftReplService::fetch_pending_data() {
-    std::unique_lock lg(m_pending_fetch_mtx);
-    while (!m_pending_fetch_batches.empty()) {
-        auto const& [d, rreqs] = m_pending_fetch_batches.front();
-        if (get_elapsed_time_ms(rreqs.at(0)->created_time()) < HS_DYNAMIC_CONFIG(consensus.wait_data_write_timer_ms)) {
-            break;
-        }
-        auto const next_batch = rreqs;
-        auto rdev = d;
-        m_pending_fetch_batches.pop();
-        lg.unlock();
-
-        rdev->check_and_fetch_remote_data(std::move(next_batch));
-        lg.lock();
+void RaftReplService::gc_repl_reqs() {
+    incr_pending_request_num();
+    if (is_stopping()) {
+        decr_pending_request_num();
+        return;
     }
-}
 
-void RaftReplService::gc_repl_reqs() {
-    std::shared_lock lg(m_rd_map_mtx);
-    for (auto it = m_rd_map.begin(); it != m_rd_map.end(); ++it) {
-        auto rdev = std::dynamic_pointer_cast< RaftReplDev >(it->second);
-        rdev->gc_repl_reqs();
+    // Spread the gc of repl devs across the workers instead of doing all of them in the timer callback. Each of them is
+    // counted as a pending request, so that stop waits for it before stopping the repl devs.
+    {
+        std::shared_lock lg(m_rd_map_mtx);
+        for (auto it = m_rd_map.begin(); it != m_rd_map.end(); ++it) {
+            auto rdev = std::dynamic_pointer_cast< RaftReplDev >(it->second);
+            incr_pending_request_num();
+            iomanager.run_on_forget(iomgr::reactor_regex::random_worker, [this, rdev]() {
+                rdev->gc_repl_reqs();
+                decr_pending_request_num();
+            });
+        }
     }
+    decr_pending_request_num();
 }
 
 void RaftReplService::gc_repl_devs() {
@@ -14,7 +14,6 @@
  *********************************************************************************/
 #pragma once
 #include <map>
-#include <queue>
 #include <set>
 #include <string>
 #include <shared_mutex>
@@ -51,9 +50,6 @@ private:
     shared< nuraft_mesg::Manager > m_msg_mgr;
     json_superblk m_config_sb;
     std::vector< std::pair< sisl::byte_view, void* > > m_config_sb_bufs;
-    std::mutex m_pending_fetch_mtx;
-    std::queue< std::pair< shared< RaftReplDev >, std::vector< repl_req_ptr_t > > > m_pending_fetch_batches;
-    iomgr::timer_handle_t m_rdev_fetch_timer_hdl;
     iomgr::timer_handle_t m_rdev_gc_timer_hdl;
     iomgr::timer_handle_t m_flush_durable_commit_timer_hdl;
     iomgr::timer_handle_t m_replace_member_sync_check_timer_hdl;
@@ -61,6 +57,21 @@ private:
     std::atomic< int32_t > restart_counter{0};
     std::mutex raft_restart_mutex;
 
+    // Time taken by each phase of start() and by each group to recover, reported in get_status
+    struct group_startup_info {
+        uint64_t replay_ms{0}; // Time taken to load and replay the logdev of this group
+        uint64_t ready_ms{0};  // Time since start() began, after which the group joined raft and is serving
+        bool joined{false};
+    };
+    struct startup_info {
+        uint64_t load_repl_devs_ms{0};
+        uint64_t logstore_start_ms{0};
+        uint64_t join_groups_ms{0};
+        uint64_t total_ms{0};
+        std::map< group_id_t, group_startup_info > groups;
+    } m_startup_info;
+    mutable std::mutex m_startup_info_mtx;
+
 public:
     RaftReplService(cshared< ReplApplication >& repl_app);
     ~RaftReplService() override;
@@ -73,7 +84,7 @@ public:
     std::shared_ptr< nuraft_mesg::mesg_state_mgr > create_state_mgr(int32_t srv_id,
                                                                     nuraft_mesg::group_id_t const& group_id) override;
     nuraft_mesg::Manager& msg_manager() { return *m_msg_mgr; }
-    void add_to_fetch_queue(cshared< RaftReplDev >& rdev, std::vector< repl_req_ptr_t > rreqs);
+    nlohmann::json get_status(int verbosity) const;
 
 protected:
     ///////////////////// Overrides of GenericReplService ////////////////////
@@ -102,7 +113,6 @@ private:
     RaftReplDev* raft_group_config_found(sisl::byte_view const& buf, void* meta_cookie);
     void start_repl_service_timers();
     void stop_repl_service_timers();
-    void fetch_pending_data();
     void gc_repl_devs();
     void gc_repl_reqs();
     void flush_durable_commit_lsn();
@@ -64,6 +64,7 @@ struct BtreeTestHelper {
         m_operations["range_put"] = std::bind(&BtreeTestHelper::range_put_random, this);
         m_operations["range_remove"] = std::bind(&BtreeTestHelper::range_remove_existing_random, this);
         m_operations["query"] = std::bind(&BtreeTestHelper::query_random, this);
+        m_operations["get"] = std::bind(&BtreeTestHelper::get_random, this);
     }
 
     void TearDown() {}
@@ -387,6 +388,12 @@ public:
     }
 
     ////////////////////// All get operation variants ///////////////////////////////
+    void get_random() {
+        auto const [start_k, end_k] = m_shadow_map.pick_random_non_working_keys(1);
+        get_specific(start_k);
+        m_shadow_map.remove_keys_from_working(start_k, end_k);
+    }
+
     void get_all() const {
         m_shadow_map.foreach ([this](K key, V value) {
             auto copy_key = std::make_unique< K >();
@@ -0,0 +1,110 @@
+/*********************************************************************************
+ * Modifications Copyright 2017-2019 eBay Inc.
+ *
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *    https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed
+ * under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ *
+ *********************************************************************************/
+#include <benchmark/benchmark.h>
+
+#define StoreSpecificBtreeNode homestore::BtreeNode
+
+#include <sisl/logging/logging.h>
+#include <sisl/options/options.h>
+#include <homestore/btree/detail/simple_node.hpp>
+#include <homestore/btree/detail/varlen_node.hpp>
+#include <homestore/btree/detail/compact_node.hpp>
+#include "btree_helpers/btree_test_kvs.hpp"
+
+using namespace homestore;
+SISL_LOGGING_DEF(btree)
+SISL_LOGGING_INIT(btree)
+SISL_OPTIONS_ENABLE(logging)
+
+// Compares the in-node lookup cost of different node layouts. All nodes are filled with same fixed size keys and values
+// so that the only difference is how entries are laid out and searched.
+using FixedSimpleNode = SimpleNode< TestFixedKey, TestFixedValue >;
+using FixedVarObjSizeNode = VarObjSizeNode< TestFixedKey, TestFixedValue >;
+using FixedCompactNode = CompactNode< TestFixedKey, TestFixedValue >;
+
+#define NODE_LOOKUP_BENCHMARK(NODE_TYPE)                                                                               \
+    BENCHMARK(bm_node_lookup< NODE_TYPE >)->Arg(4096)->Arg(8192)->Arg(16384)->Name(#NODE_TYPE "_lookup");
+
+#define NODE_FILL_BENCHMARK(NODE_TYPE)                                                                                 \
+    BENCHMARK(bm_node_fill< NODE_TYPE >)->Arg(4096)->Arg(16384)->Name(#NODE_TYPE "_fill");
+
+template < typename NodeT >
+static std::unique_ptr< NodeT > fill_node(uint8_t* buf, BtreeConfig const& cfg, uint32_t& nentries) {
+    auto node = std::make_unique< NodeT >(buf, 1ul, true, true, cfg);
+    TestFixedValue const val{TestFixedValue::generate_rand()};
+    nentries = 0;
+    while (node->has_room_for_put(btree_put_type::INSERT, TestFixedKey::get_fixed_size(),
+                                  TestFixedValue::get_fixed_size())) {
+        // Insert only even keys, so that half the lookups are misses
+        node->insert(nentries, TestFixedKey{2 * nentries}, val);
+        ++nentries;
+    }
+    return node;
+}
+
+template < typename NodeT >
+static void bm_node_lookup(benchmark::State& state) {
+    uint32_t const node_size = uint32_cast(state.range(0));
+    BtreeConfig cfg{node_size};
+    auto buf = std::unique_ptr< uint8_t[] >(new uint8_t[node_size]);
+    uint32_t nentries;
+    auto node = fill_node< NodeT >(buf.get(), cfg, nentries);
+
+    std::vector< TestFixedKey > lookup_keys;
+    std::uniform_int_distribution< uint64_t > rand_key{0, 2ul * nentries};
+    for (uint32_t i{0}; i < 4096; ++i) {
+        lookup_keys.emplace_back(rand_key(g_re));
+    }
+
+    uint32_t i{0};
+    uint64_t nfound{0};
+    for (auto _ : state) {
+        auto const [found, idx] = node->find(lookup_keys[i++ % lookup_keys.size()], nullptr, false);
+        nfound += found;
+        benchmark::DoNotOptimize(idx);
+    }
+    state.counters["entries"] = nentries;
+    state.counters["hit_pct"] = (nfound * 100.0) / state.iterations();
+    state.counters["bytes_per_entry"] = double(node_size - node->available_size()) / nentries;
+}
+
+template < typename NodeT >
+static void bm_node_fill(benchmark::State& state) {
+    uint32_t const node_size = uint32_cast(state.range(0));
+    BtreeConfig cfg{node_size};
+    auto buf = std::unique_ptr< uint8_t[] >(new uint8_t[node_size]);
+    uint32_t nentries{0};
+    for (auto _ : state) {
+        auto node = fill_node< NodeT >(buf.get(), cfg, nentries);
+        benchmark::DoNotOptimize(node);
+    }
+    state.counters["entries"] = nentries;
+    state.counters["inserts"] = benchmark::Counter(double(nentries) * state.iterations(), benchmark::Counter::kIsRate);
+}
+
+NODE_LOOKUP_BENCHMARK(FixedSimpleNode)
+NODE_LOOKUP_BENCHMARK(FixedVarObjSizeNode)
+NODE_LOOKUP_BENCHMARK(FixedCompactNode)
+
+NODE_FILL_BENCHMARK(FixedSimpleNode)
+NODE_FILL_BENCHMARK(FixedVarObjSizeNode)
+NODE_FILL_BENCHMARK(FixedCompactNode)
+
+int main(int argc, char** argv) {
+    ::benchmark::Initialize(&argc, argv); // Strips off the benchmark specific options
+    SISL_OPTIONS_LOAD(argc, argv, logging);
+    ::benchmark::RunSpecifiedBenchmarks();
+}
@@ -0,0 +1,93 @@
+/*********************************************************************************
+ * Modifications Copyright 2017-2019 eBay Inc.
+ *
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *    https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed
+ * under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ *
+ *********************************************************************************/
+#include <random>
+#include <benchmark/benchmark.h>
+
+#include <sisl/logging/logging.h>
+#include <sisl/options/options.h>
+#include <homestore/btree/mem_btree.hpp>
+#include "btree_helpers/btree_test_kvs.hpp"
+
+using namespace homestore;
+SISL_LOGGING_DEF(btree)
+SISL_LOGGING_INIT(btree)
+SISL_OPTIONS_ENABLE(logging)
+
+// Measures how point lookups scale with number of reader threads, with lock coupling vs optimistic (version
+// validated) reads. Arguments are {optimistic_read, write_pct}, where write_pct percent of the ops are upserts, which
+// causes the readers to contend with writers on the same nodes.
+using ReadBenchBtree = MemBtree< TestFixedKey, TestFixedValue >;
+static constexpr uint32_t g_num_keys{1000000};
+static std::unique_ptr< ReadBenchBtree > g_bt;
+
+static void put_key(uint32_t k) {
+    TestFixedKey const key{k};
+    TestFixedValue const val{TestFixedValue::generate_rand()};
+    auto req = BtreeSinglePutRequest{&key, &val, btree_put_type::UPSERT};
+    g_bt->put(req);
+}
+
+static void BM_Setup(benchmark::State const& state) {
+    BtreeConfig cfg{4096};
+    cfg.m_leaf_node_type = btree_node_type::FIXED;
+    cfg.m_int_node_type = btree_node_type::FIXED;
+    cfg.m_optimistic_read = (state.range(0) != 0);
+    g_bt = std::make_unique< ReadBenchBtree >(cfg);
+    for (uint32_t k{0}; k < g_num_keys; ++k) {
+        put_key(k);
+    }
+}
+
+static void BM_Teardown(benchmark::State const&) { g_bt.reset(); }
+
+static void bm_btree_get(benchmark::State& state) {
+    uint32_t const write_pct = uint32_cast(state.range(1));
+    std::mt19937_64 re{std::random_device{}()};
+    std::uniform_int_distribution< uint32_t > rand_key{0, g_num_keys - 1};
+    std::uniform_int_distribution< uint32_t > rand_pct{0, 99};
+
+    uint64_t ngets{0};
+    uint64_t nfound{0};
+    TestFixedValue out_val;
+    for (auto _ : state) {
+        auto const k = rand_key(re);
+        if (rand_pct(re) < write_pct) {
+            put_key(k);
+            continue;
+        }
+        TestFixedKey const key{k};
+        auto req = BtreeSingleGetRequest{&key, &out_val};
+        nfound += (g_bt->get(req) == btree_status_t::success);
+        ++ngets;
+    }
+    state.counters["gets"] = benchmark::Counter(double(ngets), benchmark::Counter::kIsRate);
+    state.counters["hit_pct"] =
+        benchmark::Counter((nfound * 100.0) / std::max(ngets, 1ul), benchmark::Counter::kAvgThreads);
+}
+
+BENCHMARK(bm_btree_get)
+    ->Setup(BM_Setup)
+    ->Teardown(BM_Teardown)
+    ->ArgNames({"optimistic", "write_pct"})
+    ->ArgsProduct({{0, 1}, {0, 5}})
+    ->ThreadRange(1, 64)
+    ->UseRealTime();
+
+int main(int argc, char** argv) {
+    ::benchmark::Initialize(&argc, argv); // Strips off the benchmark specific options
+    SISL_OPTIONS_LOAD(argc, argv, logging);
+    ::benchmark::RunSpecifiedBenchmarks();
+}
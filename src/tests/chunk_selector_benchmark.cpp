@@ -0,0 +1,107 @@
+/*********************************************************************************
+ * Modifications Copyright 2017-2019 eBay Inc.
+ *
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *    https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed
+ * under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ *
+ *********************************************************************************/
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <folly/futures/Future.h>
+#include <iomgr/io_environment.hpp>
+#include <sisl/logging/logging.h>
+#include <sisl/options/options.h>
+#include <homestore/homestore.hpp>
+#include <homestore/blkdata_service.hpp>
+#include "test_common/homestore_test_common.hpp"
+
+using namespace homestore;
+SISL_LOGGING_INIT(HOMESTORE_LOG_MODS)
+
+SISL_OPTIONS_ENABLE(logging, chunk_selector_benchmark, iomgr, test_common_setup)
+SISL_OPTION_GROUP(chunk_selector_benchmark,
+                  (num_data_chunks, "", "num_data_chunks", "number of chunks in data vdev",
+                   ::cxxopts::value< uint32_t >()->default_value("48"), "number"),
+                  (io_size_kb, "", "io_size_kb", "size of each write in KB",
+                   ::cxxopts::value< uint32_t >()->default_value("64"), "number"));
+
+// Measures the write throughput of data service across multiple devices with different chunk selectors. Each
+// iteration writes qdepth (test_common_setup option) ios concurrently and frees them after they complete. The
+// difference between selectors shows up when devices are heterogeneous, so run it with --device_list pointing to
+// drives of different speed; on the default file backed devices both should be about the same.
+static test_common::HSTestHelper s_helper;
+
+static void bm_setup(benchmark::State const& state) {
+    auto const sel_type = static_cast< chunk_selector_type_t >(state.range(0));
+    s_helper.start_homestore("test_chunk_selector_bench",
+                             {{HS_SERVICE::META, {.size_pct = 5.0}},
+                              {HS_SERVICE::LOG, {.size_pct = 10.0}},
+                              {HS_SERVICE::DATA,
+                               {.size_pct = 80.0,
+                                .chunk_sel_type = sel_type,
+                                .num_chunks = SISL_OPTIONS["num_data_chunks"].as< uint32_t >()}}});
+}
+
+static void bm_teardown(benchmark::State const&) { s_helper.shutdown_homestore(); }
+
+static void bm_data_write(benchmark::State& state) {
+    auto const io_size = SISL_OPTIONS["io_size_kb"].as< uint32_t >() * 1024;
+    auto const qdepth = SISL_OPTIONS["qdepth"].as< uint32_t >();
+
+    auto buf = iomanager.iobuf_alloc(512, io_size);
+    test_common::HSTestHelper::fill_data_buf(buf, io_size);
+    sisl::sg_list sgs;
+    sgs.size = io_size;
+    sgs.iovs.emplace_back(iovec{.iov_base = buf, .iov_len = io_size});
+
+    std::vector< MultiBlkId > bids(qdepth);
+    std::vector< folly::Future< std::error_code > > futs;
+    uint64_t nerrors{0};
+    for (auto _ : state) {
+        futs.clear();
+        for (uint32_t i{0}; i < qdepth; ++i) {
+            futs.emplace_back(hs()->data_service().async_alloc_write(sgs, blk_alloc_hints{}, bids[i]));
+        }
+        for (auto& t : folly::collectAllUnsafe(futs).get()) {
+            nerrors += (t.hasException() || t.value());
+        }
+
+        futs.clear();
+        for (auto const& bid : bids) {
+            futs.emplace_back(hs()->data_service().async_free_blk(bid));
+        }
+        folly::collectAllUnsafe(futs).wait();
+    }
+    iomanager.iobuf_free(buf);
+
+    state.SetBytesProcessed(int64_t(state.iterations()) * qdepth * io_size);
+    state.counters["iops"] = benchmark::Counter(double(state.iterations()) * qdepth, benchmark::Counter::kIsRate);
+    state.counters["errors"] = nerrors;
+}
+
+BENCHMARK(bm_data_write)
+    ->Setup(bm_setup)
+    ->Teardown(bm_teardown)
+    ->ArgName("chunk_sel_type")
+    ->Arg(static_cast< int64_t >(chunk_selector_type_t::ROUND_ROBIN))
+    ->Arg(static_cast< int64_t >(chunk_selector_type_t::LOAD_AWARE))
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
+
+int main(int argc, char** argv) {
+    ::benchmark::Initialize(&argc, argv); // Strips off the benchmark specific options
+    SISL_OPTIONS_LOAD(argc, argv, logging, chunk_selector_benchmark, iomgr, test_common_setup)
+    sisl::logging::SetLogger("chunk_selector_benchmark");
+    spdlog::set_pattern("[%D %T%z] [%^%l%$] [%n] [%t] %v");
+
+    ::benchmark::RunSpecifiedBenchmarks();
+}
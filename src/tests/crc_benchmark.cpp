@@ -0,0 +1,96 @@
+/*********************************************************************************
+ * Modifications Copyright 2017-2019 eBay Inc.
+ *
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *    https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed
+ * under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ *
+ *********************************************************************************/
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <sisl/logging/logging.h>
+#include <sisl/options/options.h>
+
+#ifndef NO_ISAL
+#include <isa-l/crc.h>
+#endif
+#include "crc_impl.h"
+
+SISL_LOGGING_INIT(HOMESTORE_LOG_MODS)
+SISL_OPTIONS_ENABLE(logging)
+
+// Checksum throughput (bytes_per_second) of each crc implementation, for the buffer sizes we typically checksum: log
+// records/groups, btree nodes and data blks. ISA-L ones are included when built with it.
+using namespace homestore;
+using crc16_fn_t = uint16_t (*)(uint16_t, const unsigned char*, uint64_t);
+using crc32_fn_t = uint32_t (*)(uint32_t, const unsigned char*, uint64_t);
+
+static std::vector< unsigned char > const& test_buf() {
+    static std::vector< unsigned char > const s_buf = []() {
+        std::vector< unsigned char > buf(1024 * 1024);
+        std::mt19937_64 re{0};
+        for (auto& b : buf) {
+            b = static_cast< unsigned char >(re());
+        }
+        return buf;
+    }();
+    return s_buf;
+}
+
+template < typename SeedT, typename FnT >
+static void run_crc(benchmark::State& state, FnT fn, bool supported) {
+    if (!supported) {
+        state.SkipWithError("Not supported by this cpu");
+        return;
+    }
+    auto const len = uint64_t(state.range(0));
+    auto const& buf = test_buf();
+    SeedT c{0};
+    for (auto _ : state) {
+        c = fn(c, buf.data(), len);
+        benchmark::DoNotOptimize(c);
+    }
+    state.SetBytesProcessed(int64_t(state.iterations()) * len);
+}
+
+static void bm_crc32_slice8(benchmark::State& state) { run_crc< uint32_t >(state, crc::crc32_ieee_slice8, true); }
+static void bm_crc32_pclmul(benchmark::State& state) {
+    run_crc< uint32_t >(state, crc::crc32_ieee_pclmul, crc::has_pclmul());
+}
+static void bm_crc32_armv8(benchmark::State& state) {
+    run_crc< uint32_t >(state, crc::crc32_ieee_armv8, crc::has_armv8_crc());
+}
+static void bm_crc16_slice8(benchmark::State& state) { run_crc< uint16_t >(state, crc::crc16_t10dif_slice8, true); }
+static void bm_crc16_pclmul(benchmark::State& state) {
+    run_crc< uint16_t >(state, crc::crc16_t10dif_pclmul, crc::has_pclmul());
+}
+
+#define CRC_SIZES ->RangeMultiplier(8)->Range(512, 1024 * 1024)
+BENCHMARK(bm_crc32_slice8) CRC_SIZES;
+BENCHMARK(bm_crc32_pclmul) CRC_SIZES;
+BENCHMARK(bm_crc32_armv8) CRC_SIZES;
+BENCHMARK(bm_crc16_slice8) CRC_SIZES;
+BENCHMARK(bm_crc16_pclmul) CRC_SIZES;
+
+#ifndef NO_ISAL
+static void bm_crc32_isal(benchmark::State& state) { run_crc< uint32_t >(state, crc32_ieee, true); }
+static void bm_crc16_isal(benchmark::State& state) { run_crc< uint16_t >(state, crc16_t10dif, true); }
+BENCHMARK(bm_crc32_isal) CRC_SIZES;
+BENCHMARK(bm_crc16_isal) CRC_SIZES;
+#endif
+
+int main(int argc, char** argv) {
+    ::benchmark::Initialize(&argc, argv); // Strips off the benchmark specific options
+    SISL_OPTIONS_LOAD(argc, argv, logging);
+    LOGINFO("crc32_ieee impl={} crc16_t10dif impl={}", crc::crc32_ieee_impl_name(), crc::crc16_t10dif_impl_name());
+    ::benchmark::RunSpecifiedBenchmarks();
+}
@@ -0,0 +1,121 @@
+/*********************************************************************************
+ * Modifications Copyright 2017-2019 eBay Inc.
+ *
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *    https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed
+ * under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ *
+ *********************************************************************************/
+#include <sys/resource.h>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <folly/futures/Future.h>
+#include <iomgr/io_environment.hpp>
+#include <sisl/logging/logging.h>
+#include <sisl/options/options.h>
+#include <homestore/homestore.hpp>
+#include <homestore/blkdata_service.hpp>
+#include "test_common/homestore_test_common.hpp"
+
+using namespace homestore;
+SISL_LOGGING_INIT(HOMESTORE_LOG_MODS)
+
+SISL_OPTIONS_ENABLE(logging, data_io_benchmark, iomgr, test_common_setup)
+SISL_OPTION_GROUP(data_io_benchmark,
+                  (num_blkids, "", "num_blkids", "number of blkids written/read in rotation",
+                   ::cxxopts::value< uint32_t >()->default_value("4096"), "number"));
+
+// Measures small (one blk) io throughput and cpu cost per io on the file backed devices (num_devs option of
+// test_common_setup), when each io is submitted to the drive on its own vs when qdepth ios are queued with
+// part_of_batch and submitted together with submit_io_batch. Cpu time includes the reactor threads completing the ios.
+static test_common::HSTestHelper s_helper;
+static std::vector< MultiBlkId > s_blkids;
+static uint8_t* s_buf{nullptr};
+
+static uint64_t process_cpu_us() {
+    struct rusage ru;
+    getrusage(RUSAGE_SELF, &ru);
+    return (ru.ru_utime.tv_sec + ru.ru_stime.tv_sec) * 1000000ul + ru.ru_utime.tv_usec + ru.ru_stime.tv_usec;
+}
+
+static void bm_data_io(benchmark::State& state) {
+    bool const is_write = (state.range(0) != 0);
+    bool const batch = (state.range(1) != 0);
+    auto const qdepth = SISL_OPTIONS["qdepth"].as< uint32_t >();
+    auto const blk_size = hs()->data_service().get_blk_size();
+
+    std::vector< folly::Future< std::error_code > > futs;
+    size_t next{0};
+    uint64_t nerrors{0};
+    auto const cpu_start_us = process_cpu_us();
+    for (auto _ : state) {
+        // Submit from a reactor, so that the batch is queued in its drive interface and submitted by it
+        futs.clear();
+        iomanager.run_on_wait(iomgr::reactor_regex::random_worker, [&]() {
+            for (uint32_t i{0}; i < qdepth; ++i) {
+                auto const& bid = s_blkids[next++ % s_blkids.size()];
+                futs.emplace_back(is_write ? hs()->data_service().async_write(r_cast< const char* >(s_buf), blk_size,
+                                                                              bid, batch)
+                                           : hs()->data_service().async_read(bid, s_buf, blk_size, batch));
+            }
+            if (batch) { hs()->data_service().submit_io_batch(); }
+        });
+        for (auto& t : folly::collectAllUnsafe(futs).get()) {
+            nerrors += (t.hasException() || t.value());
+        }
+    }
+    auto const cpu_us = process_cpu_us() - cpu_start_us;
+    auto const nios = double(state.iterations()) * qdepth;
+    auto const ndevs = SISL_OPTIONS["num_devs"].as< uint32_t >();
+
+    state.SetBytesProcessed(int64_t(nios) * blk_size);
+    state.counters["iops"] = benchmark::Counter(nios, benchmark::Counter::kIsRate);
+    state.counters["iops_per_dev"] = benchmark::Counter(nios / ndevs, benchmark::Counter::kIsRate);
+    state.counters["cpu_us_per_io"] = cpu_us / std::max(nios, 1.0);
+    state.counters["errors"] = nerrors;
+}
+
+static void setup() {
+    s_helper.start_homestore("test_data_io_bench",
+                             {{HS_SERVICE::META, {.size_pct = 5.0}},
+                              {HS_SERVICE::LOG, {.size_pct = 10.0}},
+                              {HS_SERVICE::DATA, {.size_pct = 80.0, .num_chunks = 12}}});
+
+    auto const blk_size = hs()->data_service().get_blk_size();
+    s_buf = iomanager.iobuf_alloc(512, blk_size);
+    test_common::HSTestHelper::fill_data_buf(s_buf, blk_size);
+
+    auto const nblkids = SISL_OPTIONS["num_blkids"].as< uint32_t >();
+    for (uint32_t i{0}; i < nblkids; ++i) {
+        MultiBlkId blkid;
+        if (hs()->data_service().alloc_blks(blk_size, blk_alloc_hints{}, blkid) != BlkAllocStatus::SUCCESS) { break; }
+        hs()->data_service().commit_blk(blkid);
+        s_blkids.push_back(blkid);
+    }
+}
+
+static void teardown() {
+    iomanager.iobuf_free(s_buf);
+    s_helper.shutdown_homestore();
+}
+
+BENCHMARK(bm_data_io)->ArgNames({"write", "batch"})->ArgsProduct({{0, 1}, {0, 1}})->UseRealTime();
+
+int main(int argc, char** argv) {
+    ::benchmark::Initialize(&argc, argv); // Strips off the benchmark specific options
+    SISL_OPTIONS_LOAD(argc, argv, logging, data_io_benchmark, iomgr, test_common_setup)
+    sisl::logging::SetLogger("data_io_benchmark");
+    spdlog::set_pattern("[%D %T%z] [%^%l%$] [%n] [%t] %v");
+
+    setup();
+    ::benchmark::RunSpecifiedBenchmarks();
+    teardown();
+}
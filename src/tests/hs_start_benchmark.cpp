@@ -0,0 +1,98 @@
+/*********************************************************************************
+ * Modifications Copyright 2017-2019 eBay Inc.
+ *
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *    https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed
+ * under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ *
+ *********************************************************************************/
+#include <map>
+#include <string>
+
+#include <benchmark/benchmark.h>
+#include <iomgr/io_environment.hpp>
+#include <sisl/logging/logging.h>
+#include <sisl/options/options.h>
+#include <homestore/homestore.hpp>
+#include <homestore/blkdata_service.hpp>
+#include <homestore/checkpoint/cp_mgr.hpp>
+#include "common/homestore_config.hpp"
+#include "test_common/homestore_test_common.hpp"
+
+using namespace homestore;
+SISL_LOGGING_INIT(HOMESTORE_LOG_MODS)
+
+SISL_OPTIONS_ENABLE(logging, hs_start_benchmark, iomgr, test_common_setup)
+SISL_OPTION_GROUP(hs_start_benchmark,
+                  (num_data_chunks, "", "num_data_chunks", "number of chunks in data vdev",
+                   ::cxxopts::value< uint32_t >()->default_value("64"), "number"),
+                  (num_allocs, "", "num_allocs", "number of blks allocated before restart, so that bitmaps are loaded",
+                   ::cxxopts::value< uint32_t >()->default_value("10000"), "number"));
+
+// Measures the time taken by each phase of a HomeStore restart on file backed devices (num_devs option of
+// test_common_setup), with different number of recovery threads. Each phase time is reported as a counter averaged
+// across iterations, and the iteration time is the sum of all phases, which excludes the shutdown.
+static test_common::HSTestHelper s_helper;
+
+static void bm_restart(benchmark::State& state) {
+    HS_SETTINGS_FACTORY().modifiable_settings(
+        [&state](auto& s) { s.generic.recovery_threads = uint32_cast(state.range(0)); });
+    HS_SETTINGS_FACTORY().save();
+
+    std::map< std::string, double > phase_ms;
+    for (auto _ : state) {
+        s_helper.restart_homestore(0 /* shutdown_delay_sec */);
+
+        uint64_t total_ms{0};
+        for (auto const& [phase, ms] : hs()->start_phase_times_ms()) {
+            phase_ms[phase] += ms;
+            total_ms += ms;
+        }
+        state.SetIterationTime(total_ms / 1000.0);
+    }
+
+    for (auto const& [phase, ms] : phase_ms) {
+        state.counters[phase + "_ms"] = benchmark::Counter(ms, benchmark::Counter::kAvgIterations);
+    }
+}
+
+static void setup() {
+    s_helper.start_homestore(
+        "test_hs_start_bench",
+        {{HS_SERVICE::META, {.size_pct = 5.0}},
+         {HS_SERVICE::LOG, {.size_pct = 10.0}},
+         {HS_SERVICE::DATA, {.size_pct = 80.0, .num_chunks = SISL_OPTIONS["num_data_chunks"].as< uint32_t >()}}});
+
+    // Allocate and commit blks all across the data vdev, so that each chunk's allocator has a bitmap to recover
+    auto const nallocs = SISL_OPTIONS["num_allocs"].as< uint32_t >();
+    auto const blk_size = hs()->data_service().get_blk_size();
+    for (uint32_t i{0}; i < nallocs; ++i) {
+        MultiBlkId blkid;
+        if (hs()->data_service().alloc_blks(blk_size, blk_alloc_hints{}, blkid) != BlkAllocStatus::SUCCESS) { break; }
+        hs()->data_service().commit_blk(blkid);
+    }
+    hs()->cp_mgr().trigger_cp_flush(true /* force */).get();
+}
+
+static void teardown() { s_helper.shutdown_homestore(); }
+
+BENCHMARK(bm_restart)->ArgName("recovery_threads")->Arg(1)->Arg(8)->Iterations(3)->UseManualTime()->Unit(
+    benchmark::kMillisecond);
+
+int main(int argc, char** argv) {
+    SISL_OPTIONS_LOAD(argc, argv, logging, hs_start_benchmark, iomgr, test_common_setup)
+    sisl::logging::SetLogger("hs_start_benchmark");
+    spdlog::set_pattern("[%D %T%z] [%^%l%$] [%n] [%t] %v");
+
+    setup();
+    ::benchmark::Initialize(&argc, argv);
+    ::benchmark::RunSpecifiedBenchmarks();
+    teardown();
+}
@@ -14,6 +14,18 @@
  *
  *********************************************************************************/
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
 #include <benchmark/benchmark.h>
 #include <boost/uuid/random_generator.hpp>
 #include <stdint.h>
@@ -21,7 +33,10 @@
 #include <iomgr/io_environment.hpp>
 #include <sisl/options/options.h>
 #include <homestore/btree/detail/btree_internal.hpp>
+#include "common/homestore_config.hpp"
+#include "common/resource_mgr.hpp"
 #include "test_common/homestore_test_common.hpp"
+#include "test_common/benchmark_common.hpp"
 #include "btree_helpers/btree_test_kvs.hpp"
 #include "test_common/range_scheduler.hpp"
 #include "btree_helpers/btree_test_helper.hpp"
@@ -54,7 +69,95 @@ SISL_OPTION_GROUP(index_btree_benchmark,
                    "operation list instead of default created following by percentage",
                    ::cxxopts::value< std::vector< std::string > >()->default_value({"put:100"}), "operations [...]"),
                   (preload_size, "", "preload_size", "number of entries to preload tree with",
-                   ::cxxopts::value< uint32_t >()->default_value("1000"), "number"))
+                   ::cxxopts::value< uint32_t >()->default_value("1000"), "number"),
+                  (record_count, "", "record_count", "number of keys loaded before running a ycsb workload",
+                   ::cxxopts::value< uint32_t >()->default_value("100000"), "number"),
+                  (ycsb_ops, "", "ycsb_ops", "number of operations of a ycsb workload run across all fibers",
+                   ::cxxopts::value< uint32_t >()->default_value("100000"), "number"),
+                  (zipf_theta, "", "zipf_theta", "skew of the zipfian key distribution, 0 for uniform",
+                   ::cxxopts::value< double >()->default_value("0.99"), "number"),
+                  (scan_len, "", "scan_len", "number of keys a scan or range op covers",
+                   ::cxxopts::value< uint32_t >()->default_value("50"), "number"),
+                  (cache_pct, "", "cache_pct", "cache_size_percent of homestore memory, 0 to use the configured one",
+                   ::cxxopts::value< uint32_t >()->default_value("0"), "number"),
+                  (cp_interval_ms, "", "cp_interval_ms", "interval between cp flushes of the cp flush scenarios",
+                   ::cxxopts::value< uint32_t >()->default_value("100"), "number"))
+
+// YCSB style workloads, each a mix of percentages of these ops on keys picked with a zipfian distribution out of the
+// record_count keys loaded before the run. Inserts add keys beyond them. Range removes shrink the working set, the
+// following gets of removed keys are counted as reads all the same.
+VENUM(ycsb_op_t, uint8_t, read = 0, update = 1, insert = 2, scan = 3, range_update = 4, range_remove = 5);
+static constexpr uint32_t num_ycsb_ops{6};
+
+struct ycsb_workload {
+    std::string name;
+    std::array< uint32_t, num_ycsb_ops > pct;
+};
+
+static const std::vector< ycsb_workload > s_workloads{
+    {"A", {50, 50, 0, 0, 0, 0}},   // Update heavy
+    {"B", {95, 5, 0, 0, 0, 0}},    // Read mostly
+    {"C", {100, 0, 0, 0, 0, 0}},   // Read only
+    {"D", {95, 0, 5, 0, 0, 0}},    // Read with inserts
+    {"E", {0, 0, 5, 95, 0, 0}},    // Short scans
+    {"R", {10, 0, 10, 40, 30, 10}} // Range heavy, as with interval keyed indexes
+};
+
+// Zipfian distribution over [0, n) as generated by YCSB (Gray et al, "Quickly generating billion-record synthetic
+// databases"). The ranks are scrambled, so that the hot keys are spread over the tree instead of all being the
+// smallest keys. The generator is not defined for theta of 1 (alpha and eta divide by 1 - theta).
+class ZipfianGenerator {
+public:
+    ZipfianGenerator(uint64_t n, double theta) :
+            m_n{n},
+            m_theta{theta},
+            m_alpha{1.0 / (1.0 - theta)},
+            m_zetan{zeta(n, theta)},
+            m_eta{(1.0 - std::pow(2.0 / n, 1.0 - theta)) / (1.0 - zeta(2, theta) / m_zetan)} {
+        RELEASE_ASSERT((theta >= 0.0) && (theta != 1.0), "Zipfian theta={} must be >= 0 and != 1", theta);
+    }
+
+    template < typename Engine >
+    uint64_t operator()(Engine& re) const {
+        std::uniform_real_distribution< double > dist{0.0, 1.0};
+        auto const u = dist(re);
+        auto const uz = u * m_zetan;
+        uint64_t rank;
+        if (uz < 1.0) {
+            rank = 0;
+        } else if (uz < 1.0 + std::pow(0.5, m_theta)) {
+            rank = 1;
+        } else {
+            rank = std::min(uint64_t(m_n * std::pow(m_eta * u - m_eta + 1.0, m_alpha)), m_n - 1);
+        }
+        return (m_theta == 0.0) ? rank : scramble(rank) % m_n;
+    }
+
+private:
+    static double zeta(uint64_t n, double theta) {
+        double sum{0};
+        for (uint64_t i{1}; i <= n; ++i) {
+            sum += 1.0 / std::pow(double(i), theta);
+        }
+        return sum;
+    }
+
+    // FNV-1a of the rank
+    static uint64_t scramble(uint64_t rank) {
+        uint64_t h{0xcbf29ce484222325ull};
+        for (uint32_t i{0}; i < sizeof(rank); ++i) {
+            h = (h ^ ((rank >> (i * 8)) & 0xff)) * 0x100000001b3ull;
+        }
+        return h;
+    }
+
+private:
+    uint64_t m_n;
+    double m_theta;
+    double m_alpha;
+    double m_zetan;
+    double m_eta;
+};
 
 template < typename TestType >
 struct IndexBtreeBenchmark : public BtreeTestHelper< TestType > {
@@ -66,6 +169,11 @@ struct IndexBtreeBenchmark : public BtreeTestHelper< TestType > {
     ~IndexBtreeBenchmark() { TearDown(); }
 
     void SetUp() {
+        if (auto const cache_pct = SISL_OPTIONS["cache_pct"].as< uint32_t >(); cache_pct != 0) {
+            HS_SETTINGS_FACTORY().modifiable_settings(
+                [cache_pct](auto& s) { s.resource_limits.cache_size_percent = cache_pct; });
+            HS_SETTINGS_FACTORY().save();
+        }
         m_helper.start_homestore("index_btree_benchmark",
                                  {{HS_SERVICE::META, {.size_pct = 10.0}}, {HS_SERVICE::INDEX, {.size_pct = 70.0}}});
 
@@ -89,7 +197,110 @@ struct IndexBtreeBenchmark : public BtreeTestHelper< TestType > {
 
     void run_benchmark() { this->run_in_parallel(m_op_list); }
 
+    // Loads keys [0, nkeys) directly, without the shadow map the test ops keep
+    void ycsb_load(uint64_t nkeys) {
+        auto const nfibers = this->m_fibers.size();
+        run_on_fibers([this, nkeys, nfibers](uint32_t fiber_idx) {
+            for (uint64_t k{fiber_idx}; k < nkeys; k += nfibers) {
+                K key{k};
+                V value = V::generate_rand();
+                auto req = BtreeSinglePutRequest{&key, &value, btree_put_type::INSERT};
+                this->m_bt->put(req);
+            }
+        });
+        m_next_insert_key.store(nkeys);
+    }
+
+    // Runs nops of the workload spread across the fibers and returns the latencies of each op type
+    std::array< std::vector< uint64_t >, num_ycsb_ops > ycsb_run(ycsb_workload const& wl, uint64_t nkeys,
+                                                                 uint64_t nops) {
+        ZipfianGenerator const zipf{nkeys, SISL_OPTIONS["zipf_theta"].as< double >()};
+        auto const scan_len = SISL_OPTIONS["scan_len"].as< uint32_t >();
+        auto const nfibers = this->m_fibers.size();
+        std::mutex mtx;
+        std::array< std::vector< uint64_t >, num_ycsb_ops > latencies;
+
+        run_on_fibers([&](uint32_t fiber_idx) {
+            std::default_random_engine re{std::random_device{}()};
+            std::discrete_distribution< uint32_t > op_dist(wl.pct.begin(), wl.pct.end());
+            std::array< std::vector< uint64_t >, num_ycsb_ops > my_latencies;
+
+            for (uint64_t i{fiber_idx}; i < nops; i += nfibers) {
+                auto const op = ycsb_op_t(op_dist(re));
+                auto const k = (op == ycsb_op_t::insert) ? m_next_insert_key.fetch_add(1) : zipf(re);
+                auto const start = Clock::now();
+                do_ycsb_op(op, k, scan_len);
+                my_latencies[uint32_t(op)].push_back(get_elapsed_time_ns(start));
+            }
+
+            std::unique_lock lg{mtx};
+            for (uint32_t op{0}; op < num_ycsb_ops; ++op) {
+                latencies[op].insert(latencies[op].end(), my_latencies[op].begin(), my_latencies[op].end());
+            }
+        });
+        return latencies;
+    }
+
+private:
+    void run_on_fibers(std::function< void(uint32_t) > const& fn) {
+        auto pending = this->m_fibers.size();
+        std::mutex mtx;
+        std::condition_variable cv;
+        for (uint32_t fiber_idx{0}; fiber_idx < this->m_fibers.size(); ++fiber_idx) {
+            iomanager.run_on_forget(this->m_fibers[fiber_idx], [&, fiber_idx]() {
+                fn(fiber_idx);
+                std::unique_lock lg{mtx};
+                if (--pending == 0) { cv.notify_one(); }
+            });
+        }
+        std::unique_lock lg{mtx};
+        cv.wait(lg, [&pending] { return pending == 0; });
+    }
+
+    void do_ycsb_op(ycsb_op_t op, uint64_t k, uint32_t scan_len) {
+        // Range puts of interval values assign consecutive values across the range, so they are upserts
+        auto const range_put_type =
+            std::is_same_v< V, TestIntervalValue > ? btree_put_type::UPSERT : btree_put_type::UPDATE;
+        K key{k};
+        switch (op) {
+        case ycsb_op_t::read: {
+            V value;
+            auto req = BtreeSingleGetRequest{&key, &value};
+            this->m_bt->get(req);
+            break;
+        }
+        case ycsb_op_t::update:
+        case ycsb_op_t::insert: {
+            V value = V::generate_rand();
+            auto req = BtreeSinglePutRequest{
+                &key, &value, (op == ycsb_op_t::insert) ? btree_put_type::INSERT : btree_put_type::UPDATE};
+            this->m_bt->put(req);
+            break;
+        }
+        case ycsb_op_t::scan: {
+            std::vector< std::pair< K, V > > out;
+            auto req = BtreeQueryRequest< K >{BtreeKeyRange< K >{key, true, K{k + scan_len - 1}, true},
+                                              BtreeQueryType::SWEEP_NON_INTRUSIVE_PAGINATION_QUERY, scan_len};
+            this->m_bt->query(req, out);
+            break;
+        }
+        case ycsb_op_t::range_update: {
+            V value = V::generate_rand();
+            auto req = BtreeRangePutRequest< K >{BtreeKeyRange< K >{key, true, K{k + scan_len - 1}, true},
+                                                 range_put_type, &value};
+            this->m_bt->put(req);
+            break;
+        }
+        case ycsb_op_t::range_remove: {
+            auto req = BtreeRangeRemoveRequest< K >{BtreeKeyRange< K >{key, true, K{k + scan_len - 1}, true}};
+            this->m_bt->remove(req);
+            break;
+        }
+        }
+    }
+
 private:
+    std::atomic< uint64_t > m_next_insert_key{0};
     test_common::HSTestHelper m_helper;
     std::vector< std::pair< std::string, int > > m_op_list;
 };
@@ -128,14 +339,87 @@ void run_benchmark(benchmark::State& state) {
     add_custom_counter< BenchmarkType >(state);
 }
 
+// Loads record_count keys and runs ycsb_ops of the workload, reporting the throughput and latency percentiles of all
+// ops and of each op type. With cp_flush, a cp is flushed every cp_interval_ms during the run, to measure the impact
+// of the cp flush on the foreground ops and the cp flush latency under load.
+template < class BenchmarkType >
+void run_ycsb(benchmark::State& state, ycsb_workload const& wl, bool cp_flush) {
+    auto const nkeys = SISL_OPTIONS["record_count"].as< uint32_t >();
+    auto const nops = SISL_OPTIONS["ycsb_ops"].as< uint32_t >();
+    auto helper = std::make_unique< IndexBtreeBenchmark< BenchmarkType > >();
+    helper->ycsb_load(nkeys);
+    hs()->cp_mgr().trigger_cp_flush(true /* force */).get();
+
+    std::array< std::vector< uint64_t >, num_ycsb_ops > latencies;
+    std::vector< uint64_t > cp_latencies;
+    for (auto _ : state) {
+        std::atomic< bool > done{false};
+        std::thread cp_thread;
+        if (cp_flush) {
+            cp_thread = std::thread([&done, &cp_latencies]() {
+                auto const interval = std::chrono::milliseconds{SISL_OPTIONS["cp_interval_ms"].as< uint32_t >()};
+                while (!done.load()) {
+                    std::this_thread::sleep_for(interval);
+                    auto const start = Clock::now();
+                    hs()->cp_mgr().trigger_cp_flush(true /* force */).get();
+                    cp_latencies.push_back(get_elapsed_time_ns(start));
+                }
+            });
+        }
+
+        auto const start = Clock::now();
+        latencies = helper->ycsb_run(wl, nkeys, nops);
+        state.SetIterationTime(get_elapsed_time_ns(start) / 1e9);
+        done.store(true);
+        if (cp_thread.joinable()) { cp_thread.join(); }
+    }
+
+    std::vector< uint64_t > all;
+    for (uint32_t op{0}; op < num_ycsb_ops; ++op) {
+        all.insert(all.end(), latencies[op].begin(), latencies[op].end());
+        test_common::report_percentiles(state, enum_name(ycsb_op_t(op)), latencies[op]);
+    }
+    test_common::report_percentiles(state, "all", all);
+    state.SetItemsProcessed(int64_t(all.size()));
+    state.counters["cache_mb"] = resource_mgr().get_cache_size() / (1024.0 * 1024);
+    state.counters["fiber_num"] = SISL_OPTIONS["num_fibers"].as< uint32_t >();
+    if (cp_flush) {
+        state.counters["cp_flushes"] = cp_latencies.size();
+        test_common::report_percentiles(state, "cp_flush", cp_latencies);
+    }
+}
+
+template < class BenchmarkType >
+void register_ycsb_benchmarks(std::string const& btree_type) {
+    for (auto const& wl : s_workloads) {
+        benchmark::RegisterBenchmark((btree_type + "/ycsb_" + wl.name).c_str(), run_ycsb< BenchmarkType >, wl, false)
+            ->Iterations(1)
+            ->UseManualTime();
+    }
+    // CP flush under the update heavy and the range heavy loads
+    for (auto const& wl : {s_workloads[0], s_workloads[5]}) {
+        benchmark::RegisterBenchmark((btree_type + "/ycsb_" + wl.name + "/cp_flush").c_str(), run_ycsb< BenchmarkType >,
+                                     wl, true)
+            ->Iterations(1)
+            ->UseManualTime();
+    }
+}
+
 INDEX_BTREE_BENCHMARK(FixedLenBtree)
 INDEX_BTREE_BENCHMARK(VarKeySizeBtree)
 INDEX_BTREE_BENCHMARK(VarValueSizeBtree)
 INDEX_BTREE_BENCHMARK(VarObjSizeBtree)
-// INDEX_BTREE_BENCHMARK(PrefixIntervalBtree)
+INDEX_BTREE_BENCHMARK(CompactBtree)
+INDEX_BTREE_BENCHMARK(PrefixIntervalBtree)
 
 int main(int argc, char** argv) {
     SISL_OPTIONS_LOAD(argc, argv, logging, index_btree_benchmark, iomgr, test_common_setup);
+    register_ycsb_benchmarks< FixedLenBtree >("FixedLenBtree");
+    register_ycsb_benchmarks< VarKeySizeBtree >("VarKeySizeBtree");
+    register_ycsb_benchmarks< VarValueSizeBtree >("VarValueSizeBtree");
+    register_ycsb_benchmarks< VarObjSizeBtree >("VarObjSizeBtree");
+    register_ycsb_benchmarks< CompactBtree >("CompactBtree");
+    register_ycsb_benchmarks< PrefixIntervalBtree >("PrefixIntervalBtree");
     ::benchmark::Initialize(&argc, argv);
     ::benchmark::RunSpecifiedBenchmarks();
 }
@@ -13,130 +13,450 @@
  * specific language governing permissions and limitations under the License.
  *
  *********************************************************************************/
+#include <time.h>
+#include <algorithm>
+#include <atomic>
 #include <condition_variable>
-#include <cstdint>
-#include <filesystem>
-#include <fstream>
-#include <iostream>
+#include <future>
+#include <memory>
 #include <mutex>
+#include <random>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include <benchmark/benchmark.h>
+#include <iomgr/io_environment.hpp>
 #include <sisl/logging/logging.h>
 #include <sisl/options/options.h>
-
+#include <homestore/homestore.hpp>
+#include <homestore/logstore_service.hpp>
+#include <homestore/logstore/log_store.hpp>
+#include "common/homestore_config.hpp"
+#include "device/journal_vdev.hpp"
 #include "logstore/log_dev.hpp"
+#include "test_common/homestore_test_common.hpp"
+#include "test_common/benchmark_common.hpp"
 
+using namespace homestore;
 SISL_LOGGING_INIT(HOMESTORE_LOG_MODS)
-RCU_REGISTER_INIT
 
-static constexpr size_t ITERATIONS{100000};
-static constexpr size_t THREADS{64};
+SISL_OPTIONS_ENABLE(logging, log_dev_benchmark, iomgr, test_common_setup)
+SISL_OPTION_GROUP(log_dev_benchmark,
+                  (group_size_kb, "", "group_size_kb", "data size of each log group built by bm_log_group_build",
+                   ::cxxopts::value< uint32_t >()->default_value("256"), "number"),
+                  (truncate_every, "", "truncate_every", "truncate the log store every these many flushes",
+                   ::cxxopts::value< uint32_t >()->default_value("256"), "number"),
+                  (read_records, "", "read_records", "number of flushed records bm_logstore_read reads from",
+                   ::cxxopts::value< uint32_t >()->default_value("16384"), "number"));
+
+// CPU cost of the log flush path per MB of log data:
+// bm_log_group_build: Building a log group (copying the inlined records and the checksum) without any io, which is
+// the part of the flush done under the flush lock.
+// bm_logdev_append: Appending qdepth records and flushing them to the journal on the file backed devices, reporting
+// the cpu of the flushing thread (which includes the group build, io submission and completion callbacks).
+//
+// Journal performance on the file backed devices (or the devices of --device_list):
+// bm_logstore_append_threads: Append throughput of nthreads threads appending to their own log store of a shared
+// logdev, flushed inline and by timer like the raft logdevs.
+// bm_logdev_flush_latency: Latency percentiles from append to completion for each flush mode.
+// bm_logstore_read: read_sync latency percentiles of flushed records and of records not yet flushed, which are
+// flushed by the read.
+// bm_logstore_truncate: Cost of truncating a log store and the logdev after appending the given number of records.
+// bm_logdev_recovery: Time to recover a logdev holding the given MB of records on restart, per GB.
+static test_common::HSTestHelper s_helper;
+static uint64_t constexpr one_mb{1024 * 1024};
+
+static uint64_t thread_cpu_ns() {
+    struct timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return uint64_t(ts.tv_sec) * 1000000000ul + ts.tv_nsec;
+}
+
+static uint32_t flush_size_multiple() {
+    auto const sz = HS_DYNAMIC_CONFIG(logstore->flush_size_multiple_logdev);
+    return sz ? uint32_cast(sz) : logstore_service().get_vdev()->optimal_page_size();
+}
+
+static uint64_t elapsed_ns(Clock::time_point start) {
+    return std::chrono::duration_cast< std::chrono::nanoseconds >(Clock::now() - start).count();
+}
+
+// Waits for the completion callbacks of the appends, which are called in the flushing thread
+class CompletionWaiter {
+public:
+    void done() {
+        std::unique_lock lg{m_mtx};
+        if (++m_ncompleted >= m_target) { m_cv.notify_all(); }
+    }
 
-static std::vector< logdev_key > s_log_keys;
-static uint64_t first_offset{~static_cast< uint64_t >(0)};
+    void wait_for(uint64_t ncompleted) {
+        std::unique_lock lg{m_mtx};
+        m_target = ncompleted;
+        m_cv.wait(lg, [this] { return m_ncompleted >= m_target; });
+    }
 
-void test_append(benchmark::State& state) {
-    uint64_t counter{0};
-    for ([[maybe_unused]] auto current_state : state) { // Loops upto iteration count
-        my_request* req{nullptr};
-        benchmark::DoNotOptimize(req = new my_request());
-        LogDev::instance()->append();
+    uint64_t completed() {
+        std::unique_lock lg{m_mtx};
+        return m_ncompleted;
     }
-    std::cout << "Counter = " << counter << "\n";
+
+private:
+    std::mutex m_mtx;
+    std::condition_variable m_cv;
+    uint64_t m_ncompleted{0};
+    uint64_t m_target{0};
+};
+
+// Records of the given size, inlined ones are deliberately not dma aligned
+class BenchRecords {
+public:
+    BenchRecords(uint32_t rec_size, uint32_t nrecords, bool inlined) {
+        auto const align = flush_size_multiple();
+        m_buf = iomanager.iobuf_alloc(align, uint64_t(rec_size + align) * nrecords);
+        test_common::HSTestHelper::fill_data_buf(m_buf, uint64_t(rec_size + align) * nrecords);
+        for (uint32_t i{0}; i < nrecords; ++i) {
+            auto const data = m_buf + uint64_t(rec_size + align) * i + (inlined ? 8 : 0);
+            m_blobs.emplace_back(data, rec_size, !inlined);
+        }
+    }
+    ~BenchRecords() { iomanager.iobuf_free(m_buf); }
+
+    std::vector< sisl::io_blob > const& blobs() const { return m_blobs; }
+
+private:
+    uint8_t* m_buf;
+    std::vector< sisl::io_blob > m_blobs;
+};
+
+static void bm_log_group_build(benchmark::State& state) {
+    auto const rec_size = uint32_t(state.range(0));
+    bool const inlined = (state.range(1) != 0);
+    auto const group_size = SISL_OPTIONS["group_size_kb"].as< uint32_t >() * 1024;
+    auto const nrecords =
+        std::clamp(group_size / rec_size, 1u, uint32_t(LogGroup::max_records_in_a_batch)); // records per group
+
+    BenchRecords recs{rec_size, nrecords, inlined};
+    std::vector< std::unique_ptr< log_record > > records;
+    for (uint32_t i{0}; i < nrecords; ++i) {
+        records.emplace_back(std::make_unique< log_record >(0, i, recs.blobs()[i], nullptr));
+    }
+
+    LogGroup lg;
+    lg.start(flush_size_multiple(), logstore_service().get_vdev()->align_size());
+    crc32_t crc{0};
+    auto const cpu_start_ns = thread_cpu_ns();
+    for (auto _ : state) {
+        lg.reset(nrecords);
+        for (uint32_t i{0}; i < nrecords; ++i) {
+            lg.add_record(*records[i], i);
+        }
+        lg.finish(0, crc);
+        crc = lg.header()->cur_grp_crc;
+    }
+    auto const cpu_ns = thread_cpu_ns() - cpu_start_ns;
+    lg.stop();
+
+    auto const bytes = double(state.iterations()) * nrecords * rec_size;
+    state.SetBytesProcessed(int64_t(bytes));
+    state.counters["cpu_us_per_mb"] = (cpu_ns / 1000.0) / std::max(bytes / one_mb, 1e-9);
 }
 
-[[nodiscard]] static std::shared_ptr< iomgr::ioMgr > start_homestore(const uint32_t ndevices, const uint64_t dev_size,
-                                                                     const uint32_t nthreads) {
-    std::vector< dev_info > device_info;
-    // these should be static so that they stay in scope in the lambda in case function ends before lambda completes
-    static std::mutex start_mutex;
-    static std::condition_variable cv;
-    static bool inited;
-
-    inited = false;
-    LOGINFO("creating {} device files with each of size {} ", ndevices, dev_size);
-    for (uint32_t i{0}; i < ndevices; ++i) {
-        const std::filesystem::path fpath{"/tmp/" + std::to_string(i + 1)};
-        std::ofstream ofs{fpath.string(), std::ios::binary | std::ios::out};
-        std::filesystem::resize_file(fpath, dev_size);
-        device_info.emplace_back(std::filesystem::canonical(fpath).string(), HSDevType::Data);
+static void bm_logdev_append(benchmark::State& state) {
+    auto const rec_size = uint32_t(state.range(0));
+    bool const inlined = (state.range(1) != 0);
+    auto const qdepth = SISL_OPTIONS["qdepth"].as< uint32_t >();
+    auto const truncate_every = SISL_OPTIONS["truncate_every"].as< uint32_t >();
+
+    auto const logdev_id = logstore_service().create_new_logdev(flush_mode_t::EXPLICIT);
+    auto log_store = logstore_service().create_new_log_store(logdev_id, true /* append_mode */);
+    BenchRecords recs{rec_size, qdepth, inlined};
+
+    uint64_t append_ns{0};
+    uint64_t flush_ns{0};
+    uint64_t ncompleted{0};
+    uint64_t nflushes{0};
+    logstore_seq_num_t last_lsn{-1};
+    for (auto _ : state) {
+        auto const start_ns = thread_cpu_ns();
+        for (auto const& blob : recs.blobs()) {
+            last_lsn = log_store->append_async(blob, nullptr,
+                                               [&ncompleted](logstore_seq_num_t, sisl::io_blob&, logdev_key,
+                                                             void*) { ++ncompleted; });
+        }
+        auto const flush_start_ns = thread_cpu_ns();
+        log_store->flush();
+        auto const end_ns = thread_cpu_ns();
+        append_ns += flush_start_ns - start_ns;
+        flush_ns += end_ns - flush_start_ns;
+
+        if ((++nflushes % truncate_every) == 0) {
+            state.PauseTiming();
+            log_store->truncate(last_lsn);
+            logstore_service().device_truncate();
+            state.ResumeTiming();
+        }
     }
 
-    LOGINFO("Creating iomgr with {} threads", nthreads);
-    auto iomgr_obj{std::make_shared< iomgr::ioMgr >(2, nthreads)};
-
-    const uint64_t app_mem_size{((ndevices * dev_size) * 15) / 100};
-    LOGINFO("Initialize and start HomeBlks with app_mem_size = {}", app_mem_size);
-
-    boost::uuids::string_generator gen;
-    init_params params;
-    params.open_flags = homestore::io_flag::DIRECT_IO;
-    params.min_virtual_page_size = 4096;
-    params.app_mem_size = app_mem_size;
-    params.devices = device_info;
-    params.iomgr = iomgr_obj;
-    params.init_done_cb = [&iomgr_obj, &tl_start_mutex = start_mutex, &tl_cv = cv,
-                           &tl_inited = inited](std::error_condition err, const out_params& params) {
-        iomgr_obj->start();
-        LOGINFO("HomeBlks Init completed");
-        {
-            std::unique_lock< std::mutex > lk{tl_start_mutex};
-            tl_inited = true;
+    auto const mbs = std::max((double(state.iterations()) * qdepth * rec_size) / one_mb, 1e-9);
+    state.SetBytesProcessed(int64_t(state.iterations()) * qdepth * rec_size);
+    state.counters["append_cpu_us_per_mb"] = (append_ns / 1000.0) / mbs;
+    state.counters["flush_cpu_us_per_mb"] = (flush_ns / 1000.0) / mbs;
+    state.counters["incomplete"] = double(nflushes) * qdepth - ncompleted;
+
+    logstore_service().remove_log_store(logdev_id, log_store->get_store_id());
+    logstore_service().destroy_log_dev(logdev_id);
+}
+
+static void bm_logstore_append_threads(benchmark::State& state) {
+    auto const rec_size = uint32_t(state.range(0));
+    auto const nthreads = uint32_t(state.range(1));
+    auto const qdepth = SISL_OPTIONS["qdepth"].as< uint32_t >();
+    auto const truncate_every = SISL_OPTIONS["truncate_every"].as< uint32_t >();
+
+    auto const logdev_id = logstore_service().create_new_logdev(flush_mode_t::INLINE | flush_mode_t::TIMER);
+    std::vector< std::shared_ptr< HomeLogStore > > log_stores;
+    std::vector< std::unique_ptr< BenchRecords > > recs;
+    for (uint32_t t{0}; t < nthreads; ++t) {
+        log_stores.emplace_back(logstore_service().create_new_log_store(logdev_id, true /* append_mode */));
+        recs.emplace_back(std::make_unique< BenchRecords >(rec_size, qdepth, true /* inlined */));
+    }
+
+    CompletionWaiter waiter;
+    uint64_t nappends{0};
+    uint64_t niters{0};
+    for (auto _ : state) {
+        std::vector< std::thread > threads;
+        for (uint32_t t{0}; t < nthreads; ++t) {
+            threads.emplace_back([&, t]() {
+                for (auto const& blob : recs[t]->blobs()) {
+                    log_stores[t]->append_async(blob, nullptr,
+                                                [&waiter](logstore_seq_num_t, sisl::io_blob&, logdev_key, void*) {
+                                                    waiter.done();
+                                                });
+                }
+            });
+        }
+        for (auto& thr : threads) {
+            thr.join();
+        }
+        nappends += uint64_t(nthreads) * qdepth;
+        waiter.wait_for(nappends);
+
+        if ((++niters % truncate_every) == 0) {
+            state.PauseTiming();
+            for (auto& log_store : log_stores) {
+                log_store->truncate(log_store->get_contiguous_completed_seq_num(-1));
+            }
+            logstore_service().device_truncate();
+            state.ResumeTiming();
         }
-        tl_cv.notify_one();
-    };
-    params.vol_mounted_cb = [](const VolumePtr& vol_obj, vol_state state) {};
-    params.vol_state_change_cb = [](const VolumePtr& vol, vol_state old_state, vol_state new_state) {};
-    params.vol_found_cb = [](boost::uuids::uuid uuid) -> bool { return true; };
-    VolInterface::init(params);
-
-    {
-        std::unique_lock< std::mutex > lk{start_mutex};
-        cv.wait(lk, [] { return inited; });
     }
-    return iomgr_obj;
+
+    state.SetItemsProcessed(int64_t(nappends));
+    state.SetBytesProcessed(int64_t(nappends * rec_size));
+    for (auto& log_store : log_stores) {
+        logstore_service().remove_log_store(logdev_id, log_store->get_store_id());
+    }
+    logstore_service().destroy_log_dev(logdev_id);
 }
 
-static void on_append_completion(const logdev_key lkey, void* const ctx) {
-    s_log_keys.push_back(lkey);
-    LOGINFO("Append completed with log_idx = {} offset = {}", lkey.idx, lkey.dev_offset);
-    if (first_offset == ~static_cast< uint64_t >(0)) { first_offset = lkey.dev_offset; }
+static void bm_logdev_flush_latency(benchmark::State& state) {
+    auto const rec_size = uint32_t(state.range(0));
+    auto const mode = flush_mode_t(state.range(1));
+    auto const qdepth = SISL_OPTIONS["qdepth"].as< uint32_t >();
+    auto const truncate_every = SISL_OPTIONS["truncate_every"].as< uint32_t >();
+
+    // An inline flush is attempted only on append, so the records of the batch appended after the last inline flush
+    // are flushed explicitly instead of waiting for the next batch.
+    auto const logdev_mode = (mode == flush_mode_t::INLINE) ? (flush_mode_t::INLINE | flush_mode_t::EXPLICIT) : mode;
+    auto const logdev_id = logstore_service().create_new_logdev(logdev_mode);
+    auto log_store = logstore_service().create_new_log_store(logdev_id, true /* append_mode */);
+    BenchRecords recs{rec_size, qdepth, true /* inlined */};
+
+    CompletionWaiter waiter;
+    std::vector< Clock::time_point > append_times(qdepth);
+    std::vector< uint64_t > latencies_ns;
+    uint64_t nappends{0};
+    uint64_t niters{0};
+    for (auto _ : state) {
+        for (uint32_t i{0}; i < qdepth; ++i) {
+            append_times[i] = Clock::now();
+            log_store->append_async(recs.blobs()[i], &append_times[i],
+                                    [&waiter, &latencies_ns](logstore_seq_num_t, sisl::io_blob&, logdev_key,
+                                                             void* cookie) {
+                                        latencies_ns.push_back(elapsed_ns(*static_cast< Clock::time_point* >(cookie)));
+                                        waiter.done();
+                                    });
+        }
+        if (mode != flush_mode_t::TIMER) { log_store->flush(); }
+        nappends += qdepth;
+        waiter.wait_for(nappends);
+
+        if ((++niters % truncate_every) == 0) {
+            state.PauseTiming();
+            log_store->truncate(log_store->get_contiguous_completed_seq_num(-1));
+            logstore_service().device_truncate();
+            state.ResumeTiming();
+        }
+    }
+
+    state.SetItemsProcessed(int64_t(nappends));
+    state.SetBytesProcessed(int64_t(nappends * rec_size));
+    test_common::report_percentiles(state, "flush", latencies_ns);
+    logstore_service().remove_log_store(logdev_id, log_store->get_store_id());
+    logstore_service().destroy_log_dev(logdev_id);
 }
 
-static void on_log_found(const logdev_key lkey, const log_buffer buf) {
-    s_log_keys.push_back(lkey);
-    LOGINFO("Found a log with log_idx = {} offset = {}", lkey.idx, lkey.dev_offset);
+static void bm_logstore_read(benchmark::State& state) {
+    auto const rec_size = uint32_t(state.range(0));
+    bool const flushed = (state.range(1) != 0);
+    auto const nrecords = SISL_OPTIONS["read_records"].as< uint32_t >();
+
+    auto const logdev_id = logstore_service().create_new_logdev(flush_mode_t::EXPLICIT);
+    auto log_store = logstore_service().create_new_log_store(logdev_id, true /* append_mode */);
+    BenchRecords recs{rec_size, 1, true /* inlined */};
+    if (flushed) {
+        for (uint32_t i{0}; i < nrecords; ++i) {
+            log_store->append_async(recs.blobs()[0], nullptr, nullptr);
+        }
+        log_store->flush();
+    }
+
+    std::default_random_engine re{std::random_device{}()};
+    std::uniform_int_distribution< logstore_seq_num_t > lsn_dist{0, logstore_seq_num_t(nrecords) - 1};
+    std::vector< uint64_t > latencies_ns;
+    for (auto _ : state) {
+        logstore_seq_num_t lsn;
+        if (flushed) {
+            lsn = lsn_dist(re);
+        } else {
+            // The read has to flush the record first
+            lsn = log_store->append_async(recs.blobs()[0], nullptr, nullptr);
+        }
+        auto const start = Clock::now();
+        auto const buf = log_store->read_sync(lsn);
+        auto const ns = elapsed_ns(start);
+        benchmark::DoNotOptimize(buf.bytes());
+        latencies_ns.push_back(ns);
+        state.SetIterationTime(ns / 1e9);
+    }
+
+    state.SetBytesProcessed(int64_t(state.iterations()) * rec_size);
+    test_common::report_percentiles(state, "read", latencies_ns);
+    logstore_service().remove_log_store(logdev_id, log_store->get_store_id());
+    logstore_service().destroy_log_dev(logdev_id);
 }
 
-static void setup() {
-    auto iomgr_obj = start_homestore(SISL_OPTIONS["num_devs"].as< uint32_t >(),
-                                     SISL_OPTIONS["dev_size_mb"].as< uint64_t >() * 1024 * 1024,
-                                     SISL_OPTIONS["num_threads"].as< uint32_t >());
+static void bm_logstore_truncate(benchmark::State& state) {
+    auto const nrecords = uint32_t(state.range(0));
+    auto const rec_size = uint32_t{4096};
+
+    auto const logdev_id = logstore_service().create_new_logdev(flush_mode_t::EXPLICIT);
+    auto log_store = logstore_service().create_new_log_store(logdev_id, true /* append_mode */);
+    BenchRecords recs{rec_size, 1, true /* inlined */};
+
+    std::vector< uint64_t > store_ns;
+    std::vector< uint64_t > device_ns;
+    for (auto _ : state) {
+        logstore_seq_num_t last_lsn{-1};
+        for (uint32_t i{0}; i < nrecords; ++i) {
+            last_lsn = log_store->append_async(recs.blobs()[0], nullptr, nullptr);
+        }
+        log_store->flush();
+
+        auto const start = Clock::now();
+        log_store->truncate(last_lsn);
+        auto const truncated = Clock::now();
+        logstore_service().device_truncate();
+        store_ns.push_back(std::chrono::duration_cast< std::chrono::nanoseconds >(truncated - start).count());
+        device_ns.push_back(elapsed_ns(truncated));
+        state.SetIterationTime((store_ns.back() + device_ns.back()) / 1e9);
+    }
 
-    LogDev::instance()->register_append_cb(on_append_completion);
-    LogDev::instance()->register_logfound_cb(on_log_found);
+    test_common::report_percentiles(state, "store_truncate", store_ns);
+    test_common::report_percentiles(state, "device_truncate", device_ns);
+    logstore_service().remove_log_store(logdev_id, log_store->get_store_id());
+    logstore_service().destroy_log_dev(logdev_id);
 }
 
-SISL_OPTIONS_ENABLE(logging, log_dev_benchmark)
-SISL_OPTION_GROUP(log_dev_benchmark,
-                  (num_threads, "", "num_threads", "number of threads",
-                   ::cxxopts::value< uint32_t >()->default_value("2"), "number"),
-                  (num_devs, "", "num_devs", "number of devices to create",
-                   ::cxxopts::value< uint32_t >()->default_value("2"), "number"),
-                  (dev_size_mb, "", "dev_size_mb", "size of each device in MB",
-                   ::cxxopts::value< uint64_t >()->default_value("5120"), "number"));
+static void bm_logdev_recovery(benchmark::State& state) {
+    auto const journal_size = uint64_t(state.range(0)) * one_mb;
+    auto const rec_size = uint32_t{4096};
+    auto const batch = LogGroup::max_records_in_a_batch;
+
+    for (auto _ : state) {
+        auto const logdev_id = logstore_service().create_new_logdev(flush_mode_t::EXPLICIT);
+        logstore_id_t store_id;
+        {
+            auto log_store = logstore_service().create_new_log_store(logdev_id, true /* append_mode */);
+            store_id = log_store->get_store_id();
+            BenchRecords recs{rec_size, 1, true /* inlined */};
+            for (uint64_t written{0}; written < journal_size; written += uint64_t(batch) * rec_size) {
+                for (uint32_t i{0}; i < batch; ++i) {
+                    log_store->append_async(recs.blobs()[0], nullptr, nullptr);
+                }
+                log_store->flush();
+            }
+        }
+
+        // Recovery is done by the time homestore start returns and the log store is opened
+        Clock::time_point start;
+        std::promise< std::shared_ptr< HomeLogStore > > p;
+        s_helper.change_start_cb([&]() {
+            start = Clock::now();
+            logstore_service().open_logdev(logdev_id, flush_mode_t::EXPLICIT);
+            logstore_service().open_log_store(logdev_id, store_id, true /* append_mode */).thenValue([&p](auto store) {
+                p.set_value(store);
+            });
+        });
+        s_helper.restart_homestore(0 /* shutdown_delay_sec */);
+        auto log_store = p.get_future().get();
+        auto const ns = elapsed_ns(start);
+        state.SetIterationTime(ns / 1e9);
+        state.counters["recovery_sec_per_gb"] = (ns / 1e9) / (double(journal_size) / (one_mb * 1024));
+        s_helper.change_start_cb(nullptr);
+
+        log_store.reset();
+        logstore_service().remove_log_store(logdev_id, store_id);
+        logstore_service().destroy_log_dev(logdev_id);
+    }
+}
 
-BENCHMARK(test_append)->Iterations(ITERATIONS)->Threads(THREADS);
+#define LOG_RECORD_ARGS ->ArgNames({"rec_size", "inlined"})->ArgsProduct({{64, 512, 4096, 65536}, {0, 1}})
+BENCHMARK(bm_log_group_build) LOG_RECORD_ARGS;
+BENCHMARK(bm_logdev_append) LOG_RECORD_ARGS->UseRealTime();
+BENCHMARK(bm_logstore_append_threads)
+    ->ArgNames({"rec_size", "nthreads"})
+    ->ArgsProduct({{512, 4096, 65536}, {1, 2, 4, 8}})
+    ->UseRealTime();
+BENCHMARK(bm_logdev_flush_latency)
+    ->ArgNames({"rec_size", "flush_mode"})
+    ->ArgsProduct({{512, 4096, 65536},
+                   {uint32_t(flush_mode_t::INLINE), uint32_t(flush_mode_t::TIMER), uint32_t(flush_mode_t::EXPLICIT)}})
+    ->UseRealTime();
+BENCHMARK(bm_logstore_read)
+    ->ArgNames({"rec_size", "flushed"})
+    ->ArgsProduct({{512, 4096, 65536}, {1, 0}})
+    ->UseManualTime();
+BENCHMARK(bm_logstore_truncate)->ArgName("nrecords")->Arg(256)->Arg(4096)->Arg(65536)->UseManualTime();
+BENCHMARK(bm_logdev_recovery)
+    ->ArgName("journal_mb")
+    ->Arg(64)
+    ->Arg(256)
+    ->Arg(1024)
+    ->Iterations(1)
+    ->UseManualTime()
+    ->Unit(benchmark::kMillisecond);
 
-SISL_OPTIONS_ENABLE(logging)
 int main(int argc, char** argv) {
-    SISL_OPTIONS_LOAD(argc, argv, logging, log_dev_benchmark)
+    ::benchmark::Initialize(&argc, argv); // Strips off the benchmark specific options
+    SISL_OPTIONS_LOAD(argc, argv, logging, log_dev_benchmark, iomgr, test_common_setup)
     sisl::logging::SetLogger("log_dev_benchmark");
     spdlog::set_pattern("[%D %T%z] [%^%l%$] [%n] [%t] %v");
 
-    setup();
-    ::benchmark::Initialize(&argc, argv);
+    s_helper.start_homestore("test_log_dev_bench",
+                             {{HS_SERVICE::META, {.size_pct = 5.0}}, {HS_SERVICE::LOG, {.size_pct = 80.0}}});
     ::benchmark::RunSpecifiedBenchmarks();
+    s_helper.shutdown_homestore();
 }
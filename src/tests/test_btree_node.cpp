@@ -23,6 +23,7 @@
 #include <homestore/btree/detail/simple_node.hpp>
 #include <homestore/btree/detail/varlen_node.hpp>
 #include <homestore/btree/detail/prefix_node.hpp>
+#include <homestore/btree/detail/compact_node.hpp>
 #include "btree_helpers/btree_test_kvs.hpp"
 
 static constexpr uint32_t g_node_size{4096};
@@ -63,6 +64,12 @@ struct PrefixIntervalBtreeTest {
     using ValueType = TestIntervalValue;
 };
 
+struct CompactNodeTest {
+    using NodeType = CompactNode< TestFixedKey, TestFixedValue >;
+    using KeyType = TestFixedKey;
+    using ValueType = TestFixedValue;
+};
+
 template < typename TestType >
 struct NodeTest : public testing::Test {
     using T = TestType;
@@ -330,7 +337,7 @@ private:
 };
 
 using NodeTypes = testing::Types< FixedLenNodeTest, VarKeySizeNodeTest, VarValueSizeNodeTest, VarObjSizeNodeTest,
-                                  PrefixIntervalBtreeTest >;
+                                  PrefixIntervalBtreeTest, CompactNodeTest >;
 TYPED_TEST_SUITE(NodeTest, NodeTypes);
 
 TYPED_TEST(NodeTest, SequentialInsert) {
@@ -377,6 +384,29 @@ TYPED_TEST(NodeTest, SimpleInsert) {
     this->m_node1->copy_by_entries(this->m_cfg, *this->m_node2, 0, std::numeric_limits< uint32_t >::max());
 }
 
+TYPED_TEST(NodeTest, FullNodeLookup) {
+    // Fill the node with even keys, so that lookup of odd keys land in between entries
+    uint32_t max_key{0};
+    for (uint32_t i{0}; (i < g_max_keys && this->has_room()); i += 2) {
+        this->put(i, btree_put_type::INSERT);
+        max_key = i;
+    }
+    this->validate_key_order();
+    for (uint32_t k{0}; k <= max_key + 2; ++k) {
+        this->validate_specific(k);
+    }
+
+    // Punch holes at random places and validate lookups again
+    auto const nremoves = this->m_shadow_map.size() / 4;
+    for (uint32_t i{0}; i < nremoves; ++i) {
+        this->remove(2 * (g_randkey_generator(g_re) % (max_key / 2 + 1)), false /* validate_remove */);
+    }
+    for (uint32_t k{0}; k <= max_key + 2; ++k) {
+        this->validate_specific(k);
+    }
+    this->validate_get_all();
+}
+
 TYPED_TEST(NodeTest, RangeChangeInsert) {
     if (this->m_node1->get_node_type() != btree_node_type::PREFIX) { return; }
     this->put_range(0xFFFFFFFF - 10, 20);
@@ -0,0 +1,40 @@
+/*********************************************************************************
+ * Modifications Copyright 2017-2019 eBay Inc.
+ *
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *    https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed
+ * under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ *
+ *********************************************************************************/
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+namespace test_common {
+
+// Reports the p50, p99 and p999 of the latency samples (in ns) as <name>_p50_us etc counters of the benchmark. The
+// samples are sorted in place.
+inline void report_percentiles(benchmark::State& state, std::string const& name,
+                               std::vector< uint64_t >& samples_ns) {
+    if (samples_ns.empty()) { return; }
+    std::sort(samples_ns.begin(), samples_ns.end());
+    auto const pct = [&samples_ns](double p) {
+        return samples_ns[std::min(size_t(p * samples_ns.size()), samples_ns.size() - 1)] / 1000.0;
+    };
+    state.counters[name + "_p50_us"] = pct(0.50);
+    state.counters[name + "_p99_us"] = pct(0.99);
+    state.counters[name + "_p999_us"] = pct(0.999);
+}
+
+} // namespace test_common
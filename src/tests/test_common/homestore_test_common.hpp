@@ -164,6 +164,7 @@ public:
         uint32_t blk_size{0};
         shared< ChunkSelector > custom_chunk_selector{nullptr};
         shared< ChunkSelector > index_chunk_selector{nullptr};
+        chunk_selector_type_t chunk_sel_type{chunk_selector_type_t::ROUND_ROBIN}; // Used if no custom chunk selector
         IndexServiceCallbacks* index_svc_cbs{nullptr};
         shared< ReplApplication > repl_app{nullptr};
         chunk_num_t num_chunks{1};
@@ -480,19 +481,19 @@ private:
                    .alloc_type = svc_params[HS_SERVICE::DATA].blkalloc_type,
                    .chunk_sel_type = svc_params[HS_SERVICE::DATA].custom_chunk_selector
                        ? chunk_selector_type_t::CUSTOM
-                       : chunk_selector_type_t::ROUND_ROBIN}},
+                       : svc_params[HS_SERVICE::DATA].chunk_sel_type}},
                  {HS_SERVICE::INDEX,
                   {.dev_type = homestore::HSDevType::Fast,
                    .size_pct = svc_params[HS_SERVICE::INDEX].size_pct,
                    .chunk_sel_type = svc_params[HS_SERVICE::INDEX].custom_chunk_selector
                        ? chunk_selector_type_t::CUSTOM
-                       : chunk_selector_type_t::ROUND_ROBIN}},
+                       : svc_params[HS_SERVICE::INDEX].chunk_sel_type}},
                  {HS_SERVICE::REPLICATION,
                   {.size_pct = svc_params[HS_SERVICE::REPLICATION].size_pct,
                    .alloc_type = svc_params[HS_SERVICE::REPLICATION].blkalloc_type,
                    .chunk_sel_type = svc_params[HS_SERVICE::REPLICATION].custom_chunk_selector
                        ? chunk_selector_type_t::CUSTOM
-                       : chunk_selector_type_t::ROUND_ROBIN}}});
+                       : svc_params[HS_SERVICE::REPLICATION].chunk_sel_type}}});
         }
     }
 
@@ -0,0 +1,132 @@
+/*********************************************************************************
+ * Modifications Copyright 2017-2019 eBay Inc.
+ *
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *    https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed
+ * under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ *
+ *********************************************************************************/
+#include <random>
+#include <vector>
+
+#include <sisl/logging/logging.h>
+#include <sisl/options/options.h>
+#include <gtest/gtest.h>
+
+#include <homestore/crc.h>
+#include <homestore/homestore_decl.hpp>
+#include "crc_impl.h"
+
+SISL_LOGGING_INIT(HOMESTORE_LOG_MODS)
+SISL_OPTIONS_ENABLE(logging, test_crc)
+
+SISL_OPTION_GROUP(test_crc,
+                  (num_iterations, "", "num_iterations", "number of random buffers checked",
+                   ::cxxopts::value< uint32_t >()->default_value("5000"), "number"));
+
+using namespace homestore;
+
+class CrcTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        m_buf.resize(256 * 1024);
+        for (auto& b : m_buf) {
+            b = static_cast< unsigned char >(m_re());
+        }
+    }
+
+    // Checks every implementation against the bit at a time reference for a random slice of the buffer. Lengths
+    // around the 8 byte and 64 byte boundaries of slice8/pclmul are covered by the small lengths.
+    void check_random(uint64_t max_len) {
+        uint64_t const off = m_re() % 64;
+        uint64_t const len = m_re() % (max_len + 1);
+        auto const p = m_buf.data() + off;
+        auto const seed32 = static_cast< uint32_t >(m_re());
+        auto const seed16 = static_cast< uint16_t >(m_re());
+
+        auto const exp32 = crc::crc32_ieee_ref(seed32, p, len);
+        ASSERT_EQ(crc::crc32_ieee_slice8(seed32, p, len), exp32) << "len=" << len << " off=" << off;
+        ASSERT_EQ(crc::crc32_ieee_pclmul(seed32, p, len), exp32) << "len=" << len << " off=" << off;
+        ASSERT_EQ(crc::crc32_ieee_armv8(seed32, p, len), exp32) << "len=" << len << " off=" << off;
+        ASSERT_EQ(crc32_ieee(seed32, p, len), exp32) << "len=" << len << " off=" << off;
+
+        auto const exp16 = crc::crc16_t10dif_ref(seed16, p, len);
+        ASSERT_EQ(crc::crc16_t10dif_slice8(seed16, p, len), exp16) << "len=" << len << " off=" << off;
+        ASSERT_EQ(crc::crc16_t10dif_pclmul(seed16, p, len), exp16) << "len=" << len << " off=" << off;
+        ASSERT_EQ(crc16_t10dif(seed16, p, len), exp16) << "len=" << len << " off=" << off;
+    }
+
+    std::mt19937_64 m_re{std::random_device{}()};
+    std::vector< unsigned char > m_buf;
+};
+
+TEST_F(CrcTest, KnownValues) {
+    // Check values of the ISA-L crc32_ieee and crc16_t10dif for "123456789"
+    const unsigned char msg[] = "123456789";
+    ASSERT_EQ(crc::crc32_ieee_ref(0, msg, 9), 0xfc891918u);
+    ASSERT_EQ(crc::crc16_t10dif_ref(0, msg, 9), 0xd0dbu);
+    ASSERT_EQ(crc32_ieee(0, msg, 9), 0xfc891918u);
+    ASSERT_EQ(crc16_t10dif(0, msg, 9), 0xd0dbu);
+}
+
+TEST_F(CrcTest, SmallBuffers) {
+    LOGINFO("crc32_ieee impl={} crc16_t10dif impl={}", crc::crc32_ieee_impl_name(), crc::crc16_t10dif_impl_name());
+    for (uint32_t i{0}; i < SISL_OPTIONS["num_iterations"].as< uint32_t >(); ++i) {
+        check_random(300);
+    }
+}
+
+TEST_F(CrcTest, LargeBuffers) {
+    for (uint32_t i{0}; i < SISL_OPTIONS["num_iterations"].as< uint32_t >() / 10; ++i) {
+        check_random(m_buf.size() - 64);
+    }
+}
+
+TEST_F(CrcTest, Chained) {
+    // crc of a buffer computed in pieces, seeding each piece with the crc so far, has to match the crc of the whole
+    uint64_t const len = 64 * 1024;
+    auto const exp32 = crc32_ieee(0, m_buf.data(), len);
+    auto const exp16 = crc16_t10dif(0, m_buf.data(), len);
+
+    uint32_t c32{0};
+    uint16_t c16{0};
+    uint64_t off{0};
+    while (off < len) {
+        uint64_t const piece = std::min(len - off, m_re() % 5000);
+        c32 = crc32_ieee(c32, m_buf.data() + off, piece);
+        c16 = crc16_t10dif(c16, m_buf.data() + off, piece);
+        off += piece;
+    }
+    ASSERT_EQ(c32, exp32);
+    ASSERT_EQ(c16, exp16);
+}
+
+TEST_F(CrcTest, Combine) {
+    for (uint32_t i{0}; i < SISL_OPTIONS["num_iterations"].as< uint32_t >() / 10; ++i) {
+        uint64_t const len1 = m_re() % (m_buf.size() / 2);
+        uint64_t const len2 = (i < 100) ? i : m_re() % (m_buf.size() / 2);
+        auto const seed = (i % 2) ? init_crc32 : static_cast< uint32_t >(m_re());
+
+        auto const crc1 = crc32_ieee(seed, m_buf.data(), len1);
+        auto const crc2 = crc32_ieee(seed, m_buf.data() + len1, len2);
+        ASSERT_EQ(crc::crc32_ieee_combine(crc1, crc2, len2, seed), crc32_ieee(seed, m_buf.data(), len1 + len2))
+            << "len1=" << len1 << " len2=" << len2;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    int parsed_argc = argc;
+    ::testing::InitGoogleTest(&parsed_argc, argv);
+    SISL_OPTIONS_LOAD(parsed_argc, argv, logging, test_crc);
+    sisl::logging::SetLogger("test_crc");
+    spdlog::set_pattern("[%D %T%z] [%^%l%$] [%t] %v");
+
+    return RUN_ALL_TESTS();
+}
@@ -18,6 +18,7 @@
 #include <filesystem>
 #include <random>
 #include <unordered_set>
+#include <cstring>
 #include <farmhash.h>
 
 #include <gtest/gtest.h>
@@ -43,6 +44,7 @@
 #include "test_common/homestore_test_common.hpp"
 
 #include <homestore/blkdata_service.hpp>
+#include <homestore/checkpoint/cp_mgr.hpp>
 
 ////////////////////////////////////////////////////////////////////////////
 //                                                                        //
@@ -870,6 +872,43 @@ TEST_F(BlkDataServiceTest, TestWriteMultiplePagesMultiIovs) {
     LOGINFO("Step 3: I/O completed, do shutdown.");
 }
 
+/**
+ * @brief A multi piece write and read issued from a thread which is not an io reactor should submit each of its
+ * pieces to the drive and complete.
+ */
+TEST_F(BlkDataServiceTest, TestMultiPieceIoFromNonReactor) {
+    ASSERT_FALSE(iomanager.am_i_io_reactor()) << "Expected the test to run outside of an io reactor";
+    auto const blk_size = inst().get_blk_size();
+    auto const nblks = 4u;
+
+    LOGINFO("Step 1: Alloc {} blks and split them into one blk pieces", nblks);
+    MultiBlkId alloc_blkid;
+    ASSERT_EQ(inst().alloc_blks(nblks * blk_size, blk_alloc_hints{}, alloc_blkid), BlkAllocStatus::SUCCESS);
+    MultiBlkId blkid;
+    auto it = alloc_blkid.iterate();
+    while (auto const bid = it.next()) {
+        for (blk_count_t i{0}; i < bid->blk_count(); ++i) {
+            blkid.add(bid->blk_num() + i, 1, bid->chunk_num());
+        }
+    }
+    ASSERT_EQ(blkid.num_pieces(), nblks);
+
+    LOGINFO("Step 2: Write blkid={} from the test thread", blkid.to_string());
+    sisl::sg_list write_sg;
+    write_sg.size = nblks * blk_size;
+    write_sg.iovs.push_back(iovec{iomanager.iobuf_alloc(512, write_sg.size), write_sg.size});
+    test_common::HSTestHelper::fill_data_buf(r_cast< uint8_t* >(write_sg.iovs[0].iov_base), write_sg.size);
+    ASSERT_FALSE(inst().async_write(write_sg, blkid, false /* part_of_batch */).get());
+
+    LOGINFO("Step 3: Read it back from the test thread and verify");
+    auto read_buf = iomanager.iobuf_alloc(512, write_sg.size);
+    ASSERT_FALSE(inst().async_read(blkid, read_buf, write_sg.size, false /* part_of_batch */).get());
+    ASSERT_EQ(std::memcmp(read_buf, write_sg.iovs[0].iov_base, write_sg.size), 0) << "Data mismatch on read";
+
+    iomanager.iobuf_free(read_buf);
+    free(write_sg);
+}
+
 TEST_F(BlkDataServiceTest, TestWriteThenReadVerify) {
     // start io in worker thread;
     auto io_size = 4 * Ki;
@@ -995,6 +1034,38 @@ TEST_F(BlkDataServiceTest, TestRestartWithMissingDrive) {
     LOGINFO("Step 11: I/O completed, do shutdown.");
 }
 
+/**
+ * @brief With lazy bitmap load, allocator of the chunk is loaded on first alloc after restart, which should not hand
+ * out any of the blks committed before restart.
+ */
+TEST_F(BlkDataServiceTest, TestLazyBitmapLoadAfterRestart) {
+    auto const nblks = 100u;
+    LOGINFO("Step 1: Alloc and commit {} blks and take a cp to persist the bitmap", nblks);
+    std::unordered_set< std::string > committed_blks;
+    for (uint32_t i{0}; i < nblks; ++i) {
+        MultiBlkId blkid;
+        ASSERT_EQ(inst().alloc_blks(inst().get_blk_size(), blk_alloc_hints{}, blkid), BlkAllocStatus::SUCCESS);
+        ASSERT_EQ(inst().commit_blk(blkid), BlkAllocStatus::SUCCESS);
+        committed_blks.insert(blkid.to_string());
+    }
+    hs()->cp_mgr().trigger_cp_flush(true /* force */).get();
+
+    LOGINFO("Step 2: Restart homestore with lazy bitmap load");
+    HS_SETTINGS_FACTORY().modifiable_settings([](auto& s) { s.blkallocator.lazy_bitmap_load = true; });
+    HS_SETTINGS_FACTORY().save();
+    m_helper.restart_homestore();
+
+    LOGINFO("Step 3: Alloc {} more blks and verify none of them were committed before restart", nblks);
+    for (uint32_t i{0}; i < nblks; ++i) {
+        MultiBlkId blkid;
+        ASSERT_EQ(inst().alloc_blks(inst().get_blk_size(), blk_alloc_hints{}, blkid), BlkAllocStatus::SUCCESS);
+        ASSERT_EQ(committed_blks.count(blkid.to_string()), 0) << "Allocated blk committed before restart";
+    }
+
+    HS_SETTINGS_FACTORY().modifiable_settings([](auto& s) { s.blkallocator.lazy_bitmap_load = false; });
+    HS_SETTINGS_FACTORY().save();
+}
+
 // Stream related test
 
 SISL_OPTION_GROUP(test_data_service,
@@ -19,6 +19,7 @@
 #include <sisl/utility/enum.hpp>
 #include "common/homestore_config.hpp"
 #include "common/resource_mgr.hpp"
+#include "common/homestore_status_mgr.hpp"
 #include "test_common/homestore_test_common.hpp"
 #include "test_common/range_scheduler.hpp"
 #include "btree_helpers/btree_test_helper.hpp"
@@ -303,6 +304,27 @@ TYPED_TEST(BtreeTest, RangeUpdate) {
     LOGINFO("RangeUpdate test end");
 }
 
+TYPED_TEST(BtreeTest, StatusReport) {
+    const auto num_entries = SISL_OPTIONS["num_entries"].as< uint32_t >();
+    LOGINFO("Step 1: Do forward sequential insert for {} entries", num_entries);
+    for (uint32_t i{0}; i < num_entries; ++i) {
+        this->put(i, btree_put_type::INSERT);
+    }
+
+    LOGINFO("Step 2: Read the index status through the status manager");
+    auto const js = hs()->status_mgr()->get_status({"IndexService"}, 1 /* verbosity */);
+    ASSERT_TRUE(js.contains("IndexService")) << "Index service status is not registered";
+    auto const ordinal = std::to_string(this->m_bt->ordinal());
+    ASSERT_TRUE(js["IndexService"].contains(ordinal)) << "Missing status of index table ordinal=" << ordinal;
+
+    auto const& status = js["IndexService"][ordinal];
+    LOGDEBUG("Index table status: {}", status.dump());
+    ASSERT_EQ(status["ordinal"].template get< uint32_t >(), this->m_bt->ordinal());
+    ASSERT_GT(status["leaf_nodes"].template get< uint64_t >(), 0);
+    ASSERT_TRUE(status.contains("cp_mismatch_retries"));
+    ASSERT_TRUE(status["contended_nodes"].is_array());
+}
+
 TYPED_TEST(BtreeTest, CpFlush) {
     LOGINFO("CpFlush test start");
 
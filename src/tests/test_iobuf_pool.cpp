@@ -0,0 +1,151 @@
+/*********************************************************************************
+ * Modifications Copyright 2017-2019 eBay Inc.
+ *
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *    https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed
+ * under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ *
+ *********************************************************************************/
+#include <algorithm>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include <iomgr/io_environment.hpp>
+#include <sisl/logging/logging.h>
+#include <sisl/options/options.h>
+#include <gtest/gtest.h>
+
+#include <homestore/homestore_decl.hpp>
+#include "common/homestore_config.hpp"
+#include "common/iobuf_pool.hpp"
+
+SISL_LOGGING_INIT(HOMESTORE_LOG_MODS)
+SISL_OPTIONS_ENABLE(logging, test_iobuf_pool)
+
+SISL_OPTION_GROUP(test_iobuf_pool,
+                  (num_threads, "", "num_threads", "number of iomgr threads",
+                   ::cxxopts::value< uint32_t >()->default_value("1"), "number"));
+
+using namespace homestore;
+
+static bool is_aligned(const uint8_t* buf, size_t alignment) {
+    return (reinterpret_cast< uintptr_t >(buf) % alignment) == 0;
+}
+
+// All the pool accounting is process wide, so tests only check the deltas they cause
+TEST(IOBufPoolTest, SizeClassRounding) {
+    auto const base_inuse = IOBufPool::inuse_bytes();
+    auto const check_class = [base_inuse](size_t size, size_t expected_class_size) {
+        auto buf = IOBufPool::alloc(size, 512);
+        ASSERT_NE(buf, nullptr);
+        if (expected_class_size) { ASSERT_TRUE(is_aligned(buf, IOBufPool::pool_alignment)) << "size=" << size; }
+        ASSERT_EQ(IOBufPool::inuse_bytes() - base_inuse, expected_class_size) << "size=" << size;
+        IOBufPool::free(buf, size);
+        ASSERT_EQ(IOBufPool::inuse_bytes(), base_inuse) << "size=" << size;
+    };
+
+    check_class(1, IOBufPool::min_class_size);
+    check_class(IOBufPool::min_class_size, IOBufPool::min_class_size);
+    check_class(IOBufPool::min_class_size + 1, 2 * IOBufPool::min_class_size);
+    check_class(3000, 4096);
+    check_class(4096, 4096);
+    check_class(IOBufPool::max_class_size, IOBufPool::max_class_size);
+
+    // Sizes above the largest class go straight to the heap and are not accounted
+    auto const base_cached = IOBufPool::cached_bytes();
+    check_class(IOBufPool::max_class_size + 1, 0);
+    ASSERT_EQ(IOBufPool::cached_bytes(), base_cached);
+}
+
+TEST(IOBufPoolTest, ReuseAfterFree) {
+    auto buf = IOBufPool::alloc(8192, 512);
+    auto const base_cached = IOBufPool::cached_bytes();
+    IOBufPool::free(buf, 8192);
+    ASSERT_EQ(IOBufPool::cached_bytes() - base_cached, 8192u);
+
+    // A size in the same class is served from the cache of this thread
+    auto buf2 = IOBufPool::alloc(5000, 4096);
+    ASSERT_EQ(buf2, buf);
+    ASSERT_EQ(IOBufPool::cached_bytes(), base_cached);
+    IOBufPool::free(buf2, 5000);
+}
+
+TEST(IOBufPoolTest, AlignmentAbovePoolAlignment) {
+    auto buf = IOBufPool::alloc(4096, 512);
+    IOBufPool::free(buf, 4096);
+    auto const base_cached = IOBufPool::cached_bytes();
+
+    // Cached buffers are only pool_alignment aligned, so a larger alignment has to skip the cache
+    auto const alignment = 2 * IOBufPool::pool_alignment;
+    auto aligned_buf = IOBufPool::alloc(4096, alignment);
+    ASSERT_TRUE(is_aligned(aligned_buf, alignment));
+    ASSERT_EQ(IOBufPool::cached_bytes(), base_cached);
+
+    // and is good to be cached once freed, since it is aligned to pool_alignment as well
+    IOBufPool::free(aligned_buf, 4096);
+    ASSERT_EQ(IOBufPool::cached_bytes() - base_cached, 4096u);
+}
+
+TEST(IOBufPoolTest, PerThreadCacheCap) {
+    auto const csize = IOBufPool::max_class_size;
+    auto const max_cached_bytes =
+        static_cast< uint64_t >(HS_DYNAMIC_CONFIG(resource_limits.iobuf_pool_cache_kb_per_class)) * 1024;
+    auto const max_cached = std::max(uint64_t{1}, max_cached_bytes / csize);
+    auto const base_cached = IOBufPool::cached_bytes();
+
+    // Run on a thread of its own, so that its cache starts empty and is released when it exits
+    std::thread t{[&]() {
+        std::vector< uint8_t* > bufs;
+        for (uint64_t i{0}; i < max_cached + 4; ++i) {
+            bufs.push_back(IOBufPool::alloc(csize, 512));
+        }
+        for (auto buf : bufs) {
+            IOBufPool::free(buf, csize);
+        }
+        EXPECT_EQ(IOBufPool::cached_bytes() - base_cached, max_cached * csize);
+    }};
+    t.join();
+    ASSERT_EQ(IOBufPool::cached_bytes(), base_cached);
+}
+
+TEST(IOBufPoolTest, CrossThreadFree) {
+    auto const size = 2 * IOBufPool::min_class_size;
+    auto const base_inuse = IOBufPool::inuse_bytes();
+
+    uint8_t* buf{nullptr};
+    std::thread t{[&buf, size]() { buf = IOBufPool::alloc(size, 512); }};
+    t.join();
+    ASSERT_EQ(IOBufPool::inuse_bytes() - base_inuse, size);
+
+    // Buffer allocated on the other thread is cached and reused by the thread which freed it
+    IOBufPool::free(buf, size);
+    ASSERT_EQ(IOBufPool::inuse_bytes(), base_inuse);
+    auto buf2 = IOBufPool::alloc(size, 512);
+    ASSERT_EQ(buf2, buf);
+    IOBufPool::free(buf2, size);
+}
+
+int main(int argc, char* argv[]) {
+    int parsed_argc = argc;
+    ::testing::InitGoogleTest(&parsed_argc, argv);
+    SISL_OPTIONS_LOAD(parsed_argc, argv, logging, test_iobuf_pool);
+    sisl::logging::SetLogger("test_iobuf_pool");
+    spdlog::set_pattern("[%D %T%z] [%^%l%$] [%t] %v");
+
+    ioenvironment.with_iomgr(iomgr::iomgr_params{.num_threads = SISL_OPTIONS["num_threads"].as< uint32_t >(),
+                                                 .is_spdk = false,
+                                                 .num_fibers = 1,
+                                                 .app_mem_size_mb = 0,
+                                                 .hugepage_size_mb = 0});
+    auto const ret = RUN_ALL_TESTS();
+    iomanager.stop();
+    return ret;
+}
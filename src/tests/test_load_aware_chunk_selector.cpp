@@ -0,0 +1,262 @@
+/*********************************************************************************
+ * Modifications Copyright 2017-2019 eBay Inc.
+ *
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *    https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed
+ * under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ *
+ *********************************************************************************/
+#include <algorithm>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <folly/futures/Future.h>
+#include <iomgr/io_environment.hpp>
+#include <sisl/logging/logging.h>
+#include <sisl/options/options.h>
+
+#include <homestore/homestore.hpp>
+#include <homestore/blkdata_service.hpp>
+#include <homestore/checkpoint/cp_mgr.hpp>
+#include <homestore/vchunk.h>
+#include "common/homestore_assert.hpp"
+#include "device/chunk.h"
+#include "device/physical_dev.hpp"
+#include "device/load_aware_chunk_selector.h"
+#include "test_common/homestore_test_common.hpp"
+
+using namespace homestore;
+
+SISL_LOGGING_INIT(HOMESTORE_LOG_MODS)
+SISL_OPTIONS_ENABLE(logging, test_load_aware_chunk_selector, iomgr, test_common_setup)
+SISL_LOGGING_DECL(test_load_aware_chunk_selector)
+
+SISL_OPTION_GROUP(test_load_aware_chunk_selector,
+                  (num_data_chunks, "", "num_data_chunks", "number of chunks in data vdev",
+                   ::cxxopts::value< uint32_t >()->default_value("16"), "number"),
+                  (num_reads, "", "num_reads", "number of reads to make a chunk hot",
+                   ::cxxopts::value< uint32_t >()->default_value("2000"), "number"),
+                  (num_selects, "", "num_selects", "number of chunk selections to sample",
+                   ::cxxopts::value< uint32_t >()->default_value("1000"), "number"));
+
+class LoadAwareChunkSelectorTest : public testing::Test {
+public:
+    void SetUp() override {
+        m_selector = std::make_shared< LoadAwareChunkSelector >();
+        m_helper.start_homestore("test_load_aware_chunk_selector",
+                                 {{HS_SERVICE::META, {.size_pct = 5.0}},
+                                  {HS_SERVICE::DATA,
+                                   {.size_pct = 80.0,
+                                    .custom_chunk_selector = m_selector,
+                                    .num_chunks = SISL_OPTIONS["num_data_chunks"].as< uint32_t >()}}});
+        m_selector->foreach_chunks([this](cshared< Chunk >& chunk) { m_chunks.push_back(chunk); });
+    }
+
+    void TearDown() override {
+        m_chunks.clear();
+        m_helper.shutdown_homestore();
+        m_selector.reset();
+    }
+
+    // Chunks on the same device as the given chunk, other than the chunk itself
+    std::vector< shared< Chunk > > peers_of(cshared< Chunk >& chunk) const {
+        std::vector< shared< Chunk > > peers;
+        for (auto const& c : m_chunks) {
+            if ((c != chunk) && (c->physical_dev() == chunk->physical_dev())) { peers.push_back(c); }
+        }
+        return peers;
+    }
+
+    MultiBlkId write_blks(chunk_num_t chunk_id, uint32_t nblks) {
+        auto const size = nblks * data_service().get_blk_size();
+        blk_alloc_hints hints;
+        hints.chunk_id_hint = chunk_id;
+        MultiBlkId blkid;
+        RELEASE_ASSERT(data_service().alloc_blks(size, hints, blkid) == BlkAllocStatus::SUCCESS,
+                       "Failed to alloc blks on chunk={}", chunk_id);
+
+        auto buf = iomanager.iobuf_alloc(512, size);
+        test_common::HSTestHelper::fill_data_buf(buf, size);
+        auto const err = data_service().async_write(r_cast< const char* >(buf), size, blkid).get();
+        RELEASE_ASSERT(!err, "Write error on blkid={}", blkid.to_string());
+        data_service().commit_blk(blkid);
+        iomanager.iobuf_free(buf);
+        return blkid;
+    }
+
+    void read_blks(MultiBlkId const& blkid, uint32_t nreads) {
+        auto const size = blkid.blk_count() * data_service().get_blk_size();
+        auto const qdepth = SISL_OPTIONS["qdepth"].as< uint32_t >();
+        auto buf = iomanager.iobuf_alloc(512, size);
+        std::vector< folly::Future< std::error_code > > futs;
+        for (uint32_t i{0}; i < nreads; i += qdepth) {
+            futs.clear();
+            for (uint32_t d{0}; (d < qdepth) && (i + d < nreads); ++d) {
+                futs.emplace_back(data_service().async_read(blkid, buf, size));
+            }
+            for (auto& t : folly::collectAllUnsafe(futs).get()) {
+                RELEASE_ASSERT(!t.hasException() && !t.value(), "Read error on blkid={}", blkid.to_string());
+            }
+        }
+        iomanager.iobuf_free(buf);
+    }
+
+    void trigger_cp() { hs()->cp_mgr().trigger_cp_flush(true /* force */).get(); }
+
+    shared< Chunk > chunk_of(chunk_num_t chunk_id) const {
+        auto it = std::find_if(m_chunks.begin(), m_chunks.end(),
+                               [chunk_id](auto const& c) { return c->chunk_id() == chunk_id; });
+        return (it == m_chunks.end()) ? nullptr : *it;
+    }
+
+    // (load, wear in permille) of each device, as per the selector status, which is what the selector orders them by
+    std::map< std::string, std::pair< uint64_t, uint64_t > > pdev_order_keys() const {
+        std::map< std::string, std::pair< uint64_t, uint64_t > > keys;
+        for (auto const& [name, pj] : m_selector->get_status(0).items()) {
+            auto const latency_us = std::max(pj["io_latency_ewma_us"].get< uint64_t >(), uint64_t{1});
+            auto const total_blks = pj["total_blks"].get< uint64_t >();
+            keys[name] = {(pj["outstanding_ios"].get< uint64_t >() + 1) * latency_us,
+                          total_blks ? (pj["alloced_blks"].get< uint64_t >() * 1000) / total_blks : 0};
+        }
+        return keys;
+    }
+
+    // Allocates without hints and verifies each allocation lands on one of the least loaded, then least worn devices
+    void alloc_and_verify_order(uint32_t nallocs, uint32_t size) {
+        for (uint32_t i{0}; i < nallocs; ++i) {
+            auto const keys = pdev_order_keys();
+            auto const best = std::min_element(keys.begin(), keys.end(),
+                                               [](auto const& a, auto const& b) { return a.second < b.second; });
+
+            MultiBlkId blkid;
+            ASSERT_TRUE(data_service().alloc_blks(size, blk_alloc_hints{}, blkid) == BlkAllocStatus::SUCCESS);
+            auto const chunk = chunk_of(blkid.chunk_num());
+            ASSERT_NE(chunk, nullptr);
+            auto const& name = chunk->physical_dev()->get_devname();
+            ASSERT_EQ(keys.at(name), best->second)
+                << "Allocated on device=" << name << " (load=" << keys.at(name).first
+                << " wear=" << keys.at(name).second << ") over device=" << best->first
+                << " (load=" << best->second.first << " wear=" << best->second.second << ")";
+        }
+    }
+
+protected:
+    test_common::HSTestHelper m_helper;
+    shared< LoadAwareChunkSelector > m_selector;
+    std::vector< shared< Chunk > > m_chunks;
+};
+
+TEST_F(LoadAwareChunkSelectorTest, AvoidsHotChunk) {
+    ASSERT_FALSE(m_chunks.empty());
+    auto const hot = m_chunks.front();
+    auto const peers = peers_of(hot);
+    ASSERT_FALSE(peers.empty()) << "Need at least two chunks on a device to choose between";
+
+    blk_alloc_hints pdev_hints;
+    pdev_hints.pdev_id_hint = hot->physical_dev()->pdev_id();
+    // First selection syncs the free blks of the chunks with their allocators
+    m_selector->select_chunk(1, pdev_hints);
+
+    LOGINFO("Step 1: Write 1 blk to hot chunk={} and 2 blks to each of its {} peers, so it has most free blks",
+            hot->chunk_id(), peers.size());
+    auto const hot_blkid = write_blks(hot->chunk_id(), 1);
+    for (auto const& peer : peers) {
+        write_blks(peer->chunk_id(), 2);
+    }
+
+    auto const nreads = SISL_OPTIONS["num_reads"].as< uint32_t >();
+    LOGINFO("Step 2: Read the hot chunk {} times between two cp flushes, which refresh the heat", nreads);
+    trigger_cp();
+    read_blks(hot_blkid, nreads);
+    trigger_cp();
+
+    auto const stats = VChunk{hot}.get_io_stats();
+    LOGINFO("Hot chunk io stats: reads={} writes={} heat_iops={}", stats.reads, stats.writes, stats.heat_iops);
+    ASSERT_GE(stats.reads, nreads);
+    ASSERT_GE(stats.writes, 1u);
+    ASSERT_GE(stats.heat_iops, LoadAwareChunkSelector::hot_chunk_min_iops) << "Hot chunk is not seen hot";
+    for (auto const& peer : peers) {
+        auto const peer_stats = VChunk{peer}.get_io_stats();
+        ASSERT_EQ(peer_stats.reads, 0u);
+        ASSERT_GT(stats.heat_iops, 2 * peer_stats.heat_iops) << "Peer chunk=" << peer->chunk_id() << " is as hot";
+    }
+
+    // The hot chunk, having most free blks, would win every pair it is drawn in (about 2/n of the selections, for n
+    // chunks on the device) if it weren't for its heat. Passed over, it is only picked when drawn twice (1/n^2).
+    auto const nselects = SISL_OPTIONS["num_selects"].as< uint32_t >();
+    LOGINFO("Step 3: Select chunks on the hot chunk's device {} times", nselects);
+    uint32_t nhot{0};
+    for (uint32_t i{0}; i < nselects; ++i) {
+        auto const chunk = m_selector->select_chunk(1, pdev_hints);
+        ASSERT_NE(chunk, nullptr);
+        if (chunk == hot) { ++nhot; }
+    }
+    LOGINFO("Hot chunk selected {} out of {} times among {} chunks", nhot, nselects, peers.size() + 1);
+    ASSERT_LT(nhot * (peers.size() + 1), nselects) << "Hot chunk is selected more than its fair share";
+}
+
+TEST_F(LoadAwareChunkSelectorTest, LoadAndWearOrdering) {
+    ASSERT_GE(pdev_order_keys().size(), 2u) << "Need at least two devices to order";
+    auto const size = 1024 * 1024;
+
+    LOGINFO("Step 1: Allocate without any io, devices are equally loaded and are picked by the least wear");
+    ASSERT_NO_FATAL_FAILURE(alloc_and_verify_order(60, size));
+
+    auto const chunk = m_chunks.front();
+    LOGINFO("Step 2: Do io on device={} so that its latency average, and so its load, moves",
+            chunk->physical_dev()->get_devname());
+    read_blks(write_blks(chunk->chunk_id(), 1), 64);
+
+    LOGINFO("Step 3: Allocate again, devices are picked by the least load and then the least wear");
+    ASSERT_NO_FATAL_FAILURE(alloc_and_verify_order(60, size));
+    for (auto const& [name, key] : pdev_order_keys()) {
+        LOGINFO("Device={} load={} wear_permille={}", name, key.first, key.second);
+    }
+}
+
+TEST_F(LoadAwareChunkSelectorTest, DeferredFreeIsTracked) {
+    auto const chunk = m_chunks.front();
+    auto const& devname = chunk->physical_dev()->get_devname();
+    auto const free_blks = [this, &chunk, &devname]() {
+        return m_selector->get_status(1)[devname]["chunk_free_blks"][std::to_string(chunk->chunk_id())]
+            .get< int64_t >();
+    };
+
+    blk_alloc_hints pdev_hints;
+    pdev_hints.pdev_id_hint = chunk->physical_dev()->pdev_id();
+    // First selection syncs the free blks of the chunks with their allocators
+    m_selector->select_chunk(1, pdev_hints);
+    auto const nfree = free_blks();
+
+    LOGINFO("Step 1: Write 4 blks on chunk={} with {} free blks", chunk->chunk_id(), nfree);
+    auto const blkid = write_blks(chunk->chunk_id(), 4);
+    ASSERT_EQ(free_blks(), nfree - 4);
+
+    LOGINFO("Step 2: Free them, which is deferred to the next cp flush");
+    ASSERT_FALSE(data_service().async_free_blk(blkid).get());
+    ASSERT_EQ(free_blks(), nfree - 4) << "Blks are reported free before the cp flush";
+
+    LOGINFO("Step 3: Flush the cp and verify the selector is told about the freed blks");
+    trigger_cp();
+    ASSERT_EQ(free_blks(), nfree) << "Blks freed at cp flush are not reported to the selector";
+}
+
+int main(int argc, char* argv[]) {
+    int parsed_argc = argc;
+    ::testing::InitGoogleTest(&parsed_argc, argv);
+    SISL_OPTIONS_LOAD(parsed_argc, argv, logging, test_load_aware_chunk_selector, iomgr, test_common_setup);
+    sisl::logging::SetLogger("test_load_aware_chunk_selector");
+    spdlog::set_pattern("[%D %T%z] [%^%l%$] [%t] %v");
+
+    return RUN_ALL_TESTS();
+}
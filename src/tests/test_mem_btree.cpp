@@ -12,9 +12,13 @@
  * specific language governing permissions and limitations under the License.
  *
  *********************************************************************************/
+#include <algorithm>
+#include <fstream>
 #include <random>
 #include <map>
 #include <memory>
+#include <numeric>
+#include <unistd.h>
 #include <gtest/gtest.h>
 #include <iomgr/io_environment.hpp>
 #include <sisl/options/options.h>
@@ -28,6 +32,7 @@
 #include <homestore/btree/detail/simple_node.hpp>
 #include <homestore/btree/detail/varlen_node.hpp>
 #include <homestore/btree/detail/prefix_node.hpp>
+#include <homestore/btree/detail/compact_node.hpp>
 #include "btree_helpers/btree_test_helper.hpp"
 
 using namespace homestore;
@@ -54,7 +59,9 @@ SISL_OPTION_GROUP(
      ""),
     (seed, "", "seed", "random engine seed, use random if not defined",
      ::cxxopts::value< uint64_t >()->default_value("0"), "number"),
-    (run_time, "", "run_time", "run time for io", ::cxxopts::value< uint32_t >()->default_value("360000"), "seconds"))
+    (run_time, "", "run_time", "run time for io", ::cxxopts::value< uint32_t >()->default_value("360000"), "seconds"),
+    (churn_rounds, "", "churn_rounds", "number of insert all/remove all rounds of NodeMemChurn",
+     ::cxxopts::value< uint32_t >()->default_value("5"), "number"))
 
 struct FixedLenBtreeTest {
     using BtreeType = MemBtree< TestFixedKey, TestFixedValue >;
@@ -96,6 +103,14 @@ struct PrefixIntervalBtreeTest {
     static constexpr btree_node_type interior_node_type = btree_node_type::FIXED;
 };
 
+struct CompactBtreeTest {
+    using BtreeType = MemBtree< TestFixedKey, TestFixedValue >;
+    using KeyType = TestFixedKey;
+    using ValueType = TestFixedValue;
+    static constexpr btree_node_type leaf_node_type = btree_node_type::COMPACT;
+    static constexpr btree_node_type interior_node_type = btree_node_type::COMPACT;
+};
+
 template < typename TestType >
 struct BtreeTest : public BtreeTestHelper< TestType >, public ::testing::Test {
     using T = TestType;
@@ -116,7 +131,7 @@ struct BtreeTest : public BtreeTestHelper< TestType >, public ::testing::Test {
 };
 
 using BtreeTypes = testing::Types< FixedLenBtreeTest, PrefixIntervalBtreeTest, VarKeySizeBtreeTest,
-                                   VarValueSizeBtreeTest, VarObjSizeBtreeTest >;
+                                   VarValueSizeBtreeTest, VarObjSizeBtreeTest, CompactBtreeTest >;
 TYPED_TEST_SUITE(BtreeTest, BtreeTypes);
 
 TYPED_TEST(BtreeTest, SequentialInsert) {
@@ -421,6 +436,153 @@ TYPED_TEST(BtreeTest, SimpleGC) {
     LOGDEBUG("GC {} keys:\n{}", out.size(), format_tombstoned(out));
 }
 
+TYPED_TEST(BtreeTest, FillFactorMetrics) {
+    const auto num_entries = SISL_OPTIONS["num_entries"].as< uint32_t >();
+    for (uint32_t i{0}; i < num_entries; ++i) {
+        this->put(i, btree_put_type::INSERT);
+    }
+    // Leave the leaves sparse
+    for (uint32_t i{0}; i < num_entries; i += 2) {
+        this->remove_one(i);
+    }
+
+    auto const fill = this->m_bt->get_fill_stats_json();
+    LOGDEBUG("Fill factor: {}", fill.dump());
+    uint64_t nleaf{0}, ninterior{0};
+    for (auto const& [bucket, count] : fill["leaf"].items()) {
+        nleaf += count.template get< uint64_t >();
+    }
+    for (auto const& [bucket, count] : fill["interior"].items()) {
+        ninterior += count.template get< uint64_t >();
+    }
+    auto const [exp_interior, exp_leaf] = this->m_bt->compute_node_count();
+    ASSERT_EQ(nleaf, exp_leaf) << "Fill factor histogram doesn't cover all the leaf nodes";
+    ASSERT_EQ(ninterior, exp_interior) << "Fill factor histogram doesn't cover all the interior nodes";
+}
+
+TYPED_TEST(BtreeTest, PrefixNodeCompaction) {
+    if constexpr (TypeParam::leaf_node_type != btree_node_type::PREFIX) {
+        GTEST_SKIP() << "Only prefix leaf nodes leave holes on remove to be compacted";
+    } else {
+        // Merge would fold the sparse leaves, instead they are expected to take the inserts by compacting themselves
+        this->m_cfg.m_merge_turned_on = false;
+        this->m_bt = std::make_shared< typename TypeParam::BtreeType >(this->m_cfg);
+
+        const auto num_entries = SISL_OPTIONS["num_entries"].as< uint32_t >();
+        for (uint32_t i{0}; i < num_entries; ++i) {
+            this->put(i, btree_put_type::INSERT);
+        }
+        auto const [interior_before, leaf_before] = this->m_bt->compute_node_count();
+
+        // Every single key insert adds its own prefix, so removing 2 of every 3 keys leaves the leaves full of holes
+        for (uint32_t i{0}; i < num_entries; ++i) {
+            if (i % 3 != 0) { this->remove_one(i); }
+        }
+        auto const compactions = this->m_bt->get_metrics_in_json()["Counters"].value(
+            BtreeMetrics::desc::node_compactions, uint64_t{0});
+        ASSERT_GT(compactions, 0) << "Leaves with removed prefixes were not compacted when written";
+
+        for (uint32_t i{0}; i < num_entries; ++i) {
+            if (i % 3 != 0) { this->put(i, btree_put_type::INSERT); }
+        }
+        auto const [interior_after, leaf_after] = this->m_bt->compute_node_count();
+        ASSERT_EQ(leaf_after, leaf_before) << "Leaves split on inserts into the space their removes freed";
+        this->get_all();
+    }
+}
+
+TYPED_TEST(BtreeTest, StatusInstrumentation) {
+    this->m_cfg.m_fill_sample_every = 1;
+    this->m_bt = std::make_shared< typename TypeParam::BtreeType >(this->m_cfg);
+
+    const auto num_entries = SISL_OPTIONS["num_entries"].as< uint32_t >();
+    for (uint32_t i{0}; i < num_entries; ++i) {
+        this->put(i, btree_put_type::INSERT);
+    }
+
+    auto const status = this->m_bt->get_status(1);
+    LOGDEBUG("Btree status: {}", status.dump());
+    auto const& by_level = status["sampled_fill_by_level"];
+    ASSERT_TRUE(by_level.contains("level_0")) << "Leaf node writes are not sampled";
+    if (status["depth"].template get< uint32_t >() > 0) {
+        ASSERT_TRUE(by_level.contains("level_1")) << "Interior node writes are not sampled";
+    }
+    ASSERT_EQ(status["cp_mismatch_retries"].template get< uint64_t >(), 0) << "MemBtree can't have cp mismatch";
+    ASSERT_FALSE(status.contains("cache_hits")) << "MemBtree has no node cache to report";
+    ASSERT_TRUE(status["contended_nodes"].is_array());
+}
+
+static uint64_t rss_bytes() {
+    uint64_t pages{0}, rss_pages{0};
+    std::ifstream statm{"/proc/self/statm"};
+    statm >> pages >> rss_pages;
+    return rss_pages * sysconf(_SC_PAGESIZE);
+}
+
+TYPED_TEST(BtreeTest, NodeMemChurn) {
+    // Inserts all the keys and removes them all in random order in each round, reporting the put throughput and the
+    // memory held by node buffers. Freed nodes should be reused by the next round and once all keys are removed, the
+    // node memory held should come back within the configured free memory bound.
+    static constexpr uint64_t max_free_bytes{1024 * 1024};
+    this->m_cfg.m_mem_max_free_node_bytes = max_free_bytes;
+    this->m_bt = std::make_shared< typename TypeParam::BtreeType >(this->m_cfg);
+
+    const auto num_entries = SISL_OPTIONS["num_entries"].as< uint32_t >();
+    std::vector< uint32_t > keys(num_entries);
+    std::iota(keys.begin(), keys.end(), 0u);
+
+    for (uint32_t round{0}; round < SISL_OPTIONS["churn_rounds"].as< uint32_t >(); ++round) {
+        std::shuffle(keys.begin(), keys.end(), g_re);
+        auto const start = Clock::now();
+        for (auto const k : keys) {
+            this->put(k, btree_put_type::INSERT);
+        }
+        auto const put_us = std::max(get_elapsed_time_us(start), uint64_t{1});
+        auto const full_node_mem = this->m_bt->node_mem_bytes();
+
+        std::shuffle(keys.begin(), keys.end(), g_re);
+        for (auto const k : keys) {
+            this->remove_one(k);
+        }
+        LOGINFO("Round {}: puts/sec={} node_mem={} KB after inserts, {} KB (inuse={} KB) after removes, rss={} MB",
+                round, (num_entries * 1000000ul) / put_us, full_node_mem / 1024, this->m_bt->node_mem_bytes() / 1024,
+                this->m_bt->node_inuse_bytes() / 1024, rss_bytes() / (1024 * 1024));
+
+        // Each shard could hold a partially used slab in addition to the bound
+        ASSERT_LE(this->m_bt->node_mem_bytes(),
+                  max_free_bytes + (MemNodeArena::max_shards + 1) * uint64_t{MemNodeArena::slab_size})
+            << "Freed node memory is not released back";
+    }
+}
+
+TYPED_TEST(BtreeTest, OptimisticReadNodeReclaim) {
+    // Nodes freed with optimistic reads on are retained only till the readers which could be on them are gone, so
+    // after all the keys are removed, the node memory in use should come back to a few nodes in each round.
+    this->m_cfg.m_optimistic_read = true;
+    this->m_bt = std::make_shared< typename TypeParam::BtreeType >(this->m_cfg);
+
+    const auto num_entries = SISL_OPTIONS["num_entries"].as< uint32_t >();
+    std::vector< uint32_t > keys(num_entries);
+    std::iota(keys.begin(), keys.end(), 0u);
+
+    for (uint32_t round{0}; round < 3; ++round) {
+        std::shuffle(keys.begin(), keys.end(), g_re);
+        for (auto const k : keys) {
+            this->put(k, btree_put_type::INSERT);
+            this->get_specific(k);
+        }
+        std::shuffle(keys.begin(), keys.end(), g_re);
+        for (auto const k : keys) {
+            this->remove_one(k);
+        }
+        ASSERT_LE(this->m_bt->node_inuse_bytes(), 64 * uint64_t{this->m_cfg.node_size()})
+            << "Nodes freed under optimistic reads are not reclaimed";
+    }
+
+    auto const status = this->m_bt->get_status(0);
+    ASSERT_GT(status["optimistic_read_hits"].template get< uint64_t >(), 0) << "Optimistic read path was not taken";
+}
+
 template < typename TestType >
 struct BtreeConcurrentTest : public BtreeTestHelper< TestType >, public ::testing::Test {
     using T = TestType;
@@ -465,6 +627,27 @@ TYPED_TEST(BtreeConcurrentTest, ConcurrentAllOps) {
     this->multi_op_execute(ops);
 }
 
+TYPED_TEST(BtreeConcurrentTest, ConcurrentOptimisticGet) {
+    this->m_cfg.m_optimistic_read = true;
+    this->m_bt = std::make_shared< typename TypeParam::BtreeType >(this->m_cfg);
+
+    // Gets race with splits and merges caused by puts and removes and should either validate or fallback
+    std::vector< std::string > input_ops = {"put:30", "remove:20", "get:50"};
+    auto ops = this->build_op_list(input_ops);
+
+    this->multi_op_execute(ops);
+
+    auto const status = this->m_bt->get_status(0);
+    LOGINFO("Optimistic reads: hits={} retries={} fallbacks={}", status["optimistic_read_hits"].dump(),
+            status["optimistic_read_retries"].dump(), status["optimistic_read_fallbacks"].dump());
+    auto const hits = status["optimistic_read_hits"].template get< uint64_t >();
+    auto const retries = status["optimistic_read_retries"].template get< uint64_t >();
+    auto const fallbacks = status["optimistic_read_fallbacks"].template get< uint64_t >();
+    ASSERT_GT(hits, 0) << "Optimistic read path was not taken";
+    ASSERT_GE(retries, fallbacks * this->m_cfg.m_max_optimistic_read_attempts)
+        << "Every fallback should follow the configured number of failed attempts";
+}
+
 int main(int argc, char* argv[]) {
     ::testing::InitGoogleTest(&argc, argv);
     SISL_OPTIONS_LOAD(argc, argv, logging, test_mem_btree)
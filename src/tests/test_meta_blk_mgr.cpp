@@ -409,6 +409,71 @@ public:
         }
     }
 
+    // Update every sb written so far nupdates times through async api, where all the updates of a round are submitted
+    // as one batch and a few rounds are submitted before waiting, so that updates of the same sb get coalesced.
+    void do_async_sb_updates(uint32_t nupdates) {
+        std::vector< folly::Future< bool > > futs;
+        std::vector< uint8_t* > bufs;
+        {
+            std::unique_lock< std::mutex > lg{m_mtx};
+            for (uint32_t i{0}; i < nupdates; ++i) {
+                std::vector< sub_sb_update_t > updates;
+                for (auto& [bid, sb] : m_write_sbs) {
+                    const auto sz_to_wrt = rand_size(do_overflow());
+                    uint8_t* buf = iomanager.iobuf_alloc(512, sz_to_wrt);
+                    gen_rand_buf(buf, sz_to_wrt);
+                    bufs.push_back(buf);
+                    updates.push_back(sub_sb_update_t{buf, sz_to_wrt, sb.cookie});
+
+                    // only the content of last update is expected to be found after recovery
+                    sb.str = md5_sum(r_cast< const char* >(buf), sz_to_wrt);
+                    ++m_update_cnt;
+                }
+                futs.emplace_back(m_mbm->async_update_sub_sbs(updates));
+            }
+        }
+
+        // buffers are copied by async update, so it is fine to free them before it completes
+        for (auto* buf : bufs) {
+            iomanager.iobuf_free(buf);
+        }
+
+        for (auto& res : folly::collectAllUnsafe(futs).get()) {
+            EXPECT_TRUE(res.hasValue() && res.value());
+        }
+
+        std::unique_lock< std::mutex > lg{m_mtx};
+        m_total_wrt_sz = m_mbm->used_size();
+        HS_REL_ASSERT_EQ(m_mbm->total_size() - m_total_wrt_sz, m_mbm->available_blks() * m_mbm->block_size());
+    }
+
+    // Queues an async update of every sb and right away updates the same sb synchronously, racing with the async pass
+    // which picks up the queued update. The sync update is issued last, so its content is the one to be recovered.
+    void do_racing_sb_updates() {
+        std::vector< folly::Future< bool > > futs;
+        std::unique_lock< std::mutex > lg{m_mtx};
+        for (auto& [bid, sb] : m_write_sbs) {
+            const auto async_sz = rand_size(do_overflow());
+            uint8_t* async_buf = iomanager.iobuf_alloc(512, async_sz);
+            gen_rand_buf(async_buf, async_sz);
+            futs.emplace_back(m_mbm->async_update_sub_sb(async_buf, async_sz, sb.cookie));
+            iomanager.iobuf_free(async_buf);
+
+            const auto sz_to_wrt = rand_size(do_overflow());
+            uint8_t* buf = iomanager.iobuf_alloc(512, sz_to_wrt);
+            gen_rand_buf(buf, sz_to_wrt);
+            m_mbm->update_sub_sb(buf, sz_to_wrt, sb.cookie);
+            sb.str = md5_sum(r_cast< const char* >(buf), sz_to_wrt);
+            iomanager.iobuf_free(buf);
+            m_update_cnt += 2;
+        }
+
+        for (auto& res : folly::collectAllUnsafe(futs).get()) {
+            EXPECT_TRUE(res.hasValue() && res.value());
+        }
+        m_total_wrt_sz = m_mbm->used_size();
+    }
+
     // compare m_cb_blks with m_write_sbs;
     void verify_cb_blks() {
         std::unique_lock< std::mutex > lg{m_mtx};
@@ -856,6 +921,98 @@ TEST_F(VMetaBlkMgrTest, recovery_test) {
     this->shutdown();
 }
 
+// Measure the startup scan time with the meta blks read one by one while walking the chain vs prefetched in parallel
+// using meta blk directory, and verify that both recover the same content.
+TEST_F(VMetaBlkMgrTest, startup_scan_test) {
+    mtype = "Test_MetaService_startup_scan";
+    reset_counters();
+    m_start_time = Clock::now();
+    this->register_client();
+
+    static constexpr uint64_t num_sbs{2000};
+    for (uint64_t i{0}; i < num_sbs; ++i) {
+        const bool overflow = ((i % 4) == 0);
+        EXPECT_GT(this->do_sb_write(overflow, overflow ? uint64_cast(16 * Ki) : uint64_cast(512)), uint64_cast(0));
+    }
+
+    const auto restart_and_time = [this](uint32_t parallel_reads) {
+        HS_SETTINGS_FACTORY().modifiable_settings([parallel_reads](auto& s) {
+            s.metablk.scan_parallel_reads = parallel_reads;
+            HS_SETTINGS_FACTORY().save();
+        });
+        const auto start_time = Clock::now();
+        this->recover_with_on_complete();
+        const auto elapsed_ms = get_elapsed_time_ms(start_time);
+        this->validate();
+        return elapsed_ms;
+    };
+
+    // First restart writes the directory for the chain, so measure only the restarts after that
+    restart_and_time(0);
+    const auto seq_ms = restart_and_time(0);
+    const auto parallel_ms = restart_and_time(64);
+    LOGINFO("Restart with {} meta blks took {} ms with sequential scan and {} ms with parallel scan", num_sbs, seq_ms,
+            parallel_ms);
+
+    // Meta blks added after the directory was written are still found by walking the chain
+    for (uint64_t i{0}; i < 16; ++i) {
+        EXPECT_GT(this->do_sb_write(true, uint64_cast(16 * Ki)), uint64_cast(0));
+    }
+    restart_and_time(64);
+
+    this->shutdown();
+}
+
+// Updates sbs through async api, interleaved with sync update, add and remove, then verifies that the latest
+// content of each sb is recovered
+TEST_F(VMetaBlkMgrTest, async_update_test) {
+    mtype = "Test_MetaService_async_update";
+    reset_counters();
+    m_start_time = Clock::now();
+    this->register_client();
+
+    for (uint64_t i{0}; i < 64; ++i) {
+        EXPECT_GT(this->do_sb_write(do_overflow()), uint64_cast(0));
+    }
+
+    for (uint32_t round{0}; round < 4; ++round) {
+        this->do_async_sb_updates(4 /* nupdates */);
+        this->do_sb_update(true /* aligned */);
+        EXPECT_GT(this->do_sb_write(do_overflow()), uint64_cast(0));
+        this->do_sb_remove();
+    }
+
+    this->recover_with_on_complete();
+    this->validate();
+
+    this->do_async_sb_updates(1 /* nupdates */);
+    this->recover_with_on_complete();
+    this->validate();
+
+    this->shutdown();
+}
+
+// Sync updates of sbs which have an async update queued must not be overwritten by the older queued content
+TEST_F(VMetaBlkMgrTest, async_update_race_test) {
+    mtype = "Test_MetaService_async_update_race";
+    reset_counters();
+    m_start_time = Clock::now();
+    this->register_client();
+
+    for (uint64_t i{0}; i < 64; ++i) {
+        EXPECT_GT(this->do_sb_write(do_overflow()), uint64_cast(0));
+    }
+
+    for (uint32_t round{0}; round < 8; ++round) {
+        this->do_racing_sb_updates();
+    }
+
+    this->recover_with_on_complete();
+    this->validate();
+
+    this->shutdown();
+}
+
 // 1. randome write, update, remove;
 // 2. recovery test and verify callback context data matches;
 TEST_F(VMetaBlkMgrTest, random_load_test) {
@@ -961,7 +1118,8 @@ SISL_OPTION_GROUP(
     (bitmap, "", "bitmap", "bitmap test", ::cxxopts::value< bool >()->default_value("false"), "true or false"));
 
 int main(int argc, char* argv[]) {
-    ::testing::GTEST_FLAG(filter) = "*random*:VMetaBlkMgrTest.recovery_test";
+    ::testing::GTEST_FLAG(filter) = "*random*:VMetaBlkMgrTest.recovery_test:VMetaBlkMgrTest.startup_scan_test:"
+                                    "VMetaBlkMgrTest.async_update_test:VMetaBlkMgrTest.async_update_race_test";
     ::testing::InitGoogleTest(&argc, argv);
     SISL_OPTIONS_LOAD(argc, argv, logging, test_meta_blk_mgr, iomgr, test_common_setup);
     sisl::logging::SetLogger("test_meta_blk_mgr");
@@ -12,6 +12,8 @@
  * specific language governing permissions and limitations under the License.
  *
  *********************************************************************************/
+#include <homestore/io_trace.hpp>
+#include "common/homestore_status_mgr.hpp"
 #include "test_common/raft_repl_test_base.hpp"
 
 class RaftReplDevTest : public RaftReplDevTestBase {};
@@ -91,6 +93,105 @@ TEST_F(RaftReplDevTest, Write_Restart_Write) {
     g_helper->sync_for_cleanup_start();
 }
 
+TEST_F(RaftReplDevTest, Restart_Reports_Startup_Status) {
+    LOGINFO("Homestore replica={} setup completed", g_helper->replica_num());
+    g_helper->sync_for_test_start();
+
+    this->write_on_leader(SISL_OPTIONS["num_io"].as< uint64_t >(), true /* wait_for_commit */);
+    g_helper->sync_for_verify_start();
+    g_helper->sync_for_cleanup_start();
+
+    LOGINFO("Restart all the homestore replicas");
+    g_helper->restart();
+    g_helper->sync_for_test_start();
+
+    LOGINFO("Read the startup breakdown through the status manager");
+    auto const js = hs()->status_mgr()->get_status({"ReplicationService"}, 1 /* verbosity */);
+    ASSERT_TRUE(js.contains("ReplicationService")) << "Replication service status is not registered";
+    auto const& startup = js["ReplicationService"]["startup"];
+    for (auto const key : {"load_repl_devs_ms", "logstore_start_ms", "join_groups_ms", "total_ms"}) {
+        ASSERT_TRUE(startup.contains(key)) << "Missing startup key " << key;
+    }
+    ASSERT_GE(startup["total_ms"].get< uint64_t >(), startup["join_groups_ms"].get< uint64_t >());
+
+    auto const group = boost::uuids::to_string(dbs_[0]->repl_dev()->group_id());
+    ASSERT_TRUE(startup["groups"].contains(group)) << "Missing startup info of group " << group;
+    ASSERT_TRUE(startup["groups"][group]["joined"].get< bool >());
+
+    g_helper->sync_for_cleanup_start();
+}
+
+TEST_F(RaftReplDevTest, Write_With_Coalesced_Push_Data) {
+    LOGINFO("Homestore replica={} setup completed", g_helper->replica_num());
+    g_helper->sync_for_test_start();
+
+    // Hold the push long enough that concurrent writes get coalesced, with a small size limit so that some batches
+    // are sent on reaching the size and the rest on the timer
+    uint32_t prev_delay_us{0};
+    uint32_t prev_max_kb{0};
+    HS_SETTINGS_FACTORY().modifiable_settings([&prev_delay_us, &prev_max_kb](auto& s) {
+        prev_delay_us = s.consensus.push_data_batch_max_delay_us;
+        prev_max_kb = s.consensus.push_data_batch_max_size_kb;
+        s.consensus.push_data_batch_max_delay_us = 2000;
+        s.consensus.push_data_batch_max_size_kb = 64;
+    });
+    HS_SETTINGS_FACTORY().save();
+
+    this->write_on_leader(SISL_OPTIONS["num_io"].as< uint64_t >(), true /* wait_for_commit */);
+
+    if (dbs_[0]->repl_dev()->get_leader_id() == g_helper->my_replica_id()) {
+        auto rdev = std::dynamic_pointer_cast< RaftReplDev >(dbs_[0]->repl_dev());
+        auto const counters = rdev->metrics().get_result_in_json(true /* skip_hist */).at("Counters");
+        auto const coalesced =
+            counters.at("Total write requests pushed in a coalesced push data rpc").get< uint64_t >();
+        LOGINFO("Writes pushed in coalesced push data rpcs={}", coalesced);
+        EXPECT_GT(coalesced, 0) << "Expected some of the concurrent writes to be coalesced";
+    }
+
+    g_helper->sync_for_verify_start();
+    LOGINFO("Validate all data written so far by reading them");
+    this->validate_data();
+
+    HS_SETTINGS_FACTORY().modifiable_settings([prev_delay_us, prev_max_kb](auto& s) {
+        s.consensus.push_data_batch_max_delay_us = prev_delay_us;
+        s.consensus.push_data_batch_max_size_kb = prev_max_kb;
+    });
+    HS_SETTINGS_FACTORY().save();
+    g_helper->sync_for_cleanup_start();
+}
+
+TEST_F(RaftReplDevTest, Write_With_IO_Trace) {
+    LOGINFO("Homestore replica={} setup completed", g_helper->replica_num());
+    g_helper->sync_for_test_start();
+
+    uint32_t prev_sample_every{0};
+    HS_SETTINGS_FACTORY().modifiable_settings([&prev_sample_every](auto& s) {
+        prev_sample_every = s.generic.io_trace_sample_every;
+        s.generic.io_trace_sample_every = 1;
+    });
+    HS_SETTINGS_FACTORY().save();
+
+    this->write_on_leader(SISL_OPTIONS["num_io"].as< uint64_t >(), true /* wait_for_commit */);
+
+    g_helper->sync_for_verify_start();
+    LOGINFO("Validate all data written so far by reading them");
+    this->validate_data();
+
+    // Every replica writes the data, appends and flushes the journal and commits each of the traced writes
+    auto const breakdown = IOTrace::breakdown(IOTrace::dump(), 1 /* log_level */);
+    LOGINFO("IO trace breakdown: {}", breakdown.dump());
+    ASSERT_GT(breakdown["traces"].get< uint64_t >(), 0) << "No write was traced";
+    for (auto const stage : {io_trace_stage_t::drive_write_done, io_trace_stage_t::data_write_done,
+                             io_trace_stage_t::journal_flushed, io_trace_stage_t::commit}) {
+        ASSERT_TRUE(breakdown["stages"].contains(enum_name(stage))) << "No event for stage " << enum_name(stage);
+    }
+
+    HS_SETTINGS_FACTORY().modifiable_settings(
+        [prev_sample_every](auto& s) { s.generic.io_trace_sample_every = prev_sample_every; });
+    HS_SETTINGS_FACTORY().save();
+    g_helper->sync_for_cleanup_start();
+}
+
 #ifdef _PRERELEASE
 TEST_F(RaftReplDevTest, Follower_Fetch_OnActive_ReplicaGroup) {
     LOGINFO("Homestore replica={} setup completed", g_helper->replica_num());
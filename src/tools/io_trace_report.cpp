@@ -0,0 +1,46 @@
+/*********************************************************************************
+ * Modifications Copyright 2017-2019 eBay Inc.
+ *
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *    https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed
+ * under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ *
+ *********************************************************************************/
+#include <cstring>
+#include <iostream>
+
+#include <homestore/io_trace.hpp>
+
+// Prints the per stage latency breakdown of the io traces in a file written by IOTrace::dump_to_file. The timestamps
+// are of the steady clock of the process which dumped them, so dumps of different replicas have to be reported
+// separately.
+int main(int argc, char* argv[]) {
+    int log_level{0};
+    const char* path{nullptr};
+    for (int i{1}; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--slowest") == 0) {
+            log_level = 1;
+        } else {
+            path = argv[i];
+        }
+    }
+    if (path == nullptr) {
+        std::cerr << "Usage: " << argv[0] << " [--slowest] <io trace dump file>\n";
+        return 1;
+    }
+
+    auto const events = homestore::IOTrace::load_from_file(path);
+    if (events.empty()) {
+        std::cerr << "No io trace events found in " << path << "\n";
+        return 1;
+    }
+    std::cout << homestore::IOTrace::breakdown(events, log_level).dump(2) << std::endl;
+    return 0;
+}